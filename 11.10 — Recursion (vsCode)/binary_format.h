@@ -0,0 +1,216 @@
+#ifndef BINARY_FORMAT_H
+#define BINARY_FORMAT_H
+
+#include <cstddef> // for std::size_t
+#include <cstdint> // for std::uint64_t
+#include <cstring> // for std::memcpy
+#include <string>
+#include <type_traits> // for std::is_integral, std::make_unsigned
+
+/*
+Printing integers in binary (and octal and hex) without recursion.
+
+question_three() recurses once per bit and sends every bit to std::cout on its own. formatDigits() writes the digits of
+a number into a char buffer instead, from lookup tables that are built at compile time:
+  - binary: the 8 digits of every possible byte, so a byte is one 8 character copy (a 64 bit number is 8 copies),
+  - hex: the 2 digits of every possible byte,
+  - octal: the 2 digits of every 6 bits.
+appendDigits() does a whole array of numbers into one std::string, with a separator after each (a newline unless told
+otherwise), growing the string once for all of them, so the result can be written out in one go.
+
+DigitMode:
+  - fixedWidth: every digit the type has, leading zeros included (32 binary digits for an int, 16 hex digits for a
+    64 bit integer). Negative numbers come out as their bits, like in question 3b: -15 is 11111111111111111111111111110001,
+  - trimLeadingZeros: like question_three(), no leading zeros, except that 0 is printed as "0" (question_three(0)
+    prints nothing).
+
+formatDigits() returns the end of what it wrote (like std::to_chars); the buffer needs maxDigits(base, bits) chars.
+*/
+
+enum class NumberBase
+{
+    binary,
+    octal,
+    hex,
+};
+
+enum class DigitMode
+{
+    fixedWidth,
+    trimLeadingZeros,
+};
+
+namespace binary_format
+{
+    struct Tables
+    {
+        char binary[256][8];    // binary[byte] is the byte in binary, the highest bit first
+        char hex[256][2];       // hex[byte] is the byte in hex
+        char octal[64][2];      // octal[bits] are 6 bits as 2 octal digits
+    };
+
+    constexpr char hexDigits[]{ "0123456789abcdef" };
+
+    constexpr Tables makeTables()
+    {
+        Tables tables{};
+        for(int byte{ 0 }; byte < 256; ++byte)
+        {
+            for(int bit{ 0 }; bit < 8; ++bit)
+                tables.binary[byte][bit] = ((byte >> (7 - bit)) & 1) ? '1' : '0';
+
+            tables.hex[byte][0] = hexDigits[byte >> 4];
+            tables.hex[byte][1] = hexDigits[byte & 0xF];
+        }
+
+        for(int bits{ 0 }; bits < 64; ++bits)
+        {
+            tables.octal[bits][0] = static_cast<char>('0' + (bits >> 3));
+            tables.octal[bits][1] = static_cast<char>('0' + (bits & 7));
+        }
+
+        return tables;
+    }
+
+    inline constexpr Tables tables{ makeTables() };
+
+    constexpr int bitsPerDigit(NumberBase base)
+    {
+        return base == NumberBase::binary ? 1 : (base == NumberBase::octal ? 3 : 4);
+    }
+
+    // how many bits value needs (0 for 0)
+    inline int significantBits(std::uint64_t value)
+    {
+        if(value == 0)
+            return 0;
+#if defined(__GNUC__)
+        return 64 - __builtin_clzll(value);
+#else
+        int bits{ 0 };
+        while(value)
+        {
+            value >>= 1;
+            ++bits;
+        }
+        return bits;
+#endif
+    }
+
+    // the lowest digitCount binary digits of value
+    inline char* writeBinary(char* out, std::uint64_t value, int digitCount)
+    {
+        // the digits that don't make a whole byte come first, from the end of their byte's table entry
+        int lead{ digitCount % 8 };
+        int shift{ digitCount - lead };
+        if(lead)
+        {
+            std::memcpy(out, tables.binary[(value >> shift) & 0xFF] + 8 - lead, static_cast<std::size_t>(lead));
+            out += lead;
+        }
+
+        for(shift -= 8; shift >= 0; shift -= 8)
+        {
+            std::memcpy(out, tables.binary[(value >> shift) & 0xFF], 8);
+            out += 8;
+        }
+
+        return out;
+    }
+
+    inline char* writeHex(char* out, std::uint64_t value, int digitCount)
+    {
+        if(digitCount % 2)
+        {
+            *out++ = hexDigits[(value >> (4 * (digitCount - 1))) & 0xF];
+            --digitCount;
+        }
+
+        for(int shift{ 4 * digitCount - 8 }; shift >= 0; shift -= 8)
+        {
+            std::memcpy(out, tables.hex[(value >> shift) & 0xFF], 2);
+            out += 2;
+        }
+
+        return out;
+    }
+
+    // octal digits don't line up with bytes, so these are written from the last one backwards
+    inline char* writeOctal(char* out, std::uint64_t value, int digitCount)
+    {
+        char* end{ out + digitCount };
+        char* position{ end };
+
+        for(; digitCount >= 2; digitCount -= 2)
+        {
+            position -= 2;
+            std::memcpy(position, tables.octal[value & 63], 2);
+            value >>= 6;
+        }
+
+        if(digitCount)
+            *--position = static_cast<char>('0' + (value & 7));
+
+        return end;
+    }
+
+    inline char* write(char* out, std::uint64_t value, int bits, NumberBase base, DigitMode mode)
+    {
+        const int perDigit{ bitsPerDigit(base) };
+        int used{ mode == DigitMode::fixedWidth ? bits : significantBits(value) };
+        int digitCount{ (used + perDigit - 1) / perDigit };
+        if(digitCount == 0)
+            digitCount = 1; // 0 is "0"
+
+        switch(base)
+        {
+        case NumberBase::binary:
+            return writeBinary(out, value, digitCount);
+        case NumberBase::octal:
+            return writeOctal(out, value, digitCount);
+        case NumberBase::hex:
+        default:
+            return writeHex(out, value, digitCount);
+        }
+    }
+}
+
+// the most digits a number with bits bits can have in base
+constexpr int maxDigits(NumberBase base, int bits)
+{
+    return (bits + binary_format::bitsPerDigit(base) - 1) / binary_format::bitsPerDigit(base);
+}
+
+// writes the digits of value to out and returns the end of them
+template <typename T>
+char* formatDigits(char* out, T value, NumberBase base = NumberBase::binary, DigitMode mode = DigitMode::fixedWidth)
+{
+    static_assert(std::is_integral<T>::value, "formatDigits formats integers");
+
+    // negative numbers as their bits (of their own width, so -15 as an int is 32 digits)
+    using Unsigned = typename std::make_unsigned<T>::type;
+    return binary_format::write(out, static_cast<Unsigned>(value), static_cast<int>(sizeof(T) * 8), base, mode);
+}
+
+// the digits of values[0] ... values[count - 1] added to out, each followed by separator
+template <typename T>
+void appendDigits(std::string& out, const T* values, std::size_t count, NumberBase base = NumberBase::binary,
+                  DigitMode mode = DigitMode::fixedWidth, char separator = '\n')
+{
+    constexpr int bits{ static_cast<int>(sizeof(T) * 8) };
+    const std::size_t begin{ out.size() };
+
+    // room for the longest possible text, then cut back to what was written
+    out.resize(begin + count * (static_cast<std::size_t>(maxDigits(base, bits)) + 1));
+
+    char* position{ &out[begin] };
+    for(std::size_t i{ 0 }; i < count; ++i)
+    {
+        position = formatDigits(position, values[i], base, mode);
+        *position++ = separator;
+    }
+
+    out.resize(static_cast<std::size_t>(position - out.data()));
+}
+
+#endif
@@ -0,0 +1,121 @@
+#include <iostream>
+#include <chrono> // for std::chrono::steady_clock
+#include <cstdint> // for std::uint32_t, std::uint64_t
+#include <cstdio> // for std::fwrite
+#include <string>
+#include <vector>
+#include "binary_format.h" // for formatDigits, appendDigits
+
+/*
+Compares question_threeB() from main.cpp (recursive, one std::cout << per bit) with appendDigits() from
+binary_format.h, for a million 32 bit and a million 64 bit numbers. Run it with the output going somewhere, so that the
+terminal doesn't decide the timings:
+
+    g++ -std=c++17 -O2 binary_format_benchmark.cpp -o binary_format_benchmark
+    ./binary_format_benchmark > /dev/null
+
+The timings are printed to std::cerr.
+*/
+
+// question_threeB() from main.cpp, kept here as the baseline (and one for 64 bit numbers)
+void question_threeB(unsigned int x)
+{
+    if(x == 0)
+        return;
+
+    question_threeB(x/2);
+
+    std::cout << x % 2;
+}
+
+void question_threeB_64(std::uint64_t x)
+{
+    if(x == 0)
+        return;
+
+    question_threeB_64(x/2);
+
+    std::cout << x % 2;
+}
+
+template <typename Fcn>
+double timeIt(Fcn fcn)
+{
+    auto start{ std::chrono::steady_clock::now() };
+    fcn();
+    auto end{ std::chrono::steady_clock::now() };
+
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+int main()
+{
+    constexpr std::size_t count{ 1'000'000 };
+
+    std::vector<std::uint32_t> values32(count);
+    std::vector<std::uint64_t> values64(count);
+    std::uint64_t state{ 12345 };
+    for(std::size_t i{ 0 }; i < count; ++i)
+    {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        values64[i] = (state | 1) >> (i % 40); // different lengths, but never 0 (question_threeB(0) prints nothing)
+        values32[i] = static_cast<std::uint32_t>(values64[i] >> 32) | 1;
+    }
+
+    double recursive32{ timeIt([&]{
+        for(std::uint32_t value : values32)
+        {
+            question_threeB(value);
+            std::cout << '\n';
+        }
+        std::cout.flush();
+    }) };
+
+    // trimLeadingZeros gives exactly what question_threeB() prints
+    std::string text{};
+    double table32{ timeIt([&]{
+        appendDigits(text, values32.data(), count, NumberBase::binary, DigitMode::trimLeadingZeros);
+        std::fwrite(text.data(), 1, text.size(), stdout);
+        std::fflush(stdout);
+    }) };
+
+    double recursive64{ timeIt([&]{
+        for(std::uint64_t value : values64)
+        {
+            question_threeB_64(value);
+            std::cout << '\n';
+        }
+        std::cout.flush();
+    }) };
+
+    text.clear();
+    double table64{ timeIt([&]{
+        appendDigits(text, values64.data(), count, NumberBase::binary, DigitMode::trimLeadingZeros);
+        std::fwrite(text.data(), 1, text.size(), stdout);
+        std::fflush(stdout);
+    }) };
+
+    text.clear();
+    double fixed64{ timeIt([&]{
+        appendDigits(text, values64.data(), count, NumberBase::binary, DigitMode::fixedWidth);
+        std::fwrite(text.data(), 1, text.size(), stdout);
+        std::fflush(stdout);
+    }) };
+
+    text.clear();
+    double hex64{ timeIt([&]{
+        appendDigits(text, values64.data(), count, NumberBase::hex, DigitMode::fixedWidth);
+        std::fwrite(text.data(), 1, text.size(), stdout);
+        std::fflush(stdout);
+    }) };
+
+    std::cerr << count << " numbers\n";
+    std::cerr << "32 bit, recursive:           " << recursive32 << " ms\n";
+    std::cerr << "32 bit, appendDigits:        " << table32 << " ms\n";
+    std::cerr << "64 bit, recursive:           " << recursive64 << " ms\n";
+    std::cerr << "64 bit, appendDigits:        " << table64 << " ms\n";
+    std::cerr << "64 bit, fixed width:         " << fixed64 << " ms\n";
+    std::cerr << "64 bit, hex, fixed width:    " << hex64 << " ms\n";
+
+    return 0;
+}
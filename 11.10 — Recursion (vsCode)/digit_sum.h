@@ -0,0 +1,83 @@
+#ifndef DIGIT_SUM_H
+#define DIGIT_SUM_H
+
+#include <cstddef> // for std::size_t
+#include <cstdint> // for std::uint64_t, std::uint32_t, std::uint8_t
+
+/*
+The sum of the decimal digits of a number (quesion_two()), without recursion and for whole arrays.
+
+quesion_two() does a division and a modulo by 10 and a recursive call for every digit. digitSum() instead:
+  - looks up 4 digits at a time in a table with the digit sum of every number from 0 to 9999 (10 KB, it stays in the
+    L1 cache). The table is built at compile time,
+  - takes 8 digits at a time off the number with one 64 bit division by 100000000, and splits those 8 into two groups of
+    4 with 32 bit arithmetic. The divisor is a constant, so the compiler turns every division and modulo into a multiply
+    and a shift (a real division instruction takes 10 times as long or more).
+So a 20 digit number is 2 64 bit and 3 32 bit "divisions" and 5 table lookups, instead of 20 of each.
+
+digitSum() is constexpr, so digitSum(93427) with a constant is worked out while compiling (static_assert(digitSum(93427)
+== 25) works). For arrays:
+  - digitSums(values, count, sums) writes the digit sum of every value to sums,
+  - digitSumTotal(values, count) adds them all up, e.g. as a checksum.
+The numbers in an array don't depend on each other, so the CPU works on several of them at once.
+
+There's no SIMD version: the vector instruction sets (SSE/AVX2, NEON) have no 64 bit multiply-high, so the divisions
+by 100000000 can't be done several at a time; the 64 bit values would have to be split up one by one first anyway.
+The results are the same as quesion_two()'s for every non-negative int.
+*/
+
+namespace digit_sum
+{
+    struct Table
+    {
+        std::uint8_t sums[10000];
+    };
+
+    constexpr Table makeTable()
+    {
+        Table table{};
+        for(int n{ 1 }; n < 10000; ++n)
+            table.sums[n] = static_cast<std::uint8_t>(table.sums[n / 10] + n % 10);
+
+        return table;
+    }
+
+    inline constexpr Table table{ makeTable() };
+
+    // the digit sum of a number below 100000000
+    constexpr int eightDigits(std::uint32_t value)
+    {
+        return table.sums[value / 10000] + table.sums[value % 10000];
+    }
+}
+
+constexpr int digitSum(std::uint64_t value)
+{
+    int sum{ 0 };
+    while(value >= 100000000)
+    {
+        sum += digit_sum::eightDigits(static_cast<std::uint32_t>(value % 100000000));
+        value /= 100000000;
+    }
+
+    return sum + digit_sum::eightDigits(static_cast<std::uint32_t>(value));
+}
+
+// sums[i] is the digit sum of values[i]
+inline void digitSums(const std::uint64_t* values, std::size_t count, int* sums)
+{
+    for(std::size_t i{ 0 }; i < count; ++i)
+        sums[i] = digitSum(values[i]);
+}
+
+// the digit sums of all values added up
+inline std::uint64_t digitSumTotal(const std::uint64_t* values, std::size_t count)
+{
+    std::uint64_t total{ 0 };
+    for(std::size_t i{ 0 }; i < count; ++i)
+        total += static_cast<std::uint64_t>(digitSum(values[i]));
+
+    return total;
+}
+
+#endif
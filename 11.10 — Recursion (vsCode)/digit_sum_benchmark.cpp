@@ -0,0 +1,83 @@
+#include <iostream>
+#include <chrono> // for std::chrono::steady_clock
+#include <cstdint> // for std::uint64_t
+#include <vector>
+#include "digit_sum.h" // for digitSum, digitSums, digitSumTotal
+
+/*
+Compares quesion_two() from main.cpp (recursive, one division and modulo by 10 per digit) with a loop that does the
+same without recursion and with digitSumTotal() from digit_sum.h, for 10 million 64 bit ids of all lengths.
+
+    g++ -std=c++17 -O2 digit_sum_benchmark.cpp -o digit_sum_benchmark
+*/
+
+// quesion_two() from main.cpp for 64 bit numbers, kept here as the baseline
+int quesion_two(std::uint64_t x)
+{
+    if(x < 10)
+        return static_cast<int>(x);
+    else
+        return quesion_two(x / 10) + static_cast<int>(x % 10);
+}
+
+int digitSumLoop(std::uint64_t x)
+{
+    int sum{ 0 };
+    for(; x > 0; x /= 10)
+        sum += static_cast<int>(x % 10);
+
+    return sum;
+}
+
+template <typename Fcn>
+double timeIt(Fcn fcn)
+{
+    auto start{ std::chrono::steady_clock::now() };
+    fcn();
+    auto end{ std::chrono::steady_clock::now() };
+
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+int main()
+{
+    constexpr std::size_t count{ 10'000'000 };
+
+    std::vector<std::uint64_t> ids(count);
+    std::uint64_t state{ 12345 };
+    for(std::size_t i{ 0 }; i < count; ++i)
+    {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        ids[i] = state >> (i % 64); // from 1 to 20 digits
+    }
+
+    std::uint64_t recursive{ 0 };
+    double recursiveMs{ timeIt([&]{
+        for(std::uint64_t id : ids)
+            recursive += static_cast<std::uint64_t>(quesion_two(id));
+    }) };
+
+    std::uint64_t loop{ 0 };
+    double loopMs{ timeIt([&]{
+        for(std::uint64_t id : ids)
+            loop += static_cast<std::uint64_t>(digitSumLoop(id));
+    }) };
+
+    std::uint64_t table{ 0 };
+    double tableMs{ timeIt([&]{ table = digitSumTotal(ids.data(), count); }) };
+
+    std::vector<int> sums(count);
+    double sumsMs{ timeIt([&]{ digitSums(ids.data(), count, sums.data()); }) };
+
+    bool same{ recursive == loop && loop == table };
+    for(std::size_t i{ 0 }; i < count && same; i += 997)
+        same = sums[i] == quesion_two(ids[i]);
+
+    std::cout << count << " ids" << (same ? "" : " (DIFFERENT RESULTS)") << '\n';
+    std::cout << "recursive quesion_two: " << recursiveMs << " ms\n";
+    std::cout << "loop, / 10 and % 10:   " << loopMs << " ms\n";
+    std::cout << "digitSumTotal:         " << tableMs << " ms\n";
+    std::cout << "digitSums:             " << sumsMs << " ms\n";
+
+    return 0;
+}
@@ -0,0 +1,166 @@
+#ifndef EXPLICIT_STACK_H
+#define EXPLICIT_STACK_H
+
+#include <cstddef> // for std::size_t
+#include <iostream>
+#include <vector>
+
+/*
+Stack-safe versions of sumTo(), factorial_of_an_integer_N() and countDown_plus().
+
+The recursive versions use one call stack frame per level, so sumTo(1'000'000) needs a million frames and crashes on a
+thread with a small stack. The versions here keep their "frames" in a FrameStack instead: a std::vector that lives on the
+heap, so the native stack use stays the same no matter how deep the recursion goes. Each function does the two halves of
+the recursion by hand: the calls on the way down (push a frame), and the work after the recursive call on the way back
+up (pop a frame).
+
+Every thread keeps one FrameStack per frame type and reuses it, so after the first deep call no more memory is allocated.
+Pass a RecursionStats to find out how deep the recursion went and how many bytes of frames that took.
+*/
+
+struct RecursionStats
+{
+    std::size_t peakDepth{};    // most frames on the stack at the same time
+    std::size_t frameBytes{};   // size of one frame
+    std::size_t peakBytes{};    // peakDepth * frameBytes
+};
+
+template <typename Frame>
+class FrameStack
+{
+public:
+    void push(const Frame& frame)
+    {
+        m_frames.push_back(frame);
+
+        if(m_frames.size() > m_peakDepth)
+            m_peakDepth = m_frames.size();
+    }
+
+    Frame pop()
+    {
+        Frame frame{ m_frames.back() };
+        m_frames.pop_back();
+        return frame;
+    }
+
+    bool empty() const { return m_frames.empty(); }
+
+    // empties the stack but keeps its memory for the next call
+    void reset()
+    {
+        m_frames.clear();
+        m_peakDepth = 0;
+    }
+
+    void fillStats(RecursionStats* stats) const
+    {
+        if(!stats)
+            return;
+
+        stats->peakDepth = m_peakDepth;
+        stats->frameBytes = sizeof(Frame);
+        stats->peakBytes = m_peakDepth * sizeof(Frame);
+    }
+
+    // the FrameStack this thread reuses for Frame
+    static FrameStack& forThisThread()
+    {
+        thread_local FrameStack stack{};
+        stack.reset();
+        return stack;
+    }
+
+private:
+    std::vector<Frame> m_frames{};
+    std::size_t m_peakDepth{ 0 };
+};
+
+namespace explicit_stack
+{
+    // what sumTo(value) still has to do after sumTo(value-1) returns: add value
+    struct SumToFrame
+    {
+        int value;
+    };
+
+    // what factorial(x) still has to do after factorial(x-1) returns: multiply by x
+    struct FactorialFrame
+    {
+        int x;
+    };
+
+    // what countDown_plus(count) still has to do after countDown_plus(count-1) returns: print "pop count"
+    struct CountDownFrame
+    {
+        int count;
+    };
+}
+
+// same result as sumTo(), but the sum is a long long so inputs up to a few billion don't overflow
+inline long long sumTo_explicit_stack(int sumto, RecursionStats* stats = nullptr)
+{
+    auto& stack{ FrameStack<explicit_stack::SumToFrame>::forThisThread() };
+
+    // on the way down: every call that isn't a base case leaves a frame behind
+    while(sumto > 1)
+    {
+        stack.push({ sumto });
+        sumto = sumto - 1;
+    }
+
+    // the base cases
+    long long result{ sumto == 1 ? 1 : 0 };
+
+    // on the way back up
+    while(!stack.empty())
+        result += stack.pop().value;
+
+    stack.fillStats(stats);
+    return result;
+}
+
+// same result as factorial_of_an_integer_N() for inputs up to 20 (21! doesn't fit in a long long)
+inline long long factorial_explicit_stack(int x, RecursionStats* stats = nullptr)
+{
+    auto& stack{ FrameStack<explicit_stack::FactorialFrame>::forThisThread() };
+
+    while(x > 1)
+    {
+        stack.push({ x });
+        x = x - 1;
+    }
+
+    // multiply as unsigned so that large inputs wrap around instead of overflowing
+    unsigned long long result{ 1 };
+
+    while(!stack.empty())
+        result *= static_cast<unsigned long long>(stack.pop().x);
+
+    stack.fillStats(stats);
+    return static_cast<long long>(result);
+}
+
+// prints the same "push"/"pop" lines as countDown_plus()
+inline void countDown_explicit_stack(int count, std::ostream& out = std::cout, RecursionStats* stats = nullptr)
+{
+    auto& stack{ FrameStack<explicit_stack::CountDownFrame>::forThisThread() };
+
+    while(true)
+    {
+        out << "push " << count << '\n';
+        stack.push({ count });
+
+        if(count > 1)// termination condition
+            count = count - 1;
+        else
+            break;
+    }
+
+    while(!stack.empty())
+        out << "pop " << stack.pop().count << '\n';
+
+    stack.fillStats(stats);
+}
+
+#endif
@@ -0,0 +1,91 @@
+#ifndef FIBONACCI_H
+#define FIBONACCI_H
+
+#include <array>
+#include <cstddef> // for std::size_t
+#include <limits> // for std::numeric_limits
+
+/*
+Faster Fibonacci numbers.
+
+fibonacciTable holds every Fibonacci number that fits in a std::size_t (F(0) to F(93) with a 64-bit size_t),
+it's computed by the compiler so looking one up costs nothing at run time.
+
+Fibonacci_fast_doubling() uses
+    F(2k)   = F(k) * (2*F(k+1) - F(k))
+    F(2k+1) = F(k)^2 + F(k+1)^2
+to go through the bits of n, which takes O(log n) steps instead of O(n). Past the end of the table the results wrap
+around, just like any other std::size_t arithmetic.
+*/
+
+namespace fibonacci
+{
+    // how many Fibonacci numbers fit in a std::size_t
+    constexpr std::size_t countFitting()
+    {
+        std::size_t previous{ 0 };
+        std::size_t current{ 1 };
+        std::size_t count{ 2 };
+
+        while(previous <= std::numeric_limits<std::size_t>::max() - current)
+        {
+            std::size_t next{ previous + current };
+            previous = current;
+            current = next;
+            ++count;
+        }
+
+        return count;
+    }
+
+    constexpr std::size_t tableSize{ countFitting() };
+
+    constexpr std::array<std::size_t, tableSize> makeTable()
+    {
+        std::array<std::size_t, tableSize> table{};
+        table[1] = 1;
+
+        for(std::size_t i{ 2 }; i < tableSize; ++i)
+            table[i] = table[i-1] + table[i-2];
+
+        return table;
+    }
+}
+
+constexpr std::array<std::size_t, fibonacci::tableSize> fibonacciTable{ fibonacci::makeTable() };
+
+constexpr std::size_t Fibonacci_fast_doubling(std::size_t n)
+{
+    if(n < fibonacci::tableSize)
+        return fibonacciTable[n];
+
+    // find the highest bit of n
+    std::size_t bit{ 1 };
+    while(bit <= n / 2)
+        bit *= 2;
+
+    // f is F(k), g is F(k+1), k is made of the bits of n seen so far
+    std::size_t f{ 0 };
+    std::size_t g{ 1 };
+
+    for(; bit != 0; bit /= 2)
+    {
+        std::size_t f2{ f * (2*g - f) };    // F(2k)
+        std::size_t g2{ f*f + g*g };        // F(2k+1)
+
+        if(n & bit)
+        {
+            f = g2;         // F(2k+1)
+            g = f2 + g2;    // F(2k+2)
+        }
+        else
+        {
+            f = f2;
+            g = g2;
+        }
+    }
+
+    return f;
+}
+
+#endif
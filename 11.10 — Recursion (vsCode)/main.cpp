@@ -1,5 +1,11 @@
 #include <iostream>
 #include <vector>
+#include "memoize.h" // for memoize
+#include "fibonacci.h" // for Fibonacci_fast_doubling, fibonacciTable
+#include "explicit_stack.h" // for sumTo_explicit_stack, factorial_explicit_stack, countDown_explicit_stack
+#include "binary_format.h" // for formatDigits, appendDigits
+#include "digit_sum.h" // for digitSum, digitSumTotal
+#include "../11.6 — Inline functions (vsCode)/constexpr_math.h" // for constexpr_math::sumTo, constexpr_math::factorial
 
 void countDown(int count)
 {
@@ -46,17 +52,17 @@ std::size_t Fibonacci(std::size_t x)
 // h/t to potterman28wxcv for a variant of this code
 std::size_t Fibonacci_memoized_version(std::size_t x)
 {
-    // We'll use a static std::vector to cache calculated results
-    static std::vector<int> results{0, 1};
-
-    if(x < static_cast<int>(std::size(results)))
-        return results[x];
-    else
+    // We'll use a memoized function (see memoize.h) to cache calculated results, it's shared by all threads
+    // and the recursive calls go through the cache too
+    static const auto fibonacci{ memoize<std::size_t, std::size_t>([](const auto& self, std::size_t n) -> std::size_t
     {
-        // Otherwise calculate the new result and add it
-        results.push_back(Fibonacci(x - 1) + Fibonacci(x - 2));
-        return results[x];
-    }
+        if(n < 2)
+            return n;
+        else
+            return self(n - 1) + self(n - 2);
+    }, 4096) };
+
+    return fibonacci(x);
 }
 
 int factorial_of_an_integer_N(int x)
@@ -90,14 +96,15 @@ void question_three(int x)
     std::cout << x % 2;
 }
 
-unsigned int question_threeB(unsigned int x)
+void question_threeB(unsigned int x)
 {
     if(x == 0)
-        return 0;
-    
-        question_three(x/2);
+        return;
+
+    // Recurse to the next bit (as unsigned, so that the top bit of a negative number isn't lost)
+    question_threeB(x/2);
 
-        std::cout << x % 2;
+    std::cout << x % 2;
 }
 
 
@@ -143,6 +150,7 @@ int main()
     condition (and some extra output):
     */
     countDown_plus(5);
+    countDown_explicit_stack(5);// the same output, without recursion (see explicit_stack.h)
 
     /*
     Now when we run our program, countDown() will start by outputting the following:
@@ -226,6 +234,23 @@ int main()
     side effect, and using a variable that has a side effect applied more than once in a given expression will result in 
     undefined behavior. Using sumto - 1 avoids side effects, making sumto safe to use more than once in the expression.
     */
+
+    /*
+    Every level of sumTo() is another frame on the call stack, so sumTo(1'000'000) can crash a thread with a small stack.
+    sumTo_explicit_stack() (see explicit_stack.h) keeps its frames in a std::vector on the heap instead, so it works for
+    any depth and tells us how deep it went:
+    */
+    RecursionStats sumToStats{};
+    std::cout << sumTo_explicit_stack(5) << ' ' << sumTo_explicit_stack(1'000'000, &sumToStats) << '\n';
+    std::cout << "peak depth " << sumToStats.peakDepth << ", " << sumToStats.peakBytes << " bytes of frames\n";
+
+    /*
+    sumTo() doesn't need frames at all: the sum of 1 to n is n * (n + 1) / 2. constexpr_math::sumTo() (see
+    ../11.6 — Inline functions/constexpr_math.h) is that closed form as a constexpr function returning a long long, so
+    sumTo(1'000'000) doesn't overflow (the int sumTo() above does), and with a constant it's worked out while compiling:
+    */
+    constexpr long long sumToMillion{ constexpr_math::sumTo(1'000'000) };
+    std::cout << sumToMillion << '\n';
     
 
     std::cout << std::endl;
@@ -307,6 +332,15 @@ int main()
     This memoized version makes 35 function calls, which is much better than the 1205 of the original algorithm.
     */
 
+    /*
+    The cache uses std::size_t now, so F(93) still comes out right (the old std::vector<int> overflowed past F(46)).
+    When the numbers are needed often, it's even better not to recurse at all: fibonacciTable is filled in by the compiler,
+    and Fibonacci_fast_doubling() needs only O(log n) steps (see fibonacci.h).
+    */
+    std::cout << Fibonacci_memoized_version(93) << ' ' << Fibonacci_fast_doubling(93) << ' ' << fibonacciTable[93] << '\n';
+
+    static_assert(Fibonacci_fast_doubling(12) == 144, "F(12) is 144");
+
 
     std::cout << std::endl;
     ////////////////////////////////////////////////////////////////////////////////////////////
@@ -361,6 +395,18 @@ int main()
     of all the numbers between N and 1.
     */
     std::cout << factorial_of_an_integer_N(6) << '\n';    
+    std::cout << factorial_explicit_stack(6) << '\n';
+
+    /*
+    13! is already too big for an int. constexpr_math::factorial() looks n! up in a table of 0! to 20! that the compiler
+    builds, as std::uint64_t (21! doesn't fit in 64 bits either). With a constant that's too big, like factorial(21) in
+    a constexpr variable, the program doesn't compile; at run time factorial_checked() says that it overflowed.
+    */
+    constexpr std::uint64_t factorial20{ constexpr_math::factorial(20) };
+    std::cout << factorial20 << '\n';
+    int tooBig{ 21 };
+    std::cout << "21! fits in 64 bits: " << std::boolalpha << !constexpr_math::factorial_checked(tooBig).overflowed
+              << std::noboolalpha << '\n';
 
     /*
     2)
@@ -371,6 +417,12 @@ int main()
     
     std::cout << quesion_two(123) << '\n';
 
+    // without recursion (see digit_sum.h), 4 digits at a time from a table. It's constexpr, so with a constant the
+    // compiler already knows the answer:
+    static_assert(digitSum(93427) == 25, "digitSum() is worked out while compiling");
+    std::uint64_t ids[]{ 93427, 123, 18446744073709551615ull };
+    std::cout << digitSum(93427) << ' ' << digitSumTotal(ids, 3) << '\n';
+
 
     /*
     3a) This one is slightly trickier. Write a program that asks the user to enter a positive integer, and then uses a 
@@ -405,6 +457,22 @@ int main()
 
     question_threeB(x_qq);
 
+    std::cout << '\n';
+
+    /*
+    Without recursion (see binary_format.h): the digits come from a table with the 8 binary digits of every byte, so
+    a whole byte is copied at once, and the leading zeros can be kept or left out.
+    */
+    char digits[maxDigits(NumberBase::binary, 32)];
+    std::cout.write(digits, formatDigits(digits, x_qq, NumberBase::binary, DigitMode::fixedWidth) - digits);
+    std::cout << '\n';
+
+    // or many numbers at once, here in hex, into one string
+    int numbers[]{ -15, 0, 255, 4096 };
+    std::string hexNumbers{};
+    appendDigits(hexNumbers, numbers, 4, NumberBase::hex, DigitMode::trimLeadingZeros, ' ');
+    std::cout << hexNumbers << '\n';
+
 
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,190 @@
+#ifndef MEMOIZE_H
+#define MEMOIZE_H
+
+#include <atomic> // for std::atomic
+#include <cstddef> // for std::size_t
+#include <cstdint> // for std::uint32_t, std::uint64_t
+#include <functional> // for std::hash
+#include <memory> // for std::unique_ptr
+#include <type_traits> // for std::is_trivially_copyable
+
+/*
+Memoization for pure functions (the same input always gives the same output).
+
+MemoCache is a fixed-size cache that several threads can use at the same time without locks:
+  - every slot is guarded by a sequence number (a "seqlock"): a writer makes it odd while it writes and even again
+    when it's done, a reader checks that the number didn't change while it read the slot,
+  - a lookup never waits: if the slot is being written right now it simply counts as a miss,
+  - an insert never waits either: if another thread is writing the same slot, this result just isn't cached.
+
+Key and Value are kept in std::atomic, so they have to be small trivially copyable types (integers, pointers, ...).
+
+memoize() wraps a function so that it checks the cache first. The wrapped function gets the memoized version of itself
+as its first parameter, so its recursive calls go through the cache too:
+
+    auto fib{ memoize<std::size_t, std::size_t>([](auto& self, std::size_t n) -> std::size_t
+    {
+        return n < 2 ? n : self(n - 1) + self(n - 2);
+    }) };
+*/
+
+enum class Eviction
+{
+    replaceOld,     // a new result replaces whatever was cached in its slot
+    keepFirst,      // a slot keeps the first result stored in it (useful if the small inputs are the hot ones)
+};
+
+struct MemoStats
+{
+    std::uint64_t hits{};
+    std::uint64_t misses{};
+    std::uint64_t inserts{};
+};
+
+template <typename Key, typename Value>
+class MemoCache
+{
+    static_assert(std::is_trivially_copyable<Key>::value && std::is_trivially_copyable<Value>::value,
+                  "MemoCache keys and values have to be trivially copyable");
+
+public:
+    // capacity is rounded up to a power of two
+    explicit MemoCache(std::size_t capacity = 1024, Eviction eviction = Eviction::replaceOld)
+        : m_eviction{ eviction }
+    {
+        m_capacity = 1;
+        while(m_capacity < capacity)
+            m_capacity *= 2;
+
+        m_slots.reset(new Slot[m_capacity]);
+    }
+
+    // returns true (and sets value) if key is in the cache
+    bool find(const Key& key, Value& value) const
+    {
+        const Slot& slot{ m_slots[slotIndex(key)] };
+
+        std::uint32_t before{ slot.sequence.load(std::memory_order_acquire) };
+
+        // empty, or a writer is busy with it
+        if(before == 0 || (before & 1) != 0)
+        {
+            m_misses.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        Key cachedKey{ slot.key.load(std::memory_order_relaxed) };
+        Value cachedValue{ slot.value.load(std::memory_order_relaxed) };
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        std::uint32_t after{ slot.sequence.load(std::memory_order_relaxed) };
+
+        if(before != after || !(cachedKey == key))
+        {
+            m_misses.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        m_hits.fetch_add(1, std::memory_order_relaxed);
+        value = cachedValue;
+        return true;
+    }
+
+    void insert(const Key& key, const Value& value)
+    {
+        Slot& slot{ m_slots[slotIndex(key)] };
+
+        std::uint32_t sequence{ slot.sequence.load(std::memory_order_relaxed) };
+
+        if((sequence & 1) != 0)
+            return;// somebody else is writing this slot
+        if(sequence != 0 && m_eviction == Eviction::keepFirst)
+            return;
+
+        // lock the slot by making its sequence number odd
+        if(!slot.sequence.compare_exchange_strong(sequence, sequence + 1, std::memory_order_acquire))
+            return;
+        // the odd sequence number has to be visible before the new key and value (acquire alone doesn't keep the
+        // stores below from moving above it), or a reader could see an even number twice around a half written slot
+        std::atomic_thread_fence(std::memory_order_release);
+
+        slot.key.store(key, std::memory_order_relaxed);
+        slot.value.store(value, std::memory_order_relaxed);
+
+        // even again (and never 0, 0 means "empty")
+        std::uint32_t next{ sequence + 2 };
+        if(next == 0)
+            next = 2;
+        slot.sequence.store(next, std::memory_order_release);
+
+        m_inserts.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    MemoStats stats() const
+    {
+        return { m_hits.load(std::memory_order_relaxed), m_misses.load(std::memory_order_relaxed),
+                 m_inserts.load(std::memory_order_relaxed) };
+    }
+
+    std::size_t capacity() const { return m_capacity; }
+
+private:
+    struct Slot
+    {
+        std::atomic<std::uint32_t> sequence{ 0 };
+        std::atomic<Key> key{};
+        std::atomic<Value> value{};
+    };
+
+    std::size_t slotIndex(const Key& key) const
+    {
+        // std::hash of an integer is usually the integer itself, mix it so neighbouring keys spread out
+        std::uint64_t hash{ static_cast<std::uint64_t>(std::hash<Key>{}(key)) * 0x9E3779B97F4A7C15ull };
+        return static_cast<std::size_t>(hash >> 32) & (m_capacity - 1);
+    }
+
+    std::unique_ptr<Slot[]> m_slots{};
+    std::size_t m_capacity{};
+    Eviction m_eviction{};
+
+    mutable std::atomic<std::uint64_t> m_hits{ 0 };
+    mutable std::atomic<std::uint64_t> m_misses{ 0 };
+    std::atomic<std::uint64_t> m_inserts{ 0 };
+};
+
+template <typename Key, typename Value, typename Fcn>
+class Memoized
+{
+public:
+    Memoized(Fcn fcn, std::size_t capacity, Eviction eviction)
+        : m_fcn{ fcn }, m_cache{ capacity, eviction }
+    {
+    }
+
+    Value operator()(const Key& key) const
+    {
+        Value value{};
+        if(m_cache.find(key, value))
+            return value;
+
+        value = m_fcn(*this, key);
+        m_cache.insert(key, value);
+        return value;
+    }
+
+    const MemoCache<Key, Value>& cache() const { return m_cache; }
+    MemoStats stats() const { return m_cache.stats(); }
+
+private:
+    Fcn m_fcn;
+    mutable MemoCache<Key, Value> m_cache;   // filling the cache doesn't change what the function returns
+};
+
+// fcn is called as fcn(memoized, key), see the example at the top of this file
+template <typename Key, typename Value, typename Fcn>
+Memoized<Key, Value, Fcn> memoize(Fcn fcn, std::size_t capacity = 1024, Eviction eviction = Eviction::replaceOld)
+{
+    return Memoized<Key, Value, Fcn>{ fcn, capacity, eviction };
+}
+
+#endif
@@ -0,0 +1,128 @@
+#include <iostream>
+#include <sstream> // for std::ostringstream
+#include <chrono> // for std::chrono::steady_clock
+#include "explicit_stack.h" // for sumTo_explicit_stack, factorial_explicit_stack, countDown_explicit_stack
+
+/*
+Compares native recursion, the explicit stack versions from explicit_stack.h and closed-form/iterative versions.
+Build with optimisations, e.g.:
+
+    g++ -std=c++17 -O2 recursion_benchmark.cpp -o recursion_benchmark
+
+The native versions only run up to 100'000 levels, deeper than that they can overflow the call stack.
+*/
+
+// the recursive functions from main.cpp (with long long results so the big inputs can be compared), kept as the baseline
+long long sumTo_native(int sumto)
+{
+    if(sumto <= 0)
+        return 0;
+    else if(sumto == 1)
+        return 1;
+    else
+        return sumTo_native(sumto-1) + sumto;
+}
+
+unsigned long long factorial_native(int x)
+{
+    if(x <= 1)
+        return 1;
+    else
+        return static_cast<unsigned long long>(x) * factorial_native(x - 1);
+}
+
+void countDown_native(int count, std::ostream& out)
+{
+    out << "push " << count << '\n';
+
+    if(count > 1)
+        countDown_native(count-1, out);
+
+    out << "pop " << count << '\n';
+}
+
+// closed form: 1 + 2 + ... + n = n(n+1)/2
+long long sumTo_closed_form(int sumto)
+{
+    if(sumto <= 0)
+        return 0;
+
+    long long n{ sumto };
+    return n * (n + 1) / 2;
+}
+
+unsigned long long factorial_iterative(int x)
+{
+    unsigned long long result{ 1 };
+    for(int i{ 2 }; i <= x; ++i)
+        result *= static_cast<unsigned long long>(i);
+
+    return result;
+}
+
+void countDown_iterative(int count, std::ostream& out)
+{
+    for(int i{ count }; i >= 1; --i)
+        out << "push " << i << '\n';
+    for(int i{ 1 }; i <= count; ++i)
+        out << "pop " << i << '\n';
+}
+
+// runs fcn repetitions times and returns the nanoseconds per call
+template <typename Fcn>
+double timeIt(int repetitions, Fcn fcn)
+{
+    auto start{ std::chrono::steady_clock::now() };
+    for(int i{ 0 }; i < repetitions; ++i)
+        fcn();
+    auto end{ std::chrono::steady_clock::now() };
+
+    return std::chrono::duration<double, std::nano>(end - start).count() / repetitions;
+}
+
+// keeps the compiler from throwing away results we never look at
+volatile unsigned long long g_sink{};
+
+int main()
+{
+    for(int depth : { 1'000, 100'000, 10'000'000 })
+    {
+        int repetitions{ depth >= 10'000'000 ? 3 : 2'000'000 / depth };
+        bool runNative{ depth <= 100'000 };
+
+        std::cout << "depth " << depth << ":\n";
+
+        // sumTo
+        if(runNative)
+            std::cout << "  sumTo native:        " << timeIt(repetitions, [=]{ g_sink = g_sink + sumTo_native(depth); }) << " ns\n";
+
+        RecursionStats stats{};
+        std::cout << "  sumTo explicit:      "
+                  << timeIt(repetitions, [&]{ g_sink = g_sink + sumTo_explicit_stack(depth, &stats); }) << " ns"
+                  << " (peak depth " << stats.peakDepth << ", " << stats.peakBytes << " bytes)\n";
+        std::cout << "  sumTo closed form:   " << timeIt(repetitions, [=]{ g_sink = g_sink + sumTo_closed_form(depth); }) << " ns\n";
+
+        // factorial (wraps around for these depths, all three wrap the same way)
+        if(runNative)
+            std::cout << "  factorial native:    " << timeIt(repetitions, [=]{ g_sink = g_sink + factorial_native(depth); }) << " ns\n";
+        std::cout << "  factorial explicit:  "
+                  << timeIt(repetitions, [&]{ g_sink = g_sink + static_cast<unsigned long long>(factorial_explicit_stack(depth, &stats)); })
+                  << " ns (peak depth " << stats.peakDepth << ", " << stats.peakBytes << " bytes)\n";
+        std::cout << "  factorial iterative: " << timeIt(repetitions, [=]{ g_sink = g_sink + factorial_iterative(depth); }) << " ns\n";
+
+        // countDown, printed into a string instead of the console
+        int printRepetitions{ repetitions > 20 ? 20 : repetitions };
+        std::ostringstream out{};
+
+        if(runNative)
+            std::cout << "  countDown native:    "
+                      << timeIt(printRepetitions, [&]{ out.str(""); countDown_native(depth, out); }) << " ns\n";
+        std::cout << "  countDown explicit:  "
+                  << timeIt(printRepetitions, [&]{ out.str(""); countDown_explicit_stack(depth, out, &stats); })
+                  << " ns (peak depth " << stats.peakDepth << ", " << stats.peakBytes << " bytes)\n";
+        std::cout << "  countDown iterative: "
+                  << timeIt(printRepetitions, [&]{ out.str(""); countDown_iterative(depth, out); }) << " ns\n";
+    }
+
+    return 0;
+}
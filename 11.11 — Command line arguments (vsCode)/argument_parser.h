@@ -0,0 +1,335 @@
+#ifndef ARGUMENT_PARSER_H
+#define ARGUMENT_PARSER_H
+
+#include <algorithm> // for std::copy
+#include <charconv> // for std::from_chars
+#include <cstddef> // for std::size_t
+#include <cstdint> // for std::uint32_t
+#include <fstream> // for std::ifstream
+#include <memory> // for std::unique_ptr
+#include <string>
+#include <string_view>
+#include <system_error> // for std::errc
+#include <type_traits> // for std::is_arithmetic
+#include <utility> // for std::exchange
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h> // for open
+#include <sys/mman.h> // for mmap, munmap
+#include <sys/stat.h> // for fstat
+#include <cerrno> // for errno, EINTR
+#include <unistd.h> // for read, close
+#define ARGUMENT_PARSER_HAS_MMAP 1
+#endif
+
+/*
+Command line arguments as numbers, without a std::stringstream per argument, and with response files.
+
+A std::stringstream for every argument means constructing a stream (with its locale) every time, which adds up for
+tens of thousands of arguments. Here:
+
+  - ArgumentList::load(argc, argv, error) collects the arguments as std::string_views. An argument that starts with @
+    is a response file: @numbers.txt is replaced by the arguments in numbers.txt, which are separated by spaces, tabs or
+    newlines (a response file can name other response files, up to 16 deep; no quotes, it's meant for numbers).
+    The file is memory-mapped (on systems that have mmap; elsewhere, and for pipes such as @/dev/stdin, it's read into
+    memory), and its arguments are views into the mapped file, so nothing is copied. The views are good as long as the
+    ArgumentList.
+  - toNumbers(first, numbers, error) converts the arguments from index first on (1 to skip the program's name) with
+    std::from_chars into numbers, which is reserved once for all of them. Any arithmetic type works (int, long long,
+    double, ...). A leading + is allowed, like std::stringstream allows it.
+
+When something is wrong, both return false and fill in an ArgumentError: which argv entry it was (the @file entry for
+arguments from a response file), and for arguments from a file the file's name and the line and column in it.
+error.describe() puts that into a sentence, e.g.
+    argument 2 ("12x"), numbers.txt line 3 column 7: not a number
+*/
+
+struct ArgumentError
+{
+    int argvIndex{ -1 };        // the argv entry the bad argument is (or came from)
+    std::string text{};         // the bad argument (or the response file's name)
+    std::string file{};         // the response file it's in, empty for an argument from argv
+    std::size_t line{ 0 };      // where in the file, from 1 (0 for argv)
+    std::size_t column{ 0 };
+    std::string message{};
+
+    std::string describe() const
+    {
+        std::string result{ "argument " + std::to_string(argvIndex) + " (\"" + text + "\")" };
+        if(!file.empty())
+            result += ", " + file + " line " + std::to_string(line) + " column " + std::to_string(column);
+
+        return result + ": " + message;
+    }
+};
+
+namespace argument_parser
+{
+    // a file's contents in memory, mapped if possible, read otherwise
+    class MappedFile
+    {
+    public:
+        MappedFile() = default;
+
+        MappedFile(MappedFile&& other) noexcept
+            : m_name{ std::move(other.m_name) }, m_data{ std::exchange(other.m_data, nullptr) },
+              m_size{ std::exchange(other.m_size, 0) }, m_mapped{ other.m_mapped }, m_buffer{ std::move(other.m_buffer) }
+        {
+        }
+
+        MappedFile& operator=(MappedFile&&) = delete;
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        ~MappedFile()
+        {
+#if defined(ARGUMENT_PARSER_HAS_MMAP)
+            if(m_mapped && m_data)
+                ::munmap(const_cast<char*>(m_data), m_size);
+#endif
+        }
+
+        // false if the file can't be opened
+        bool open(const std::string& name)
+        {
+            m_name = name;
+
+#if defined(ARGUMENT_PARSER_HAS_MMAP)
+            int fd{ ::open(name.c_str(), O_RDONLY) };
+            if(fd < 0)
+                return false;
+
+            // only a regular file can be mapped: a pipe or a FIFO (@/dev/stdin, @<(command)) has a size of 0 whatever
+            // comes through it, so that's read, and so is a file mmap doesn't work for
+            struct stat status{};
+            if(::fstat(fd, &status) == 0 && S_ISREG(status.st_mode) && status.st_size > 0)
+            {
+                void* data{ ::mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ, MAP_PRIVATE, fd, 0) };
+                if(data != MAP_FAILED)
+                {
+                    m_data = static_cast<const char*>(data);
+                    m_size = static_cast<std::size_t>(status.st_size);
+                    m_mapped = true;
+                    ::close(fd);
+                    return true;
+                }
+            }
+
+            bool ok{ readAll(fd) };
+            ::close(fd);
+
+            return ok;
+#else
+            std::ifstream file{ name, std::ios::binary | std::ios::ate };
+            if(!file)
+                return false;
+
+            m_size = static_cast<std::size_t>(file.tellg());
+            m_buffer = std::make_unique<char[]>(m_size > 0 ? m_size : 1);
+            file.seekg(0);
+            file.read(m_buffer.get(), static_cast<std::streamsize>(m_size));
+            m_data = m_buffer.get();
+
+            return static_cast<bool>(file) || m_size == 0;
+#endif
+        }
+
+        const std::string& name() const { return m_name; }
+        std::string_view contents() const { return { m_data, m_size }; }
+
+    private:
+#if defined(ARGUMENT_PARSER_HAS_MMAP)
+        // reads fd until its end into m_buffer, false if a read fails
+        bool readAll(int fd)
+        {
+            std::size_t capacity{ 4096 };
+            m_buffer = std::make_unique<char[]>(capacity);
+            m_size = 0;
+
+            while(true)
+            {
+                if(m_size == capacity)
+                {
+                    auto bigger{ std::make_unique<char[]>(capacity * 2) };
+                    std::copy(m_buffer.get(), m_buffer.get() + m_size, bigger.get());
+                    m_buffer = std::move(bigger);
+                    capacity *= 2;
+                }
+
+                ssize_t got{ ::read(fd, m_buffer.get() + m_size, capacity - m_size) };
+                if(got < 0 && errno == EINTR)
+                    continue;
+                if(got < 0)
+                {
+                    m_size = 0;
+                    return false;
+                }
+                if(got == 0)
+                    break;
+
+                m_size += static_cast<std::size_t>(got);
+            }
+
+            m_data = m_buffer.get();
+            return true;
+        }
+#endif
+
+        std::string m_name{};
+        const char* m_data{ nullptr };
+        std::size_t m_size{ 0 };
+        bool m_mapped{ false };
+        std::unique_ptr<char[]> m_buffer{};
+    };
+
+    constexpr int maxNesting{ 16 };
+    constexpr std::uint32_t noFile{ static_cast<std::uint32_t>(-1) };
+
+    inline bool isSpace(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+    }
+}
+
+class ArgumentList
+{
+public:
+    // the arguments of argv (and of the response files in it), false (and error filled in) if a file can't be read
+    bool load(int argc, char* argv[], ArgumentError& error)
+    {
+        m_arguments.clear();
+        m_files.clear();
+        m_arguments.reserve(static_cast<std::size_t>(argc > 0 ? argc : 0));
+
+        for(int index{ 0 }; index < argc; ++index)
+        {
+            std::string_view argument{ argv[index] ? argv[index] : "" };
+            if(!add(argument, index, argument_parser::noFile, 0, 0, error))
+                return false;
+        }
+
+        return true;
+    }
+
+    std::size_t size() const { return m_arguments.size(); }
+    std::string_view operator[](std::size_t index) const { return m_arguments[index].text; }
+
+    // the arguments from index first on as numbers, false (and error filled in) at the first one that isn't a T
+    template <typename T>
+    bool toNumbers(std::size_t first, std::vector<T>& numbers, ArgumentError& error) const
+    {
+        static_assert(std::is_arithmetic<T>::value, "toNumbers converts to numbers");
+
+        numbers.clear();
+        if(first >= m_arguments.size())
+            return true;
+
+        numbers.reserve(m_arguments.size() - first);
+        for(std::size_t index{ first }; index < m_arguments.size(); ++index)
+        {
+            std::string_view text{ m_arguments[index].text };
+
+            // std::from_chars doesn't take a +, std::stringstream does
+            const char* begin{ text.data() };
+            const char* end{ text.data() + text.size() };
+            if(text.size() > 1 && text[0] == '+' && text[1] != '-')
+                ++begin;
+
+            T value{};
+            std::from_chars_result result{ std::from_chars(begin, end, value) };
+            if(result.ec != std::errc{} || result.ptr != end)
+            {
+                fillError(m_arguments[index], result.ec == std::errc::result_out_of_range ? "out of range" : "not a number",
+                          error);
+                return false;
+            }
+
+            numbers.push_back(value);
+        }
+
+        return true;
+    }
+
+private:
+    struct Argument
+    {
+        std::string_view text;
+        int argvIndex;          // the argv entry it is, or that named its response file
+        std::uint32_t file;     // index into m_files, noFile for an argument straight from argv
+        std::size_t offset;     // where it starts in the file
+    };
+
+    bool add(std::string_view argument, int argvIndex, std::uint32_t file, std::size_t offset, int nesting,
+             ArgumentError& error)
+    {
+        if(argument.size() < 2 || argument[0] != '@')
+        {
+            m_arguments.push_back(Argument{ argument, argvIndex, file, offset });
+            return true;
+        }
+
+        if(nesting >= argument_parser::maxNesting)
+        {
+            fillError(Argument{ argument, argvIndex, file, offset }, "response files nested too deep", error);
+            return false;
+        }
+
+        argument_parser::MappedFile mapped{};
+        if(!mapped.open(std::string{ argument.substr(1) }))
+        {
+            fillError(Argument{ argument, argvIndex, file, offset }, "can't read the response file", error);
+            return false;
+        }
+
+        m_files.push_back(std::move(mapped));
+        const std::uint32_t fileIndex{ static_cast<std::uint32_t>(m_files.size() - 1) };
+
+        // the contents stay where they are when m_files grows, only the MappedFile objects move
+        const std::string_view contents{ m_files[fileIndex].contents() };
+
+        std::size_t position{ 0 };
+        while(position < contents.size())
+        {
+            while(position < contents.size() && argument_parser::isSpace(contents[position]))
+                ++position;
+
+            std::size_t start{ position };
+            while(position < contents.size() && !argument_parser::isSpace(contents[position]))
+                ++position;
+
+            if(position > start &&
+               !add(contents.substr(start, position - start), argvIndex, fileIndex, start, nesting + 1, error))
+                return false;
+        }
+
+        return true;
+    }
+
+    // the line and column are only worked out here, for the one argument that's wrong
+    void fillError(const Argument& argument, const char* message, ArgumentError& error) const
+    {
+        error = ArgumentError{};
+        error.argvIndex = argument.argvIndex;
+        error.text = std::string{ argument.text };
+        error.message = message;
+
+        if(argument.file != argument_parser::noFile)
+        {
+            const argument_parser::MappedFile& file{ m_files[argument.file] };
+            std::string_view before{ file.contents().substr(0, argument.offset) };
+
+            std::size_t lineStart{ before.rfind('\n') };
+            error.file = file.name();
+            error.line = 1;
+            for(char c : before)
+                error.line += (c == '\n');
+            error.column = argument.offset - (lineStart == std::string_view::npos ? 0 : lineStart + 1) + 1;
+        }
+    }
+
+    std::vector<Argument> m_arguments{};
+    std::vector<argument_parser::MappedFile> m_files{};
+};
+
+#endif
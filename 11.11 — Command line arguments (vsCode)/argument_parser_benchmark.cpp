@@ -0,0 +1,95 @@
+#include <iostream>
+#include <chrono> // for std::chrono::steady_clock
+#include <cstdio> // for std::remove
+#include <fstream> // for std::ofstream
+#include <sstream> // for std::stringstream
+#include <string>
+#include <vector>
+#include "argument_parser.h" // for ArgumentList, ArgumentError
+
+/*
+Compares a std::stringstream per argument (the way lesson 11.11 converts argv[1]) with ArgumentList, for 100'000
+numbers: once as argv entries, and once in a response file (written to argument_parser_benchmark.txt and removed
+again at the end).
+
+    g++ -std=c++17 -O2 argument_parser_benchmark.cpp -o argument_parser_benchmark
+*/
+
+template <typename Fcn>
+double timeIt(Fcn fcn)
+{
+    auto start{ std::chrono::steady_clock::now() };
+    fcn();
+    auto end{ std::chrono::steady_clock::now() };
+
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+// the conversion from the lesson, kept here as the baseline
+bool convertWithStringstream(int argc, char* argv[], std::vector<int>& numbers)
+{
+    numbers.clear();
+    for(int i{ 1 }; i < argc; ++i)
+    {
+        std::stringstream convert{ argv[i] };
+
+        int myint{};
+        if(!(convert >> myint))
+            return false;
+
+        numbers.push_back(myint);
+    }
+
+    return true;
+}
+
+int main()
+{
+    constexpr int count{ 100'000 };
+    const char* const fileName{ "argument_parser_benchmark.txt" };
+
+    // the arguments as a program would get them
+    std::vector<std::string> texts{ "argument_parser_benchmark" };
+    for(int i{ 0 }; i < count; ++i)
+        texts.push_back(std::to_string((i * 7919) % 2'000'000 - 1'000'000));
+
+    std::vector<char*> argv{};
+    for(std::string& text : texts)
+        argv.push_back(text.data());
+
+    {
+        std::ofstream file{ fileName };
+        for(std::size_t i{ 1 }; i < texts.size(); ++i)
+            file << texts[i] << (i % 10 == 0 ? '\n' : ' ');
+    }
+
+    std::string responseArgument{ std::string{ "@" } + fileName };
+    char* responseArgv[]{ argv[0], responseArgument.data() };
+
+    std::vector<int> expected{};
+    double streamMs{ timeIt([&]{ convertWithStringstream(count + 1, argv.data(), expected); }) };
+
+    std::vector<int> numbers{};
+    ArgumentError error{};
+    bool ok{ true };
+    double argvMs{ timeIt([&]{
+        ArgumentList arguments{};
+        ok = arguments.load(count + 1, argv.data(), error) && arguments.toNumbers(1, numbers, error);
+    }) };
+    bool sameArgv{ ok && numbers == expected };
+
+    double fileMs{ timeIt([&]{
+        ArgumentList arguments{};
+        ok = arguments.load(2, responseArgv, error) && arguments.toNumbers(1, numbers, error);
+    }) };
+    bool sameFile{ ok && numbers == expected };
+
+    std::remove(fileName);
+
+    std::cout << count << " numeric arguments\n";
+    std::cout << "std::stringstream each:       " << streamMs << " ms\n";
+    std::cout << "ArgumentList, argv:           " << argvMs << " ms" << (sameArgv ? "" : " (WRONG)") << '\n';
+    std::cout << "ArgumentList, response file:  " << fileMs << " ms" << (sameFile ? "" : " (WRONG)") << '\n';
+
+    return 0;
+}
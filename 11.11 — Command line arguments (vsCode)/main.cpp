@@ -1,4 +1,6 @@
 #include <iostream>
+#include <vector>
+#include "argument_parser.h" // for ArgumentList, ArgumentError
 
 int main(int argc, char* argv[])
 {
@@ -206,6 +208,26 @@ int main(int argc, char* argv[])
     We’ll talk more about std::stringstream in a future chapter.
     */
 
+    /*
+    For many numbers, a std::stringstream per argument gets slow. ArgumentList (see argument_parser.h) converts them with
+    std::from_chars instead, and also reads response files: running the program as "main @numbers.txt" passes the
+    numbers in numbers.txt as if they had been typed on the command line. When an argument isn't a number, the error
+    says which one it was (and where in the file, for one from a response file):
+    */
+    ArgumentList arguments{};
+    ArgumentError error{};
+    std::vector<double> numbers{};
+    if(arguments.load(argc, argv, error) && arguments.toNumbers(1, numbers, error))
+    {
+        double sum{ 0.0 };
+        for(double number : numbers)
+            sum += number;
+
+        std::cout << "Got " << numbers.size() << " numbers, their sum is " << sum << '\n';
+    }
+    else
+        std::cout << error.describe() << '\n';
+
 
     std::cout << std::endl;
     ////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,125 @@
+#ifndef FIND_AVERAGE_H
+#define FIND_AVERAGE_H
+
+#include <cstddef> // for std::size_t
+#include <type_traits> // for std::is_arithmetic, std::is_integral, std::is_floating_point
+#include <utility> // for std::index_sequence
+
+/*
+Type-safe replacements for the ellipsis versions of findAverage().
+
+typesafe::findAverage(1, 2, 3.5) is a variadic template: the compiler knows how many arguments there are and what type
+each one has, so there's no count, no sentinel and no va_arg guessing. It's constexpr, so with constant arguments the
+whole average is worked out at compile time.
+
+typesafe::findAverage(values, count) averages an array. It adds the values into 8 independent running sums, so the
+additions don't have to wait for each other and the compiler can put them into SIMD registers. Integers are summed
+as long long (no overflow), floating point values as double.
+
+typesafe::findAverage_decoded<'i', 'i', 'd'>(1, 2, 3.5) is findAverage_Method_3() with the decoder string checked by the
+compiler: there must be exactly one code per argument, 'i' takes an int and 'd' takes a double. Any mismatch is a compile
+error, and there's nothing left to decode at run time (no std::string, no loop, no switch). The decoder can also be a
+constexpr string: findAverage_decoded<decoder>(...), with static constexpr char decoder[]{ "iid" }.
+
+They live in namespace typesafe so that they don't take over the calls to the ellipsis findAverage(int count, ...)
+in main.cpp (a template would be a better match than the ellipsis for those calls, and quietly change their meaning).
+*/
+
+namespace typesafe
+{
+    // only takes part in overload resolution for numbers, so findAverage(pointer, count) picks the array version below
+    template <typename... Ts, typename = std::enable_if_t<(std::is_arithmetic<Ts>::value && ...)>>
+    constexpr double findAverage(Ts... args)
+    {
+        static_assert(sizeof...(Ts) > 0, "findAverage needs at least one value");
+
+        return (static_cast<double>(args) + ...) / sizeof...(Ts);
+    }
+
+    namespace decoder
+    {
+        // is argument type T what code asks for?
+        template <char Code, typename T>
+        constexpr bool matches()
+        {
+            static_assert(Code == 'i' || Code == 'd', "the decoder only knows 'i' (int) and 'd' (double)");
+
+            if(Code == 'i')
+                return std::is_integral<T>::value && sizeof(T) <= sizeof(int);
+            else
+                return std::is_floating_point<T>::value;
+        }
+
+        template <const char* Decoder>
+        constexpr std::size_t length()
+        {
+            std::size_t count{ 0 };
+            while(Decoder[count] != '\0')
+                ++count;
+
+            return count;
+        }
+    }
+
+    template <char... Codes, typename... Ts>
+    constexpr double findAverage_decoded(Ts... args)
+    {
+        static_assert(sizeof...(Codes) > 0, "the decoder string is empty");
+        static_assert(sizeof...(Codes) == sizeof...(Ts), "the decoder string needs exactly one code per argument");
+        static_assert((decoder::matches<Codes, Ts>() && ...), "an argument doesn't have the type its code asks for");
+
+        return (static_cast<double>(args) + ...) / sizeof...(Ts);
+    }
+
+    namespace decoder
+    {
+        template <const char* Decoder, std::size_t... Indices, typename... Ts>
+        constexpr double findAverage_expanded(std::index_sequence<Indices...>, Ts... args)
+        {
+            return findAverage_decoded<Decoder[Indices]...>(args...);
+        }
+    }
+
+    // same as above, with the codes given as a constexpr string
+    template <const char* Decoder, typename... Ts>
+    constexpr double findAverage_decoded(Ts... args)
+    {
+        return decoder::findAverage_expanded<Decoder>(std::make_index_sequence<decoder::length<Decoder>()>{}, args...);
+    }
+
+    template <typename T>
+    double findAverage(const T* values, std::size_t count)
+    {
+        static_assert(std::is_arithmetic<T>::value, "findAverage only averages numbers");
+
+        if(!values || count == 0)
+            return 0.0;
+
+        // integer sums are exact in a long long, the rest is added up as double
+        using Sum = std::conditional_t<std::is_integral<T>::value, long long, double>;
+
+        constexpr std::size_t accumulators{ 8 };
+        Sum sums[accumulators]{};
+
+        std::size_t i{ 0 };
+        for(; i + accumulators <= count; i += accumulators)
+        {
+            for(std::size_t lane{ 0 }; lane < accumulators; ++lane)
+                sums[lane] += static_cast<Sum>(values[i + lane]);
+        }
+
+        for(; i < count; ++i)
+            sums[0] += static_cast<Sum>(values[i]);
+
+        // add the running sums together pairwise
+        for(std::size_t width{ accumulators / 2 }; width > 0; width /= 2)
+        {
+            for(std::size_t lane{ 0 }; lane < width; ++lane)
+                sums[lane] += sums[lane + width];
+        }
+
+        return static_cast<double>(sums[0]) / static_cast<double>(count);
+    }
+}
+
+#endif
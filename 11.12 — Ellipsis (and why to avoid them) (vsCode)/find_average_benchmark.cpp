@@ -0,0 +1,153 @@
+#include <iostream>
+#include <cstdarg> // needed to use ellipsis
+#include <chrono> // for std::chrono::steady_clock
+#include <string>
+#include <vector>
+#include "find_average.h" // for typesafe::findAverage
+
+/*
+Compares the three ellipsis versions of findAverage() with typesafe::findAverage().
+Build with optimisations, e.g.:
+
+    g++ -std=c++17 -O2 find_average_benchmark.cpp -o find_average_benchmark
+*/
+
+// the three ellipsis versions from main.cpp, kept here as the baseline
+double findAverage(int count, ...)
+{
+    double sum{ 0 };
+
+    va_list list;
+    va_start(list, count);
+
+    for(int arg{ 0 }; arg < count; ++arg)
+        sum += va_arg(list, int);
+
+    va_end(list);
+
+    return sum / count;
+}
+
+double findAverage_Method_2(int first, ...)
+{
+    double sum{ static_cast<double>(first) };
+
+    va_list list;
+    va_start(list, first);
+
+    int count{ 1 };
+
+    while (true)
+    {
+        int arg{ va_arg(list, int) };
+
+        if(arg == -1)
+            break;
+
+        sum += arg;
+        ++count;
+    }
+
+    va_end(list);
+
+    return sum / count;
+}
+
+double findAverage_Method_3(std::string decoder, ...)
+{
+    double sum{ 0 };
+
+    va_list list;
+    va_start(list, decoder);
+
+    int count = 0;
+
+    while (true)
+    {
+        char codeType{ decoder[count] };
+
+        switch (codeType)
+        {
+        default:
+        case '\0':
+            va_end(list);
+            return sum / count;
+
+        case 'i':
+            sum += va_arg(list, int);
+            ++count;
+            break;
+        case 'd':
+            sum += va_arg(list, double);
+            ++count;
+            break;
+        }
+    }
+}
+
+// keeps the compiler from throwing away results we never look at
+volatile double g_sink{};
+
+// runs fcn repetitions times and returns the nanoseconds per call
+template <typename Fcn>
+double timeIt(int repetitions, Fcn fcn)
+{
+    auto start{ std::chrono::steady_clock::now() };
+    for(int i{ 0 }; i < repetitions; ++i)
+        fcn(i);
+    auto end{ std::chrono::steady_clock::now() };
+
+    return std::chrono::duration<double, std::nano>(end - start).count() / repetitions;
+}
+
+int main()
+{
+    constexpr int repetitions{ 10'000'000 };
+
+    // 6 values, the first one changes every call so the compiler can't fold everything away
+    std::cout << "6 arguments per call:\n";
+    std::cout << "  findAverage (count):          "
+              << timeIt(repetitions, [](int i){ g_sink = findAverage(6, i, 2, 3, 4, 5, 6); }) << " ns\n";
+    std::cout << "  findAverage_Method_2 (-1):    "
+              << timeIt(repetitions, [](int i){ g_sink = findAverage_Method_2(i & 0xFFFF, 2, 3, 4, 5, 6, -1); }) << " ns\n";
+    std::cout << "  findAverage_Method_3 (\"iii\"): "
+              << timeIt(repetitions, [](int i){ g_sink = findAverage_Method_3("iiiiii", i, 2, 3, 4, 5, 6); }) << " ns\n";
+    std::cout << "  findAverage_decoded<'i'...>:  "
+              << timeIt(repetitions, [](int i){ g_sink = typesafe::findAverage_decoded<'i', 'i', 'i', 'i', 'i', 'i'>(i, 2, 3, 4, 5, 6); })
+              << " ns\n";
+    std::cout << "  typesafe::findAverage:        "
+              << timeIt(repetitions, [](int i){ g_sink = typesafe::findAverage(i, 2, 3, 4, 5, 6); }) << " ns\n";
+
+    // large arrays
+    for(std::size_t size : { 1'000, 1'000'000, 100'000'000 })
+    {
+        std::vector<int> ints(size);
+        std::vector<double> doubles(size);
+        for(std::size_t i{ 0 }; i < size; ++i)
+        {
+            ints[i] = static_cast<int>(i % 1000);
+            doubles[i] = static_cast<double>(i % 1000) * 0.5;
+        }
+
+        int arrayRepetitions{ static_cast<int>(1'000'000'000 / size) };
+        if(arrayRepetitions > 100'000)
+            arrayRepetitions = 100'000;
+
+        // the simple one-accumulator loop, for comparison
+        double simple{ timeIt(arrayRepetitions, [&](int){
+            double sum{ 0 };
+            for(double value : doubles)
+                sum += value;
+            g_sink = sum / static_cast<double>(size);
+        }) };
+
+        double intNs{ timeIt(arrayRepetitions, [&](int){ g_sink = typesafe::findAverage(ints.data(), ints.size()); }) };
+        double doubleNs{ timeIt(arrayRepetitions, [&](int){ g_sink = typesafe::findAverage(doubles.data(), doubles.size()); }) };
+
+        std::cout << size << " values: simple loop (double) " << simple / static_cast<double>(size) << " ns/value, "
+                  << "findAverage(int array) " << intNs / static_cast<double>(size) << " ns/value, "
+                  << "findAverage(double array) " << doubleNs / static_cast<double>(size) << " ns/value\n";
+    }
+
+    return 0;
+}
@@ -1,6 +1,8 @@
 #include <iostream>
 #include <cstdarg> // needed to use ellipsis
 #include <string>
+#include <vector>
+#include "find_average.h" // for typesafe::findAverage
 
 // The ellipsis must be the last parameter count is how many additional arguments we're passing.
 double findAverage(int count, ...)
@@ -112,7 +114,7 @@ double findAverage_Method_3(std::string decoder, ...)
             ++count;
             break;
         case 'd':
-            sum += va_arg(list, int);
+            sum += va_arg(list, double);
             ++count;
             break;
         }
@@ -357,6 +359,17 @@ int main(int argc, char* argv[])
     For those of you coming from C, this is what printf does!
     */
 
+    /*
+    Note that 'd' has to be read with va_arg(list, double), reading a double as an int gives garbage.
+
+    The same decoder can be checked by the compiler instead (see find_average.h). A wrong code or a missing argument
+    is then a compile error, and nothing is decoded at run time:
+    */
+    std::cout << typesafe::findAverage_decoded<'i', 'i', 'd', 'd', 'i'>(1, 2, 3.5, 4.5, 5) << '\n';
+
+    static constexpr char decoder[]{ "iiddi" };
+    std::cout << typesafe::findAverage_decoded<decoder>(1, 2, 3.5, 4.5, 5) << '\n';
+
 
     std::cout << std::endl;
     ///////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -390,6 +403,22 @@ int main(int argc, char* argv[])
     We hope to introduce lessons on these topics in a future site update.
     */
 
+    /*
+    Here is what that looks like (see find_average.h). The number and the types of the arguments are checked by the
+    compiler, so the mistakes from above can't happen anymore, and with constant arguments the average is computed
+    at compile time:
+    */
+    std::cout << typesafe::findAverage(1, 2, 3, 4, 5) << '\n';
+    std::cout << typesafe::findAverage(1, 2, 3.5, 4.5, 5) << '\n';
+
+    static_assert(typesafe::findAverage(1, 2, 3, 4, 5, 6) == 3.5, "computed by the compiler");
+
+    /*
+    And the dynamically sized array mentioned above:
+    */
+    std::vector<int> values{ 1, 2, 3, 4, 5, 6 };
+    std::cout << typesafe::findAverage(values.data(), values.size()) << '\n';
+
 
 
 
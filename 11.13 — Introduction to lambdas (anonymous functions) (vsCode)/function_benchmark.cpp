@@ -0,0 +1,104 @@
+#include <iostream>
+#include <chrono> // for std::chrono::steady_clock
+#include <functional> // for std::function
+#include "function_ref.h" // for function_ref
+#include "small_function.h" // for small_function
+
+/*
+Compares the ways of passing a lambda to repeat(): a function pointer, a template, std::function, function_ref and
+small_function. Measures the cost per call inside repeat(), and the cost of passing a lambda with 40 bytes of captures
+(which is where std::function has to allocate).
+Build with optimisations, e.g.:
+
+    g++ -std=c++17 -O2 function_benchmark.cpp -o function_benchmark
+*/
+
+// keeps the compiler from throwing away results we never look at
+volatile long long g_sink{};
+long long g_total{};
+
+// the repeat() variants. noinline so that the compiler can't see which lambda they get (as with a separate .cpp file),
+// except for the template, which is the point of a template
+__attribute__((noinline)) void repeat_pointer(int repetitions, void (*fn)(int))
+{
+    for(int i{ 0 }; i < repetitions; ++i)
+        fn(i);
+}
+
+template <typename Fcn>
+void repeat_template(int repetitions, const Fcn& fn)
+{
+    for(int i{ 0 }; i < repetitions; ++i)
+        fn(i);
+}
+
+// repeat() as it was in main.cpp, kept here as the baseline
+__attribute__((noinline)) void repeat_function(int repetitions, const std::function<void(int)>& fn)
+{
+    for(int i{ 0 }; i < repetitions; ++i)
+        fn(i);
+}
+
+__attribute__((noinline)) void repeat_function_ref(int repetitions, function_ref<void(int)> fn)
+{
+    for(int i{ 0 }; i < repetitions; ++i)
+        fn(i);
+}
+
+__attribute__((noinline)) void repeat_small_function(int repetitions, const small_function<void(int), 64>& fn)
+{
+    for(int i{ 0 }; i < repetitions; ++i)
+        fn(i);
+}
+
+void addToTotal(int i)
+{
+    g_total += i;
+}
+
+// runs fcn repetitions times and returns the nanoseconds per run
+template <typename Fcn>
+double timeIt(long long repetitions, Fcn fcn)
+{
+    auto start{ std::chrono::steady_clock::now() };
+    for(long long i{ 0 }; i < repetitions; ++i)
+        fcn();
+    auto end{ std::chrono::steady_clock::now() };
+
+    return std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(repetitions);
+}
+
+int main()
+{
+    constexpr int calls{ 100'000'000 };
+
+    // calling through each of them, one repeat() with many calls
+    long long total{ 0 };
+    auto addTo{ [&total](int i){ total += i; } };
+
+    std::cout << "cost per call inside repeat():\n";
+    std::cout << "  function pointer: " << timeIt(1, []{ repeat_pointer(calls, addToTotal); }) / calls << " ns\n";
+    std::cout << "  template:         " << timeIt(1, [&]{ repeat_template(calls, addTo); }) / calls << " ns\n";
+    std::cout << "  std::function:    " << timeIt(1, [&]{ repeat_function(calls, addTo); }) / calls << " ns\n";
+    std::cout << "  function_ref:     " << timeIt(1, [&]{ repeat_function_ref(calls, addTo); }) / calls << " ns\n";
+    small_function<void(int), 64> storedAddTo{ addTo };
+    std::cout << "  small_function:   " << timeIt(1, [&]{ repeat_small_function(calls, storedAddTo); }) / calls << " ns\n";
+    g_sink = total + g_total;
+
+    // passing a lambda with 40 bytes of captures to a short repeat(), many times
+    constexpr long long passes{ 10'000'000 };
+    long long a{ 1 };
+    long long b{ 2 };
+    long long c{ 3 };
+    long long d{ 4 };
+    auto bigCapture{ [a, b, c, d, &total](int i){ total += a + b + c + d + i; } };
+
+    std::cout << "passing a lambda with " << sizeof(bigCapture) << " bytes of captures to repeat(4, ...):\n";
+    std::cout << "  template:         " << timeIt(passes, [&]{ repeat_template(4, bigCapture); }) << " ns\n";
+    std::cout << "  std::function:    " << timeIt(passes, [&]{ repeat_function(4, bigCapture); }) << " ns\n";
+    std::cout << "  function_ref:     " << timeIt(passes, [&]{ repeat_function_ref(4, bigCapture); }) << " ns\n";
+    std::cout << "  small_function:   " << timeIt(passes, [&]{ repeat_small_function(4, bigCapture); }) << " ns\n";
+    g_sink = total;
+
+    return 0;
+}
@@ -0,0 +1,74 @@
+#ifndef FUNCTION_REF_H
+#define FUNCTION_REF_H
+
+#include <memory> // for std::addressof
+#include <type_traits> // for std::enable_if_t, std::is_invocable_r, std::decay_t
+#include <utility> // for std::forward
+
+/*
+A non-owning reference to something callable: function_ref<void(int)> can refer to a regular function, a lambda
+(capturing or not) or anything else with a matching operator().
+
+std::function<void(int)> stores a copy of the lambda. If the captures don't fit into its small internal buffer, that
+copy goes on the heap, and every call goes through std::function's type erasure. function_ref only remembers where the
+callable is and how to call it (two pointers), so creating one never allocates and costs next to nothing.
+
+Because it doesn't own what it refers to, a function_ref must not outlive the callable. That makes it a good fit for
+function parameters like the fn of repeat(): the lambda the caller passes in lives until repeat() returns.
+Don't keep a function_ref to a temporary lambda in a variable, use auto (or small_function) for that.
+*/
+
+template <typename Signature>
+class function_ref;
+
+template <typename R, typename... Args>
+class function_ref<R(Args...)>
+{
+public:
+    // regular functions
+    function_ref(R (*fcn)(Args...)) noexcept
+        : m_call{ &callFunction }
+    {
+        m_callable.function = reinterpret_cast<void (*)()>(fcn);
+    }
+
+    // lambdas and other objects with an operator()
+    template <typename Fcn,
+              typename = std::enable_if_t<!std::is_same<std::decay_t<Fcn>, function_ref>::value &&
+                                          !std::is_pointer<std::decay_t<Fcn>>::value &&
+                                          std::is_invocable_r<R, Fcn&, Args...>::value>>
+    function_ref(Fcn&& fcn) noexcept
+        : m_call{ &callObject<std::remove_reference_t<Fcn>> }
+    {
+        m_callable.object = const_cast<void*>(static_cast<const void*>(std::addressof(fcn)));
+    }
+
+    R operator()(Args... args) const
+    {
+        return m_call(m_callable, std::forward<Args>(args)...);
+    }
+
+private:
+    // a function pointer can't be stored in a void*, so either one is kept
+    union Callable
+    {
+        void* object;
+        void (*function)();
+    };
+
+    static R callFunction(Callable callable, Args&&... args)
+    {
+        return reinterpret_cast<R (*)(Args...)>(callable.function)(std::forward<Args>(args)...);
+    }
+
+    template <typename Fcn>
+    static R callObject(Callable callable, Args&&... args)
+    {
+        return (*static_cast<Fcn*>(callable.object))(std::forward<Args>(args)...);
+    }
+
+    Callable m_callable{};
+    R (*m_call)(Callable, Args&&...){ nullptr };
+};
+
+#endif
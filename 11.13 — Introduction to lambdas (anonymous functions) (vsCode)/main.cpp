@@ -3,10 +3,13 @@
 #include <algorithm>
 #include <array>
 #include <functional>
+#include "function_ref.h" // for function_ref
+#include "small_function.h" // for small_function
+#include "parallel_for.h" // for parallel_repeat
 
 //functions prototypes:
 static bool containsNut(std::string_view str);
-void repeat(int repetitions, const std::function<void(int)>& fn);
+void repeat(int repetitions, function_ref<void(int)> fn);
 bool greater(int a, int b);
 
 int main()
@@ -211,6 +214,43 @@ int main()
     Use auto when initializing variables with lambdas, and std::function if you can’t initialize the variable with the lambda.
     */
 
+    /*
+    std::function has a price: it keeps a copy of the lambda (on the heap if the captures are bigger than its small internal
+    buffer) and each call goes through a layer of indirection. repeat() above takes a function_ref instead (see
+    function_ref.h), which only refers to the caller's lambda, so passing a capturing lambda costs no allocation.
+    When we do need to keep a lambda around, small_function (see small_function.h) owns it like std::function, but stores
+    captures of up to 32 bytes (or whatever size we ask for) inside itself.
+    */
+    int base{ 100 };
+    double scale{ 0.5 };
+    std::string_view label{ "scaled" };
+
+    // 32 bytes of captures: more than GCC's std::function keeps inline, fine for small_function<..., 64>
+    auto printScaled{ [base, scale, label](int i){
+        std::cout << label << ' ' << (base + i) * scale << '\n';
+    } };
+
+    small_function<void(int), 64> storedPrint{ printScaled };
+    std::cout << "small_function stored inline: " << std::boolalpha << storedPrint.isInline() << '\n';
+
+    repeat(3, printScaled);     // the lambda itself
+    repeat(3, storedPrint);     // a small_function
+    repeat(3, std::function<void(int)>{ printScaled }); // and a std::function all work
+
+    /*
+    repeat() calls fn for one index after the other. When the calls don't depend on each other, parallel_repeat()
+    (see parallel_for.h) takes the same lambdas and spreads the calls over all cores. Here, every call writes only
+    its own element, so they can safely run at the same time:
+    */
+    std::array<long long, 20> squares{};
+    parallel_repeat(static_cast<int>(squares.size()), [&squares](int i){
+        squares[static_cast<std::size_t>(i)] = static_cast<long long>(i) * i;
+    });
+
+    for(long long square : squares)
+        std::cout << square << ' ';
+    std::cout << '\n';
+
 
     std::cout << std::endl;
     ////////////////////////////////////////////////////////////////////////////////////////////
@@ -445,8 +485,9 @@ static bool containsNut(std::string_view str) // static means internal linkage i
   return (str.find("nut") != std::string_view::npos);
 }
 
-// We don't know what fn will be. std::function works with regular functions and lambdas.
-void repeat(int repetitions, const std::function<void(int)>& fn)
+// We don't know what fn will be. function_ref works with regular functions, lambdas, std::function and small_function,
+// and unlike a std::function parameter it never copies (or allocates) anything.
+void repeat(int repetitions, function_ref<void(int)> fn)
 {
     for(int i{ 0 }; i < repetitions; ++i)
     {
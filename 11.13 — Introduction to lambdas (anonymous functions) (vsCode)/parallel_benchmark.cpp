@@ -0,0 +1,100 @@
+#include <iostream>
+#include <algorithm> // for std::max
+#include <chrono> // for std::chrono::steady_clock
+#include <cmath> // for std::sqrt
+#include <thread>
+#include <vector>
+#include "function_ref.h" // for function_ref
+#include "parallel_for.h" // for parallel_repeat, ThreadPool
+
+/*
+Compares repeat() with parallel_repeat() on work where some indices cost far more than others, with 1, 2, 4, ...
+threads (up to the number of cores), and with the simple way of splitting the range into equal parts, one per thread.
+Build with optimisations, e.g.:
+
+    g++ -std=c++17 -O2 -pthread parallel_benchmark.cpp -o parallel_benchmark
+*/
+
+// repeat() from main.cpp, kept here as the baseline
+void repeat(int repetitions, function_ref<void(int)> fn)
+{
+    for(int i{ 0 }; i < repetitions; ++i)
+    {
+        fn(i);
+    }
+}
+
+// equal parts, one per thread: the last part gets the expensive indices and everyone else waits for it
+void repeat_static_split(int repetitions, function_ref<void(int)> fn, unsigned threadCount)
+{
+    std::vector<std::thread> threads{};
+    for(unsigned t{ 0 }; t < threadCount; ++t)
+    {
+        int begin{ static_cast<int>(static_cast<long long>(repetitions) * t / threadCount) };
+        int end{ static_cast<int>(static_cast<long long>(repetitions) * (t + 1) / threadCount) };
+        threads.emplace_back([=]{
+            for(int i{ begin }; i < end; ++i)
+                fn(i);
+        });
+    }
+
+    for(std::thread& thread : threads)
+        thread.join();
+}
+
+// the work for index i grows with i (and every 64th index is 20 times as expensive on top of that)
+double work(int i)
+{
+    int steps{ 10 + i / 256 };
+    if(i % 64 == 0)
+        steps *= 20;
+
+    double x{ 1.0 };
+    for(int step{ 0 }; step < steps; ++step)
+        x = std::sqrt(x + step);
+
+    return x;
+}
+
+template <typename Fcn>
+double timeIt(Fcn fcn)
+{
+    auto start{ std::chrono::steady_clock::now() };
+    fcn();
+    auto end{ std::chrono::steady_clock::now() };
+
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+int main()
+{
+    constexpr int repetitions{ 200'000 };
+    std::vector<double> results(repetitions);
+    auto fn{ [&results](int i){ results[static_cast<std::size_t>(i)] = work(i); } };
+
+    double serial{ timeIt([&]{ repeat(repetitions, fn); }) };
+    std::cout << "repeat: " << serial << " ms\n";
+
+    // 1, 2, 4, ... threads, and finally all cores
+    unsigned cores{ std::max(std::thread::hardware_concurrency(), 1u) };
+    std::vector<unsigned> threadCounts{};
+    for(unsigned threads{ 1 }; threads < cores; threads *= 2)
+        threadCounts.push_back(threads);
+    threadCounts.push_back(cores);
+
+    for(unsigned threads : threadCounts)
+    {
+        // the calling thread works along, so the pool gets one thread less
+        ThreadPool pool{ threads - 1 };
+        ParallelOptions options{};
+        options.pool = &pool;
+
+        double stealing{ timeIt([&]{ parallel_repeat(repetitions, fn, options); }) };
+        double split{ timeIt([&]{ repeat_static_split(repetitions, fn, threads); }) };
+
+        std::cout << threads << " thread(s): parallel_repeat " << stealing << " ms (speedup " << serial / stealing
+                  << "), equal parts " << split << " ms (speedup " << serial / split << ")\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,345 @@
+#ifndef PARALLEL_FOR_H
+#define PARALLEL_FOR_H
+
+#include <algorithm> // for std::min, std::max
+#include <atomic>
+#include <condition_variable>
+#include <cstddef> // for std::size_t
+#include <deque>
+#include <exception> // for std::exception_ptr
+#include <memory> // for std::unique_ptr
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "function_ref.h" // for function_ref
+
+/*
+Parallel versions of repeat(): parallel_repeat(repetitions, fn) calls fn(0) ... fn(repetitions - 1) like repeat() does,
+but spread over all cores. parallel_for(begin, end, fn) does the same for fn(begin) ... fn(end - 1).
+fn takes the same function_ref<void(int)> as repeat(), so any lambda that works with repeat() can be passed as is, as
+long as the calls don't depend on each other (they run at the same time, in no particular order).
+
+How the work is spread:
+  - there is one set of threads (ThreadPool::instance()) that's created on first use and kept until the program ends,
+  - each thread has its own queue of ranges. A range is worked on grainSize indices at a time from the front; whenever
+    the thread's own queue is empty it splits the back half of its range off into the queue for others to take,
+  - a thread that runs out of work takes (steals) the oldest, and so biggest, range from another thread's queue.
+    So when some indices take much longer than others, the threads that finish early just take over part of the
+    remaining work, and ranges are only cut up as far as needed to keep everyone busy,
+  - the calling thread works along until the whole range is done, so parallel_for() can be used from inside fn too.
+
+ParallelOptions:
+  - grainSize: how many indices are done between checks for splitting and cancellation. 0 picks one from the size of
+    the range and the number of threads. Use 1 when a single call does a lot of work,
+  - cancel: when the pointed to flag becomes true, indices that haven't started yet are skipped,
+  - pool: the ThreadPool to run on (nullptr is ThreadPool::instance()).
+If fn throws, the remaining indices are skipped too and the (first) exception is rethrown by parallel_for() once the
+calls that were already running have finished.
+
+parallel_for() returns false if indices were skipped because of cancel.
+*/
+
+class ThreadPool;
+
+struct ParallelOptions
+{
+    int grainSize{ 0 };
+    const std::atomic<bool>* cancel{ nullptr };
+    ThreadPool* pool{ nullptr };
+};
+
+class ThreadPool
+{
+public:
+    // threadCount threads are started, the thread calling parallel_for() works along as well
+    explicit ThreadPool(unsigned threadCount)
+    {
+        for(unsigned i{ 0 }; i < threadCount; ++i)
+            m_queues.push_back(std::make_unique<WorkQueue>());
+
+        for(unsigned i{ 0 }; i < threadCount; ++i)
+            m_threads.emplace_back([this, i]{ workerLoop(static_cast<int>(i)); });
+    }
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock{ m_sleepMutex };
+            m_stopping = true;
+        }
+        m_wake.notify_all();
+
+        for(std::thread& thread : m_threads)
+            thread.join();
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // one thread per core, minus the one calling parallel_for()
+    static ThreadPool& instance()
+    {
+        static ThreadPool pool{ std::max(std::thread::hardware_concurrency(), 1u) - 1 };
+        return pool;
+    }
+
+    unsigned threadCount() const { return static_cast<unsigned>(m_threads.size()); }
+
+    bool parallelFor(int begin, int end, function_ref<void(int)> fn, const ParallelOptions& options)
+    {
+        if(begin >= end)
+            return true;
+
+        long long size{ static_cast<long long>(end) - begin };
+
+        int grainSize{ options.grainSize };
+        if(grainSize <= 0)
+        {
+            // small enough that every thread gets several pieces, big enough that the checks don't matter
+            long long pieces{ static_cast<long long>(threadCount() + 1) * 32 };
+            grainSize = static_cast<int>(std::min<long long>(std::max<long long>(size / pieces, 1), 4096));
+        }
+
+        Job job{ fn, grainSize, options.cancel };
+        job.remaining.store(size, std::memory_order_relaxed);
+
+        int self{ workerIndex() };
+        push(self, Task{ &job, begin, end });
+
+        // help out until every index of this job is done (or skipped)
+        while(job.remaining.load(std::memory_order_acquire) > 0)
+        {
+            Task task{};
+            if(findTask(self, task))
+                run(self, task);
+            else
+                std::this_thread::yield();
+        }
+
+        if(job.error)
+            std::rethrow_exception(job.error);
+
+        return !job.skipped.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct Job
+    {
+        Job(function_ref<void(int)> jobFn, int jobGrainSize, const std::atomic<bool>* jobCancel)
+            : fn{ jobFn }, grainSize{ jobGrainSize }, cancel{ jobCancel }
+        {
+        }
+
+        bool shouldStop() const
+        {
+            return failed.load(std::memory_order_relaxed) || (cancel && cancel->load(std::memory_order_relaxed));
+        }
+
+        function_ref<void(int)> fn;
+        int grainSize;
+        const std::atomic<bool>* cancel;
+
+        std::atomic<long long> remaining{ 0 }; // indices not done (or skipped) yet
+        std::atomic<bool> failed{ false };
+        std::exception_ptr error{};            // written once, by whoever sets failed first
+        std::atomic<bool> skipped{ false };    // indices were skipped because of cancel
+    };
+
+    struct Task
+    {
+        Job* job{ nullptr };
+        int begin{ 0 };
+        int end{ 0 };
+    };
+
+    // on its own cache line, so that threads checking each other's queues don't slow the owner down
+    struct alignas(64) WorkQueue
+    {
+        std::mutex mutex{};
+        std::deque<Task> tasks{};
+        std::atomic<std::size_t> size{ 0 };
+    };
+
+    // which pool (if any) the calling thread works for, and which queue is its own
+    struct WorkerIdentity
+    {
+        const ThreadPool* pool{ nullptr };
+        int index{ -1 };
+    };
+
+    static WorkerIdentity& thisThread()
+    {
+        thread_local WorkerIdentity identity{};
+        return identity;
+    }
+
+    // index of the calling thread's queue in this pool, or -1 for threads that aren't part of it
+    int workerIndex() const
+    {
+        const WorkerIdentity& identity{ thisThread() };
+        return identity.pool == this ? identity.index : -1;
+    }
+
+    // threads outside the pool share one extra queue
+    WorkQueue& queueOf(int worker)
+    {
+        return worker >= 0 ? *m_queues[static_cast<std::size_t>(worker)] : m_outsideQueue;
+    }
+
+    void push(int self, const Task& task)
+    {
+        WorkQueue& queue{ queueOf(self) };
+        {
+            std::lock_guard<std::mutex> lock{ queue.mutex };
+            queue.tasks.push_back(task);
+            queue.size.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        m_queued.fetch_add(1);
+        if(m_sleeping.load() > 0)
+        {
+            std::lock_guard<std::mutex> lock{ m_sleepMutex };
+            m_wake.notify_one();
+        }
+    }
+
+    // newest from the back for the owner, oldest from the front for everyone else
+    bool take(WorkQueue& queue, Task& task, bool owner)
+    {
+        if(queue.size.load(std::memory_order_relaxed) == 0)
+            return false;
+
+        std::lock_guard<std::mutex> lock{ queue.mutex };
+        if(queue.tasks.empty())
+            return false;
+
+        if(owner)
+        {
+            task = queue.tasks.back();
+            queue.tasks.pop_back();
+        }
+        else
+        {
+            task = queue.tasks.front();
+            queue.tasks.pop_front();
+        }
+        queue.size.fetch_sub(1, std::memory_order_relaxed);
+        m_queued.fetch_sub(1);
+
+        return true;
+    }
+
+    bool findTask(int self, Task& task)
+    {
+        if(take(queueOf(self), task, true))
+            return true;
+
+        if(self >= 0 && take(m_outsideQueue, task, false))
+            return true;
+
+        // steal, starting with the next thread along so that not everybody goes after the same one
+        std::size_t count{ m_queues.size() };
+        std::size_t start{ self >= 0 ? static_cast<std::size_t>(self) + 1 : 0 };
+        for(std::size_t i{ 0 }; i < count; ++i)
+        {
+            std::size_t victim{ (start + i) % count };
+            if(static_cast<int>(victim) != self && take(*m_queues[victim], task, false))
+                return true;
+        }
+
+        return false;
+    }
+
+    void run(int self, Task task)
+    {
+        Job& job{ *task.job };
+        WorkQueue& ownQueue{ queueOf(self) };
+        long long done{ 0 };
+
+        int begin{ task.begin };
+        int end{ task.end };
+        while(begin < end)
+        {
+            if(job.shouldStop())
+            {
+                if(!job.failed.load(std::memory_order_relaxed))
+                    job.skipped.store(true, std::memory_order_relaxed);
+                done += static_cast<long long>(end) - begin;
+                break;
+            }
+
+            // nothing left in our queue for others to steal: give them the back half
+            if(static_cast<long long>(end) - begin >= 2LL * job.grainSize && !m_threads.empty() &&
+               ownQueue.size.load(std::memory_order_relaxed) == 0)
+            {
+                int middle{ begin + (end - begin) / 2 };
+                push(self, Task{ &job, middle, end });
+                end = middle;
+            }
+
+            int chunkEnd{ begin + std::min(job.grainSize, end - begin) };
+            try
+            {
+                for(int i{ begin }; i < chunkEnd; ++i)
+                    job.fn(i);
+            }
+            catch(...)
+            {
+                if(!job.failed.exchange(true))
+                    job.error = std::current_exception();
+            }
+
+            done += chunkEnd - begin;
+            begin = chunkEnd;
+        }
+
+        // once remaining gets to 0 the caller returns and the job is gone, so this has to be the last use of it
+        job.remaining.fetch_sub(done, std::memory_order_acq_rel);
+    }
+
+    void workerLoop(int index)
+    {
+        thisThread() = WorkerIdentity{ this, index };
+
+        while(true)
+        {
+            Task task{};
+            if(findTask(index, task))
+            {
+                run(index, task);
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock{ m_sleepMutex };
+            m_sleeping.fetch_add(1);
+            m_wake.wait(lock, [this]{ return m_stopping || m_queued.load() > 0; });
+            m_sleeping.fetch_sub(1);
+
+            if(m_stopping)
+                return;
+        }
+    }
+
+    std::vector<std::unique_ptr<WorkQueue>> m_queues{};
+    WorkQueue m_outsideQueue{};
+    std::vector<std::thread> m_threads{};
+
+    std::atomic<long long> m_queued{ 0 };  // ranges waiting in any of the queues
+    std::atomic<int> m_sleeping{ 0 };      // threads waiting for m_wake
+    std::mutex m_sleepMutex{};
+    std::condition_variable m_wake{};
+    bool m_stopping{ false };
+};
+
+inline bool parallel_for(int begin, int end, function_ref<void(int)> fn, const ParallelOptions& options = {})
+{
+    ThreadPool& pool{ options.pool ? *options.pool : ThreadPool::instance() };
+    return pool.parallelFor(begin, end, fn, options);
+}
+
+inline bool parallel_repeat(int repetitions, function_ref<void(int)> fn, const ParallelOptions& options = {})
+{
+    return parallel_for(0, repetitions, fn, options);
+}
+
+#endif
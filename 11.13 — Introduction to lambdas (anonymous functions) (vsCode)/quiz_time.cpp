@@ -4,6 +4,12 @@
 #include <string>
 #include <string_view>
 #include <algorithm> // for std::max_element, std::sort
+#include <cstdio> // for std::remove
+#include <numeric> // for std::iota
+#include <vector>
+#include "student_table.h" // for StudentTable
+#include "radix_sort.h" // for sortByKey
+#include "record_file.h" // for RecordWriter, RecordFile, RecordLayout
 
 struct Student
 {
@@ -22,6 +28,47 @@ struct Season
   double averageTemperature{};
 };
 
+// how Student and Season are stored in a record file (see record_file.h)
+template <>
+struct RecordLayout<Student>
+{
+    static constexpr const char* name{ "Student" };
+    static constexpr auto fields()
+    {
+        return std::make_tuple(record_file::field("name", &Student::name), record_file::field("point", &Student::point));
+    }
+};
+
+template <>
+struct RecordLayout<Season>
+{
+    static constexpr const char* name{ "Season" };
+    static constexpr auto fields()
+    {
+        return std::make_tuple(record_file::field("name", &Season::name),
+                               record_file::field("averageTemperature", &Season::averageTemperature));
+    }
+};
+
+// writes records to a record file, false (and a message) if that didn't work
+template <typename Record, typename Records>
+static bool writeRecords(const std::string& path, const Records& records)
+{
+    RecordWriter<Record> writer{};
+    std::string error{};
+    bool ok{ writer.open(path, error) };
+    if(ok)
+    {
+        for(const Record& record : records)
+            writer.add(record);
+        ok = writer.finish(error);
+    }
+
+    if(!ok)
+        std::cout << "Can't write " << path << ": " << error << '\n';
+    return ok;
+}
+
 int main()
 {
     std::cout << std::endl;
@@ -72,6 +119,42 @@ int main()
 
     std::cout << max->name << " is the best student\n";
 
+    /*
+    The same question with the students stored by column (see student_table.h): the points are next to each other in
+    one array, so finding the best student only has to read ints, and the names are looked up for the answer only.
+    */
+    StudentTable table_Q1{};
+    for(const Student& student : arr_Q1)
+        table_Q1.add(student.name, student.point);
+
+    std::cout << table_Q1.name(table_Q1.bestStudent()) << " is the best student\n";
+
+    std::cout << "The top 3 are:";
+    for(StudentTable::RowId row : table_Q1.topStudents(3))
+        std::cout << ' ' << table_Q1.name(row) << " (" << table_Q1.point(row) << ')';
+    std::cout << '\n';
+
+    /*
+    And with the students in a file (see record_file.h): the file is mapped into memory and the points column is an
+    array of ints in it, so the same lambda runs over the file without loading the students first.
+    */
+    if(writeRecords<Student>("students.records", arr_Q1))
+    {
+        RecordFile<Student> students{};
+        std::string error{};
+        if(students.open("students.records", error))
+        {
+            ColumnView<int> points{ students.column(&Student::point) };
+            StringColumnView names{ students.column(&Student::name) };
+            const auto best{ std::max_element(points.begin(), points.end(), [](int a, int b) { return (a < b); }) };
+
+            std::cout << names[static_cast<std::size_t>(best - points.begin())] << " is the best student\n";
+        }
+        else
+            std::cout << error << '\n';
+    }
+    std::remove("students.records");
+
 
     /*
     Question #2
@@ -95,6 +178,54 @@ int main()
         std::cout << season.name << '\n';
     }
 
+    /*
+    For lots of records, sortByKey() (see radix_sort.h) gives the same order without comparing records at all: it takes
+    a lambda that returns the key of a record instead of one that compares two records, and does a radix sort on the
+    keys (with all cores). Records with equal keys keep their order, like with std::stable_sort.
+    */
+    std::array<Season, 4> seasons2{
+        { { "Spring", 285.0 },
+        { "Summer", 296.0 },
+        { "Fall", 288.0 },
+        { "Winter", 263.0 } }
+    };
+
+    sortByKey(seasons2.data(), seasons2.size(), [](const Season& season) { return season.averageTemperature; });
+
+    for (const auto& season : seasons2)
+    {
+        std::cout << season.name << '\n';
+    }
+
+    /*
+    The file is mapped read only, so the seasons in it can't be moved around: sorting gives the order of the rows
+    instead, a lambda comparing the temperatures of two rows.
+    */
+    if(writeRecords<Season>("seasons.records", seasons2))
+    {
+        RecordFile<Season> seasonFile{};
+        std::string error{};
+        if(seasonFile.open("seasons.records", error))
+        {
+            ColumnView<double> temperatures{ seasonFile.column(&Season::averageTemperature) };
+            StringColumnView names{ seasonFile.column(&Season::name) };
+
+            std::vector<std::size_t> order(seasonFile.size());
+            std::iota(order.begin(), order.end(), std::size_t{ 0 });
+            std::sort(order.begin(),
+                      order.end(),
+                      [&](std::size_t a, std::size_t b) { return (temperatures[a] < temperatures[b]); });
+
+            for (std::size_t row : order)
+            {
+                std::cout << names[row] << '\n';
+            }
+        }
+        else
+            std::cout << error << '\n';
+    }
+    std::remove("seasons.records");
+
 
     return 0;
 }
\ No newline at end of file
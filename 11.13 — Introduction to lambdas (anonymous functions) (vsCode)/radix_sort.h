@@ -0,0 +1,275 @@
+#ifndef RADIX_SORT_H
+#define RADIX_SORT_H
+
+#include <algorithm> // for std::min
+#include <array>
+#include <cstddef> // for std::size_t
+#include <cstdint> // for std::uint64_t, std::uint32_t
+#include <cstring> // for std::memcpy
+#include <memory> // for std::allocator
+#include <new> // for placement new
+#include <type_traits> // for std::is_nothrow_move_constructible
+#include <utility> // for std::move, std::swap
+#include <vector>
+#include "parallel_for.h" // for parallel_repeat, ThreadPool
+
+/*
+Sorting records by a floating point key without comparing them.
+
+sortByKey(records, count, key) sorts the records so that key(record) goes up, where key is a lambda like
+    [](const Season& season) { return season.averageTemperature; }
+The result is the same as std::stable_sort with the lambda
+    [](const Season& a, const Season& b) { return (a.averageTemperature < b.averageTemperature); }
+so records with equal keys keep their order. sortedIndicesByKey() leaves the records alone and returns the indices of
+the records in sorted order instead.
+
+How:
+  - every key is turned into a 64 bit unsigned integer that sorts in the same order as the double: positive numbers
+    get their sign bit set, negative numbers have all their bits flipped (so that a bigger magnitude comes first),
+  - those integers are sorted along with the index of their record by an LSD radix sort: 8 passes, each of which
+    puts the (key, index) pairs into 256 buckets by one byte of the key, least significant byte first. A pass keeps the
+    order of pairs within a bucket, so after the last pass the pairs are sorted by the whole key, ties in index order.
+    Passes where all keys have the same byte (the top bytes, when all keys are similar) are skipped,
+  - the array is split into one part per thread (parallel_repeat()). Each thread counts its part's bytes, the counts
+    give every thread its own place in every bucket, and the threads then move their pairs at the same time,
+  - sortByKey() finally moves the records into the sorted order.
+
+Special values: -0.0 and 0.0 compare equal with <, so they get the same key and stay in their original order.
+NaNs can't be sorted with < at all (std::sort with them is undefined behaviour), so here they are defined to go after
+everything else (after +infinity), in their original order.
+
+Records have to be movable without throwing (Season, with a string_view and a double, is).
+*/
+
+namespace radix_sort
+{
+    constexpr int passes{ 8 };
+    constexpr std::size_t buckets{ 256 };
+
+    // below this many records one thread does it all, starting threads would take longer than the sort
+    constexpr std::size_t recordsPerThread{ 1 << 16 };
+
+    // an unsigned integer that sorts like value does with <
+    inline std::uint64_t orderedKey(double value)
+    {
+        constexpr std::uint64_t signBit{ 1ull << 63 };
+
+        if(value != value)
+            return ~0ull; // NaN, after everything else
+
+        if(value == 0.0)
+            value = 0.0; // -0.0 becomes 0.0
+
+        std::uint64_t bits{};
+        std::memcpy(&bits, &value, sizeof(bits));
+
+        return (bits & signBit) ? ~bits : (bits | signBit);
+    }
+
+    using Histogram = std::array<std::array<std::size_t, buckets>, passes>;
+
+    inline unsigned digit(std::uint64_t key, int pass)
+    {
+        return static_cast<unsigned>(key >> (pass * 8)) & 0xFF;
+    }
+
+    // runs fcn(part) for parts 0 ... parts - 1, on the thread pool if there's more than one
+    template <typename Fcn>
+    void forEachPart(unsigned parts, const Fcn& fcn)
+    {
+        if(parts == 1)
+        {
+            fcn(0);
+            return;
+        }
+
+        ParallelOptions options{};
+        options.grainSize = 1;
+        parallel_repeat(static_cast<int>(parts), fcn, options);
+    }
+
+    inline std::size_t partBegin(std::size_t count, unsigned parts, unsigned part)
+    {
+        return static_cast<std::size_t>(static_cast<unsigned long long>(count) * part / parts);
+    }
+
+    inline unsigned partCount(std::size_t count, unsigned threadCount)
+    {
+        if(threadCount == 0)
+            threadCount = ThreadPool::instance().threadCount() + 1;
+
+        std::size_t most{ count / recordsPerThread };
+        return most < 1 ? 1u : static_cast<unsigned>(std::min<std::size_t>(threadCount, most));
+    }
+
+    // sorts keys (and indices along with them) with the LSD radix sort, the result ends up in keys and indices again
+    template <typename Index>
+    void sortPairs(std::vector<std::uint64_t>& keys, std::vector<Index>& indices, const Histogram& total, unsigned parts)
+    {
+        const std::size_t count{ keys.size() };
+        std::vector<std::uint64_t> keysOut(count);
+        std::vector<Index> indicesOut(count);
+        std::vector<std::array<std::size_t, buckets>> positions(parts);
+
+        for(int pass{ 0 }; pass < passes; ++pass)
+        {
+            // all keys in one bucket: this pass wouldn't change anything
+            if(total[static_cast<std::size_t>(pass)][digit(keys[0], pass)] == count)
+                continue;
+
+            // with one part, the counts are the totals (moving the keys around doesn't change how many there are)
+            if(parts == 1)
+                positions[0] = total[static_cast<std::size_t>(pass)];
+            else
+            {
+                forEachPart(parts, [&](int part){
+                    std::array<std::size_t, buckets>& counts{ positions[static_cast<std::size_t>(part)] };
+                    counts.fill(0);
+
+                    std::size_t end{ partBegin(count, parts, static_cast<unsigned>(part) + 1) };
+                    for(std::size_t i{ partBegin(count, parts, static_cast<unsigned>(part)) }; i < end; ++i)
+                        ++counts[digit(keys[i], pass)];
+                });
+            }
+
+            // bucket by bucket, and within a bucket part by part, so that equal bytes keep their order
+            std::size_t offset{ 0 };
+            for(std::size_t bucket{ 0 }; bucket < buckets; ++bucket)
+            {
+                for(unsigned part{ 0 }; part < parts; ++part)
+                {
+                    std::size_t size{ positions[part][bucket] };
+                    positions[part][bucket] = offset;
+                    offset += size;
+                }
+            }
+
+            forEachPart(parts, [&](int part){
+                // local copies, so that the compiler knows the stores below don't change them
+                std::array<std::size_t, buckets> next{ positions[static_cast<std::size_t>(part)] };
+                const std::uint64_t* keysIn{ keys.data() };
+                const Index* indicesIn{ indices.data() };
+                std::uint64_t* keysTo{ keysOut.data() };
+                Index* indicesTo{ indicesOut.data() };
+
+                std::size_t end{ partBegin(count, parts, static_cast<unsigned>(part) + 1) };
+                for(std::size_t i{ partBegin(count, parts, static_cast<unsigned>(part)) }; i < end; ++i)
+                {
+                    std::uint64_t key{ keysIn[i] };
+                    std::size_t position{ next[digit(key, pass)]++ };
+                    keysTo[position] = key;
+                    indicesTo[position] = indicesIn[i];
+                }
+            });
+
+            keys.swap(keysOut);
+            indices.swap(indicesOut);
+        }
+    }
+
+    // the sorted order of the records, as indices of type Index
+    template <typename Index, typename T, typename KeyFcn>
+    std::vector<Index> sortedIndices(const T* records, std::size_t count, const KeyFcn& key, unsigned parts)
+    {
+        std::vector<std::uint64_t> keys(count);
+        std::vector<Index> indices(count);
+        std::vector<Histogram> histograms(parts);
+
+        // the keys, and how often each byte value shows up in each byte of them
+        forEachPart(parts, [&](int part){
+            Histogram& histogram{ histograms[static_cast<std::size_t>(part)] };
+            for(auto& counts : histogram)
+                counts.fill(0);
+
+            std::size_t end{ partBegin(count, parts, static_cast<unsigned>(part) + 1) };
+            for(std::size_t i{ partBegin(count, parts, static_cast<unsigned>(part)) }; i < end; ++i)
+            {
+                keys[i] = orderedKey(static_cast<double>(key(records[i])));
+                indices[i] = static_cast<Index>(i);
+
+                for(int pass{ 0 }; pass < passes; ++pass)
+                    ++histogram[static_cast<std::size_t>(pass)][digit(keys[i], pass)];
+            }
+        });
+
+        Histogram total{};
+        for(const Histogram& histogram : histograms)
+        {
+            for(std::size_t pass{ 0 }; pass < total.size(); ++pass)
+            {
+                for(std::size_t bucket{ 0 }; bucket < buckets; ++bucket)
+                    total[pass][bucket] += histogram[pass][bucket];
+            }
+        }
+
+        sortPairs(keys, indices, total, parts);
+
+        return indices;
+    }
+
+    // moves the records into the order given by indices
+    template <typename Index, typename T>
+    void permute(T* records, const std::vector<Index>& indices, unsigned parts)
+    {
+        const std::size_t count{ indices.size() };
+
+        std::allocator<T> allocator{};
+        T* sorted{ allocator.allocate(count) };
+
+        forEachPart(parts, [&](int part){
+            std::size_t end{ partBegin(count, parts, static_cast<unsigned>(part) + 1) };
+            for(std::size_t i{ partBegin(count, parts, static_cast<unsigned>(part)) }; i < end; ++i)
+                ::new(static_cast<void*>(sorted + i)) T(std::move(records[indices[i]]));
+        });
+
+        forEachPart(parts, [&](int part){
+            std::size_t end{ partBegin(count, parts, static_cast<unsigned>(part) + 1) };
+            for(std::size_t i{ partBegin(count, parts, static_cast<unsigned>(part)) }; i < end; ++i)
+            {
+                records[i] = std::move(sorted[i]);
+                sorted[i].~T();
+            }
+        });
+
+        allocator.deallocate(sorted, count);
+    }
+}
+
+// indices of the records, sorted by key (threadCount 0 uses all cores)
+template <typename T, typename KeyFcn>
+std::vector<std::size_t> sortedIndicesByKey(const T* records, std::size_t count, KeyFcn key, unsigned threadCount = 0)
+{
+    if(count == 0)
+        return {};
+
+    unsigned parts{ radix_sort::partCount(count, threadCount) };
+
+    if(count <= UINT32_MAX)
+    {
+        // half the memory to move around
+        std::vector<std::uint32_t> indices{ radix_sort::sortedIndices<std::uint32_t>(records, count, key, parts) };
+        return std::vector<std::size_t>(indices.begin(), indices.end());
+    }
+
+    return radix_sort::sortedIndices<std::size_t>(records, count, key, parts);
+}
+
+// sorts the records by key, records with equal keys keep their order (threadCount 0 uses all cores)
+template <typename T, typename KeyFcn>
+void sortByKey(T* records, std::size_t count, KeyFcn key, unsigned threadCount = 0)
+{
+    static_assert(std::is_nothrow_move_constructible<T>::value && std::is_nothrow_move_assignable<T>::value,
+                  "sortByKey moves the records around, that must not throw");
+
+    if(count < 2)
+        return;
+
+    unsigned parts{ radix_sort::partCount(count, threadCount) };
+
+    if(count <= UINT32_MAX)
+        radix_sort::permute(records, radix_sort::sortedIndices<std::uint32_t>(records, count, key, parts), parts);
+    else
+        radix_sort::permute(records, radix_sort::sortedIndices<std::size_t>(records, count, key, parts), parts);
+}
+
+#endif
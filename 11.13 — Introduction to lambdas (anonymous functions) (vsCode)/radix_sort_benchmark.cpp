@@ -0,0 +1,88 @@
+#include <iostream>
+#include <algorithm> // for std::sort, std::stable_sort
+#include <chrono> // for std::chrono::steady_clock
+#include <cstdlib> // for std::atoi
+#include <random> // for std::mt19937_64
+#include <string_view>
+#include <vector>
+#include "radix_sort.h" // for sortByKey, sortedIndicesByKey
+
+/*
+Compares std::sort and std::stable_sort with the lambda from quiz_time.cpp against sortByKey() and
+sortedIndicesByKey(), on Season records with random temperatures.
+argv[1] is the number of records in millions (10 if not given).
+Build with optimisations, e.g.:
+
+    g++ -std=c++17 -O2 -pthread radix_sort_benchmark.cpp -o radix_sort_benchmark
+*/
+
+// the Season struct from quiz_time.cpp, kept here as the baseline
+struct Season
+{
+  std::string_view name{};
+  double averageTemperature{};
+};
+
+template <typename Fcn>
+double timeIt(Fcn fcn)
+{
+    auto start{ std::chrono::steady_clock::now() };
+    fcn();
+    auto end{ std::chrono::steady_clock::now() };
+
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+int main(int argc, char* argv[])
+{
+    int millions{ argc > 1 ? std::atoi(argv[1]) : 10 };
+    if(millions < 1)
+        millions = 1;
+
+    const std::size_t count{ static_cast<std::size_t>(millions) * 1'000'000 };
+
+    // temperatures in Kelvin with 0.01 steps, so that there are plenty of ties
+    std::mt19937_64 mt{ 14 };
+    std::uniform_int_distribution<int> hundredths{ 20'000, 32'000 };
+    constexpr std::string_view names[]{ "Spring", "Summer", "Fall", "Winter" };
+
+    std::vector<Season> original(count);
+    for(std::size_t i{ 0 }; i < count; ++i)
+        original[i] = Season{ names[i % 4], hundredths(mt) / 100.0 };
+
+    auto byTemperature{ [](const Season& a, const Season& b) { return (a.averageTemperature < b.averageTemperature); } };
+    auto temperature{ [](const Season& season) { return season.averageTemperature; } };
+
+    std::vector<Season> sorted{ original };
+    double sortMs{ timeIt([&]{ std::sort(sorted.begin(), sorted.end(), byTemperature); }) };
+
+    std::vector<Season> stable{ original };
+    double stableMs{ timeIt([&]{ std::stable_sort(stable.begin(), stable.end(), byTemperature); }) };
+
+    std::vector<Season> radix{ original };
+    double radixMs{ timeIt([&]{ sortByKey(radix.data(), radix.size(), temperature); }) };
+
+    std::vector<std::size_t> indices{};
+    double indicesMs{ timeIt([&]{ indices = sortedIndicesByKey(original.data(), original.size(), temperature); }) };
+
+    // same order as std::stable_sort, names included
+    bool same{ true };
+    for(std::size_t i{ 0 }; i < count; ++i)
+    {
+        if(radix[i].averageTemperature != stable[i].averageTemperature || radix[i].name != stable[i].name ||
+           original[indices[i]].name != stable[i].name)
+        {
+            same = false;
+            break;
+        }
+    }
+
+    std::cout << count << " seasons:\n";
+    std::cout << "  std::sort:          " << sortMs << " ms\n";
+    std::cout << "  std::stable_sort:   " << stableMs << " ms\n";
+    std::cout << "  sortByKey:          " << radixMs << " ms\n";
+    std::cout << "  sortedIndicesByKey: " << indicesMs << " ms\n";
+    std::cout << "  same order as std::stable_sort: " << (same ? "yes" : "NO") << '\n';
+
+    return 0;
+}
@@ -0,0 +1,857 @@
+#ifndef RECORD_FILE_H
+#define RECORD_FILE_H
+
+#include <cstddef> // for std::size_t
+#include <cstdint> // for std::uint32_t, std::uint64_t, std::int32_t, std::int64_t
+#include <cstdio> // for std::FILE, std::fopen, std::fwrite, std::fread, std::rename, std::remove
+#include <cstring> // for std::memcmp, std::memcpy, std::strncmp
+#include <memory> // for std::unique_ptr
+#include <string>
+#include <string_view>
+#include <tuple> // for std::tuple_size, std::get, std::apply
+#include <type_traits> // for std::is_same, std::remove_cv_t, std::decay_t
+#include <utility> // for std::index_sequence, std::exchange
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h> // for open
+#include <sys/mman.h> // for mmap, munmap, madvise
+#include <sys/stat.h> // for fstat
+#include <unistd.h> // for close
+#define RECORD_FILE_HAS_MMAP 1
+#endif
+
+/*
+Arrays of records (Student, Season, Employee, ...) in a file, instead of initializer lists in the code, for datasets
+far too big to build with push_back every time the program starts.
+
+A record type is described once, by its name and its members:
+
+    template <>
+    struct RecordLayout<Student>
+    {
+        static constexpr const char* name{ "Student" };
+        static constexpr auto fields()
+        {
+            return std::make_tuple(record_file::field("name", &Student::name), record_file::field("point", &Student::point));
+        }
+    };
+
+Members can be int, long long, double, std::string or std::string_view.
+
+RecordWriter<Student> writes the file while the records come in; memory use doesn't depend on how many there are. Every
+column is collected in a file of its own next to the output (path.partN), 1 MB at a time, and finish() puts them
+together and renames the result to path, so the file is either complete or not there at all:
+
+    RecordWriter<Student> writer{};
+    std::string error{};
+    writer.open("students.records", error);
+    writer.add({ "Albert", 3 });
+    ...
+    writer.finish(error);
+
+RecordFile<Student> maps the file into memory. It doesn't read it, so opening takes as long for a billion records as for
+ten: only the header and the column table are looked at, and the pages come in when they're used. Every column is
+available as an array, without copying:
+
+    RecordFile<Student> students{};
+    students.open("students.records", error);
+    ColumnView<int> points{ students.column(&Student::point) };         // const int*, begin(), end(), [row]
+    StringColumnView names{ students.column(&Student::name) };          // names[row] is a std::string_view
+    auto best{ std::max_element(points.begin(), points.end(), [](int a, int b) { return a < b; }) };
+    Student record{ students[2] };                                      // a whole record (strings are copied)
+
+The file is little endian and has a fixed layout, version 1:
+  - a 96-byte FileHeader: "C11RECS", the version, a byte order mark, the record count, its record type's name, and the
+    offsets and sizes of the rest,
+  - a column table, a ColumnEntry (name, type, element size, offset, size) per member,
+  - the columns, each one starting at a multiple of 64 bytes: count ints, long longs or doubles, or for a string
+    column count + 1 offsets into its strings (row i is from offset i to offset i + 1),
+  - the string heap: the strings of each string column back to back, one column after the other (where a column's
+    strings are is in its ColumnEntry too).
+open() checks that all of that fits in the file, and that the table and the columns are aligned. It finds the columns by
+name (and type), so a file that has more columns than the layout, in any order, still opens; one that's missing a column
+doesn't. A string offset that is out of range gives a shorter (or empty) string, never a read outside the file.
+
+RecordFileOptions make the kernel prepare the mapping (they're hints, a system that can't do them ignores them):
+  - hugePages: madvise(MADV_HUGEPAGE) for 2 MB pages, one TLB entry instead of 512 (on file mappings it needs a file
+    system or kernel that support it),
+  - willNeed: madvise(MADV_WILLNEED), start reading the whole file in the background,
+  - sequential: madvise(MADV_SEQUENTIAL), read far ahead and drop pages behind, for one pass over the data.
+Without mmap, the whole file is read into memory by open().
+*/
+
+// specialised for every record type that goes into a file, see above
+template <typename Record>
+struct RecordLayout;
+
+namespace record_file
+{
+    enum ColumnType : std::uint32_t
+    {
+        int32Column = 1,
+        int64Column = 2,
+        float64Column = 3,
+        stringColumn = 4,
+    };
+
+    constexpr char magic[8]{ 'C', '1', '1', 'R', 'E', 'C', 'S', '\0' };
+    constexpr std::uint32_t currentVersion{ 1 };
+    constexpr std::uint32_t byteOrderMark{ 0x01020304 };
+    constexpr std::uint64_t alignment{ 64 };
+    constexpr std::size_t nameSize{ 32 };
+
+    struct FileHeader
+    {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t byteOrder;            // byteOrderMark as written by the machine that wrote the file
+        std::uint64_t recordCount;
+        std::uint64_t columnTableOffset;
+        std::uint32_t columnCount;
+        std::uint32_t headerSize;           // sizeof(FileHeader) of the writer, later versions may add to it
+        std::uint64_t heapOffset;
+        std::uint64_t heapSize;
+        std::uint64_t fileSize;
+        char recordName[nameSize];
+    };
+
+    struct ColumnEntry
+    {
+        char name[nameSize];
+        std::uint32_t type;
+        std::uint32_t elementSize;
+        std::uint64_t offset;
+        std::uint64_t size;                 // in bytes
+        std::uint64_t stringsOffset;        // a string column's strings (in the heap), 0 for other columns
+        std::uint64_t stringsSize;
+    };
+
+    static_assert(sizeof(FileHeader) == 96 && sizeof(ColumnEntry) == 72, "the file layout is fixed");
+    static_assert(sizeof(int) == 4 && sizeof(long long) == 8 && sizeof(double) == 8, "columns are stored as is");
+
+    template <typename Record, typename Member>
+    struct Field
+    {
+        const char* name;
+        Member Record::* member;
+    };
+
+    template <typename Record, typename Member>
+    constexpr Field<Record, Member> field(const char* name, Member Record::* member)
+    {
+        return { name, member };
+    }
+
+    // the member type of a Field
+    template <typename F>
+    struct MemberOf;
+
+    template <typename Record, typename Member>
+    struct MemberOf<Field<Record, Member>>
+    {
+        using type = Member;
+    };
+
+    // how a member type is stored (no specialisation: a member type that can't go into a file)
+    template <typename Member>
+    struct ColumnTraits;
+
+    template <>
+    struct ColumnTraits<int>
+    {
+        static constexpr ColumnType type{ int32Column };
+        static constexpr std::uint32_t elementSize{ 4 };
+    };
+
+    template <>
+    struct ColumnTraits<long long>
+    {
+        static constexpr ColumnType type{ int64Column };
+        static constexpr std::uint32_t elementSize{ 8 };
+    };
+
+    template <>
+    struct ColumnTraits<double>
+    {
+        static constexpr ColumnType type{ float64Column };
+        static constexpr std::uint32_t elementSize{ 8 };
+    };
+
+    // the offsets into the column's strings
+    template <>
+    struct ColumnTraits<std::string>
+    {
+        static constexpr ColumnType type{ stringColumn };
+        static constexpr std::uint32_t elementSize{ 8 };
+    };
+
+    template <>
+    struct ColumnTraits<std::string_view> : ColumnTraits<std::string>
+    {
+    };
+
+    inline std::uint64_t alignUp(std::uint64_t offset)
+    {
+        return (offset + alignment - 1) / alignment * alignment;
+    }
+
+    inline void copyName(char (&to)[nameSize], const char* from)
+    {
+        std::size_t length{ 0 };
+        for(; from[length] != '\0' && length + 1 < nameSize; ++length)
+            to[length] = from[length];
+        for(; length < nameSize; ++length)
+            to[length] = '\0';
+    }
+
+    inline bool nameIs(const char (&name)[nameSize], const char* wanted)
+    {
+        return std::strncmp(name, wanted, nameSize) == 0 && name[nameSize - 1] == '\0';
+    }
+
+    // calls fcn(field, index) for every field of Record's layout
+    template <typename Record, typename Fcn>
+    void forEachField(Fcn&& fcn)
+    {
+        std::size_t index{ 0 };
+        std::apply([&](const auto&... fields) { (fcn(fields, index++), ...); }, RecordLayout<Record>::fields());
+    }
+
+    // the whole file, mapped (or read, without mmap)
+    class MappedFile
+    {
+    public:
+        MappedFile() = default;
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        ~MappedFile()
+        {
+            close();
+        }
+
+        // false (and error filled in) if the file can't be opened
+        bool open(const std::string& path, bool hugePages, bool willNeed, bool sequential, std::string& error)
+        {
+            close();
+
+#if defined(RECORD_FILE_HAS_MMAP)
+            int fd{ ::open(path.c_str(), O_RDONLY) };
+            if(fd < 0)
+            {
+                error = "can't open " + path;
+                return false;
+            }
+
+            struct stat status{};
+            bool ok{ ::fstat(fd, &status) == 0 && status.st_size > 0 };
+            if(ok)
+            {
+                void* data{ ::mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ, MAP_PRIVATE, fd, 0) };
+                if(data == MAP_FAILED)
+                    ok = false;
+                else
+                {
+                    m_data = static_cast<const char*>(data);
+                    m_size = static_cast<std::size_t>(status.st_size);
+                    m_mapped = true;
+                    advise(hugePages, willNeed, sequential);
+                }
+            }
+            ::close(fd);
+
+            if(!ok)
+                error = "can't map " + path;
+            return ok;
+#else
+            static_cast<void>(hugePages);
+            static_cast<void>(willNeed);
+            static_cast<void>(sequential);
+
+            std::FILE* file{ std::fopen(path.c_str(), "rb") };
+            if(!file)
+            {
+                error = "can't open " + path;
+                return false;
+            }
+
+            // 8-byte elements, so that every column is aligned
+            std::vector<std::uint64_t> buffer{};
+            std::uint64_t chunk[8192];
+            std::size_t got{};
+            while((got = std::fread(chunk, 1, sizeof(chunk), file)) > 0)
+            {
+                std::size_t before{ m_size };
+                m_size += got;
+                buffer.resize((m_size + 7) / 8);
+                std::memcpy(reinterpret_cast<char*>(buffer.data()) + before, chunk, got);
+            }
+            bool ok{ !std::ferror(file) };
+            std::fclose(file);
+
+            m_buffer = std::move(buffer);
+            m_data = reinterpret_cast<const char*>(m_buffer.data());
+            if(!ok)
+                error = "can't read " + path;
+            return ok;
+#endif
+        }
+
+        const char* data() const { return m_data; }
+        std::size_t size() const { return m_size; }
+
+    private:
+        void advise(bool hugePages, bool willNeed, bool sequential)
+        {
+#if defined(RECORD_FILE_HAS_MMAP)
+            void* data{ const_cast<char*>(m_data) };
+#if defined(MADV_HUGEPAGE)
+            if(hugePages)
+                ::madvise(data, m_size, MADV_HUGEPAGE);
+#else
+            static_cast<void>(hugePages);
+#endif
+            if(willNeed)
+                ::madvise(data, m_size, MADV_WILLNEED);
+            if(sequential)
+                ::madvise(data, m_size, MADV_SEQUENTIAL);
+#endif
+        }
+
+        void close()
+        {
+#if defined(RECORD_FILE_HAS_MMAP)
+            if(m_mapped && m_data)
+                ::munmap(const_cast<char*>(m_data), m_size);
+#endif
+            m_data = nullptr;
+            m_size = 0;
+            m_mapped = false;
+            m_buffer.clear();
+        }
+
+        const char* m_data{ nullptr };
+        std::size_t m_size{ 0 };
+        bool m_mapped{ false };
+        std::vector<std::uint64_t> m_buffer{};
+    };
+
+    // a column on its way to the file: collected in a file of its own, a buffer at a time
+    class Spill
+    {
+    public:
+        static constexpr std::size_t bufferSize{ 1 << 20 };
+
+        Spill() = default;
+
+        Spill(const Spill&) = delete;
+        Spill& operator=(const Spill&) = delete;
+
+        ~Spill()
+        {
+            discard();
+        }
+
+        bool open(const std::string& path)
+        {
+            m_path = path;
+            m_file = std::fopen(path.c_str(), "w+b");
+            m_buffer.reserve(bufferSize);
+            m_bytes = 0;
+            m_failed = m_file == nullptr;
+
+            return !m_failed;
+        }
+
+        void write(const void* data, std::size_t size)
+        {
+            if(m_buffer.size() + size > bufferSize)
+                flush();
+
+            const char* bytes{ static_cast<const char*>(data) };
+            if(size > bufferSize)
+                m_failed = m_failed || std::fwrite(bytes, 1, size, m_file) != size;
+            else
+                m_buffer.insert(m_buffer.end(), bytes, bytes + size);
+
+            m_bytes += size;
+        }
+
+        std::uint64_t bytes() const { return m_bytes; }
+        bool failed() const { return m_failed; }
+
+        // appends everything that was written to out, false if something went wrong on the way
+        bool copyTo(std::FILE* out)
+        {
+            flush();
+            if(m_failed || std::fseek(m_file, 0, SEEK_SET) != 0)
+                return false;
+
+            std::vector<char> chunk(bufferSize);
+            std::size_t got{};
+            while((got = std::fread(chunk.data(), 1, chunk.size(), m_file)) > 0)
+            {
+                if(std::fwrite(chunk.data(), 1, got, out) != got)
+                    return false;
+            }
+
+            return !std::ferror(m_file);
+        }
+
+        void discard()
+        {
+            if(m_file)
+            {
+                std::fclose(m_file);
+                std::remove(m_path.c_str());
+                m_file = nullptr;
+            }
+        }
+
+    private:
+        void flush()
+        {
+            if(!m_buffer.empty() && m_file)
+                m_failed = m_failed || std::fwrite(m_buffer.data(), 1, m_buffer.size(), m_file) != m_buffer.size();
+            m_buffer.clear();
+        }
+
+        std::string m_path{};
+        std::FILE* m_file{ nullptr };
+        std::vector<char> m_buffer{};
+        std::uint64_t m_bytes{ 0 };
+        bool m_failed{ false };
+    };
+
+    inline bool writePadding(std::FILE* out, std::uint64_t& position, std::uint64_t to)
+    {
+        static const char zeros[alignment]{};
+        const std::size_t padding{ static_cast<std::size_t>(to - position) };
+        position = to;
+
+        return padding == 0 || std::fwrite(zeros, 1, padding, out) == padding;
+    }
+}
+
+// a column of numbers, straight from the file
+template <typename T>
+class ColumnView
+{
+public:
+    ColumnView() = default;
+
+    ColumnView(const T* data, std::size_t size)
+        : m_data{ data }, m_size{ size }
+    {
+    }
+
+    const T* begin() const { return m_data; }
+    const T* end() const { return m_data + m_size; }
+    const T* data() const { return m_data; }
+    std::size_t size() const { return m_size; }
+    const T& operator[](std::size_t row) const { return m_data[row]; }
+
+private:
+    const T* m_data{ nullptr };
+    std::size_t m_size{ 0 };
+};
+
+// a column of strings, views into the file
+class StringColumnView
+{
+public:
+    StringColumnView() = default;
+
+    StringColumnView(const std::uint64_t* offsets, std::size_t size, const char* strings, std::uint64_t stringsSize)
+        : m_offsets{ offsets }, m_size{ size }, m_strings{ strings }, m_stringsSize{ stringsSize }
+    {
+    }
+
+    std::size_t size() const { return m_size; }
+
+    std::string_view operator[](std::size_t row) const
+    {
+        std::uint64_t end{ m_offsets[row + 1] < m_stringsSize ? m_offsets[row + 1] : m_stringsSize };
+        std::uint64_t begin{ m_offsets[row] < end ? m_offsets[row] : end };
+
+        return { m_strings + begin, static_cast<std::size_t>(end - begin) };
+    }
+
+private:
+    const std::uint64_t* m_offsets{ nullptr };
+    std::size_t m_size{ 0 };
+    const char* m_strings{ "" };
+    std::uint64_t m_stringsSize{ 0 };
+};
+
+struct RecordFileOptions
+{
+    bool hugePages{ false };
+    bool willNeed{ false };
+    bool sequential{ false };
+};
+
+template <typename Record>
+class RecordFile
+{
+public:
+    static constexpr std::size_t fieldCount{ std::tuple_size<decltype(RecordLayout<Record>::fields())>::value };
+
+    // false (and error filled in) if path can't be mapped or isn't a valid file of Records
+    bool open(const std::string& path, std::string& error, const RecordFileOptions& options = {})
+    {
+        using namespace record_file;
+
+        m_count = 0;
+        if(!m_file.open(path, options.hugePages, options.willNeed, options.sequential, error))
+            return false;
+
+        const char* data{ m_file.data() };
+        const std::uint64_t size{ m_file.size() };
+
+        FileHeader header{};
+        if(size < sizeof(header))
+            return fail(path, "too small for a record file", error);
+        std::memcpy(&header, data, sizeof(header));
+
+        if(std::memcmp(header.magic, magic, sizeof(magic)) != 0)
+            return fail(path, "not a record file", error);
+        if(header.byteOrder != byteOrderMark)
+            return fail(path, "written with the other byte order", error);
+        if(header.version != currentVersion)
+            return fail(path, "version " + std::to_string(header.version) + ", this program reads version " +
+                              std::to_string(currentVersion), error);
+        if(header.fileSize != size || header.headerSize < sizeof(header))
+            return fail(path, "cut off or damaged", error);
+        if(!nameIs(header.recordName, RecordLayout<Record>::name))
+            return fail(path, std::string{ "has no " } + RecordLayout<Record>::name + " records", error);
+
+        const std::uint64_t tableSize{ static_cast<std::uint64_t>(header.columnCount) * sizeof(ColumnEntry) };
+        if(!fits(header.columnTableOffset, tableSize, size) || !fits(header.heapOffset, header.heapSize, size) ||
+           header.columnTableOffset % alignof(ColumnEntry) != 0)
+            return fail(path, "cut off or damaged", error);
+
+        const std::uint64_t count{ header.recordCount };
+        bool found{ true };
+        std::string problem{};
+        forEachField<Record>([&](const auto& field, std::size_t index) {
+            using Member = typename record_file::MemberOf<std::decay_t<decltype(field)>>::type;
+            using Traits = ColumnTraits<Member>;
+
+            if(!found)
+                return;
+
+            const ColumnEntry* entry{ findColumn(data + header.columnTableOffset, header.columnCount, field.name) };
+            const std::uint64_t rows{ Traits::type == stringColumn ? count + 1 : count };
+            if(!entry || entry->type != Traits::type || entry->elementSize != Traits::elementSize)
+                problem = std::string{ "has no column \"" } + field.name + "\" of the right type";
+            else if(rows > size / Traits::elementSize || entry->size != rows * Traits::elementSize ||
+                    entry->offset % Traits::elementSize != 0 || !fits(entry->offset, entry->size, size) ||
+                    !fits(entry->stringsOffset, entry->stringsSize, size))
+                problem = std::string{ "column \"" } + field.name + "\" is cut off or damaged";
+            else
+            {
+                m_columns[index] = data + entry->offset;
+                m_strings[index] = data + entry->stringsOffset;
+                m_stringsSizes[index] = entry->stringsSize;
+                return;
+            }
+
+            found = false;
+        });
+        if(!found)
+            return fail(path, problem, error);
+
+        m_count = static_cast<std::size_t>(count);
+
+        return true;
+    }
+
+    std::size_t size() const { return m_count; }
+
+    // the column of member: a ColumnView of it, or a StringColumnView for a string member (an empty view for a
+    // member that isn't in RecordLayout<Record>)
+    template <typename Member>
+    auto column(Member Record::* member) const
+    {
+        using Traits = record_file::ColumnTraits<std::remove_cv_t<Member>>;
+
+        const std::size_t index{ indexOf(member) };
+        if constexpr(Traits::type == record_file::stringColumn)
+        {
+            if(index == fieldCount)
+                return StringColumnView{};
+
+            return strings(index);
+        }
+        else
+        {
+            if(index == fieldCount)
+                return ColumnView<Member>{};
+
+            return ColumnView<Member>{ reinterpret_cast<const Member*>(m_columns[index]), m_count };
+        }
+    }
+
+    // the whole record of row (the strings are copied for std::string members, views into the file otherwise)
+    Record operator[](std::size_t row) const
+    {
+        Record record{};
+        record_file::forEachField<Record>([&](const auto& field, std::size_t index) {
+            using Member = typename record_file::MemberOf<std::decay_t<decltype(field)>>::type;
+
+            if constexpr(record_file::ColumnTraits<Member>::type == record_file::stringColumn)
+            {
+                record.*field.member = Member{ strings(index)[row] };
+            }
+            else
+                std::memcpy(&(record.*field.member), m_columns[index] + row * sizeof(Member), sizeof(Member));
+        });
+
+        return record;
+    }
+
+private:
+    static bool fail(const std::string& path, const std::string& message, std::string& error)
+    {
+        error = path + ": " + message;
+        return false;
+    }
+
+    StringColumnView strings(std::size_t index) const
+    {
+        return { reinterpret_cast<const std::uint64_t*>(m_columns[index]), m_count, m_strings[index],
+                 m_stringsSizes[index] };
+    }
+
+    // offset + size bytes within a file of fileSize bytes, without overflowing
+    static bool fits(std::uint64_t offset, std::uint64_t size, std::uint64_t fileSize)
+    {
+        return offset <= fileSize && size <= fileSize - offset;
+    }
+
+    static const record_file::ColumnEntry* findColumn(const char* table, std::uint32_t count, const char* name)
+    {
+        for(std::uint32_t index{ 0 }; index < count; ++index)
+        {
+            const auto* entry{ reinterpret_cast<const record_file::ColumnEntry*>(table) + index };
+            if(record_file::nameIs(entry->name, name))
+                return entry;
+        }
+
+        return nullptr;
+    }
+
+    template <typename Member>
+    static std::size_t indexOf(Member Record::* member)
+    {
+        std::size_t found{ fieldCount };
+        record_file::forEachField<Record>([&](const auto& field, std::size_t index) {
+            if constexpr(std::is_same<decltype(field.member), Member Record::*>::value)
+            {
+                if(field.member == member && found == fieldCount)
+                    found = index;
+            }
+        });
+
+        return found;
+    }
+
+    record_file::MappedFile m_file{};
+    std::size_t m_count{ 0 };
+    const char* m_columns[fieldCount]{};
+    const char* m_strings[fieldCount]{};            // for string columns
+    std::uint64_t m_stringsSizes[fieldCount]{};
+};
+
+template <typename Record>
+class RecordWriter
+{
+public:
+    static constexpr std::size_t fieldCount{ RecordFile<Record>::fieldCount };
+
+    RecordWriter() = default;
+
+    RecordWriter(const RecordWriter&) = delete;
+    RecordWriter& operator=(const RecordWriter&) = delete;
+
+    // false (and error filled in) if the files next to path can't be created
+    bool open(const std::string& path, std::string& error)
+    {
+        m_path = path;
+        m_count = 0;
+
+        // a file for every column, and one more for the strings of every string column
+        bool opened{ true };
+        std::string name{};
+        record_file::forEachField<Record>([&](const auto& field, std::size_t index) {
+            using Member = typename record_file::MemberOf<std::decay_t<decltype(field)>>::type;
+
+            if(opened && !m_columns[index].open(path + ".part" + std::to_string(index)))
+            {
+                name = path + ".part" + std::to_string(index);
+                opened = false;
+            }
+
+            if constexpr(record_file::ColumnTraits<Member>::type == record_file::stringColumn)
+            {
+                if(opened && !m_strings[index].open(path + ".part" + std::to_string(fieldCount + index)))
+                {
+                    name = path + ".part" + std::to_string(fieldCount + index);
+                    opened = false;
+                }
+
+                // the first string starts at 0
+                const std::uint64_t start{ 0 };
+                m_columns[index].write(&start, sizeof(start));
+            }
+        });
+        if(!opened)
+        {
+            discard();
+            return fail("can't create " + name, error);
+        }
+
+        m_open = true;
+        return true;
+    }
+
+    // (a failed write shows up in finish())
+    void add(const Record& record)
+    {
+        record_file::forEachField<Record>([&](const auto& field, std::size_t index) {
+            using Member = typename record_file::MemberOf<std::decay_t<decltype(field)>>::type;
+
+            const Member& value{ record.*field.member };
+            if constexpr(record_file::ColumnTraits<Member>::type == record_file::stringColumn)
+            {
+                m_strings[index].write(value.data(), value.size());
+                const std::uint64_t end{ m_strings[index].bytes() };
+                m_columns[index].write(&end, sizeof(end));
+            }
+            else
+                m_columns[index].write(&value, sizeof(value));
+        });
+
+        ++m_count;
+    }
+
+    std::uint64_t size() const { return m_count; }
+
+    // writes path, false (and error filled in) if that didn't work (then there's no file at path)
+    bool finish(std::string& error)
+    {
+        using namespace record_file;
+
+        if(!m_open)
+            return fail("not open", error);
+        m_open = false;
+
+        // where everything goes
+        FileHeader header{};
+        std::memcpy(header.magic, magic, sizeof(magic));
+        header.version = currentVersion;
+        header.byteOrder = byteOrderMark;
+        header.recordCount = m_count;
+        header.columnTableOffset = alignUp(sizeof(FileHeader));
+        header.columnCount = static_cast<std::uint32_t>(fieldCount);
+        header.headerSize = sizeof(FileHeader);
+        copyName(header.recordName, RecordLayout<Record>::name);
+
+        ColumnEntry entries[fieldCount]{};
+        std::uint64_t offset{ header.columnTableOffset + fieldCount * sizeof(ColumnEntry) };
+        forEachField<Record>([&](const auto& field, std::size_t index) {
+            using Member = typename record_file::MemberOf<std::decay_t<decltype(field)>>::type;
+
+            ColumnEntry& entry{ entries[index] };
+            copyName(entry.name, field.name);
+            entry.type = ColumnTraits<Member>::type;
+            entry.elementSize = ColumnTraits<Member>::elementSize;
+            entry.offset = alignUp(offset);
+            entry.size = m_columns[index].bytes();
+            offset = entry.offset + entry.size;
+        });
+
+        header.heapOffset = alignUp(offset);
+        offset = header.heapOffset;
+        forEachField<Record>([&](const auto& field, std::size_t index) {
+            using Member = typename record_file::MemberOf<std::decay_t<decltype(field)>>::type;
+
+            if constexpr(ColumnTraits<Member>::type == stringColumn)
+            {
+                entries[index].stringsOffset = offset;
+                entries[index].stringsSize = m_strings[index].bytes();
+                offset += entries[index].stringsSize;
+            }
+        });
+        header.heapSize = offset - header.heapOffset;
+        header.fileSize = offset;
+
+        const std::string partial{ m_path + ".part" };
+        std::FILE* out{ std::fopen(partial.c_str(), "wb") };
+        if(!out)
+            return fail("can't create " + partial, error);
+
+        std::uint64_t position{ 0 };
+        bool ok{ std::fwrite(&header, sizeof(header), 1, out) == 1 };
+        position += sizeof(header);
+        ok = ok && writePadding(out, position, header.columnTableOffset);
+        ok = ok && std::fwrite(entries, sizeof(ColumnEntry), fieldCount, out) == fieldCount;
+        position += fieldCount * sizeof(ColumnEntry);
+
+        for(std::size_t index{ 0 }; index < fieldCount && ok; ++index)
+        {
+            ok = writePadding(out, position, entries[index].offset) && m_columns[index].copyTo(out);
+            position += entries[index].size;
+        }
+        ok = ok && writePadding(out, position, header.heapOffset);
+        for(std::size_t index{ 0 }; index < fieldCount && ok; ++index)
+        {
+            if(entries[index].type == stringColumn)
+                ok = m_strings[index].copyTo(out);
+        }
+        ok = (std::fclose(out) == 0) && ok;
+        discard();
+
+        // the old file (if any) is replaced only by a complete new one (rename() replaces it in one step on POSIX,
+        // elsewhere it may refuse to while it exists)
+        if(ok && std::rename(partial.c_str(), m_path.c_str()) != 0)
+        {
+            std::remove(m_path.c_str());
+            ok = std::rename(partial.c_str(), m_path.c_str()) == 0;
+        }
+        if(!ok)
+        {
+            std::remove(partial.c_str());
+            return fail("can't write " + m_path, error);
+        }
+
+        return true;
+    }
+
+private:
+    static bool fail(const std::string& message, std::string& error)
+    {
+        error = message;
+        return false;
+    }
+
+    void discard()
+    {
+        for(std::size_t index{ 0 }; index < fieldCount; ++index)
+        {
+            m_columns[index].discard();
+            m_strings[index].discard();
+        }
+    }
+
+    std::string m_path{};
+    std::uint64_t m_count{ 0 };
+    bool m_open{ false };
+    record_file::Spill m_columns[fieldCount]{};
+    record_file::Spill m_strings[fieldCount]{};     // for string columns
+};
+
+#endif
@@ -0,0 +1,201 @@
+#ifndef SMALL_FUNCTION_H
+#define SMALL_FUNCTION_H
+
+#include <cstddef> // for std::size_t, std::max_align_t
+#include <functional> // for std::bad_function_call
+#include <new> // for placement new
+#include <type_traits> // for std::enable_if_t, std::is_invocable_r, std::decay_t
+#include <utility> // for std::forward, std::move
+
+/*
+An owning replacement for std::function with an inline buffer of a size we choose.
+
+small_function<void(int), 64> keeps a copy of the callable just like std::function does, but any callable of up to
+64 bytes (the default is 32) is stored inside the small_function itself, so a lambda with a few captures never causes a
+heap allocation. Only bigger callables (or ones that would throw while being moved) go on the heap.
+small_function<void(int)>::fitsInline<decltype(lambda)>() tells whether a callable will be stored inline, so
+    static_assert(small_function<void(int)>::fitsInline<decltype(lambda)>());
+turns an accidental allocation into a compile error.
+
+Apart from that it behaves like std::function: it can be copied (the callable has to be copyable), moved, checked with
+if(fcn), and calling an empty small_function throws std::bad_function_call.
+*/
+
+template <typename Signature, std::size_t BufferSize = 4 * sizeof(void*)>
+class small_function;
+
+template <typename R, typename... Args, std::size_t BufferSize>
+class small_function<R(Args...), BufferSize>
+{
+    static_assert(BufferSize >= sizeof(void*), "the buffer has to be big enough for a pointer to the heap copy");
+
+public:
+    template <typename Fcn>
+    static constexpr bool fitsInline()
+    {
+        return sizeof(Fcn) <= BufferSize && alignof(Fcn) <= alignof(std::max_align_t) &&
+               std::is_nothrow_move_constructible<Fcn>::value;
+    }
+
+    small_function() noexcept = default;
+
+    template <typename Fcn,
+              typename = std::enable_if_t<!std::is_same<std::decay_t<Fcn>, small_function>::value &&
+                                          std::is_invocable_r<R, std::decay_t<Fcn>&, Args...>::value>>
+    small_function(Fcn&& fcn)
+    {
+        using Stored = std::decay_t<Fcn>;
+
+        if constexpr(fitsInline<Stored>())
+            ::new(static_cast<void*>(m_buffer)) Stored(std::forward<Fcn>(fcn));
+        else
+            *reinterpret_cast<Stored**>(m_buffer) = new Stored(std::forward<Fcn>(fcn));
+
+        m_operations = &operationsFor<Stored>;
+    }
+
+    small_function(const small_function& other)
+    {
+        if(other.m_operations)
+        {
+            other.m_operations->copy(other.m_buffer, m_buffer);
+            m_operations = other.m_operations;
+        }
+    }
+
+    small_function(small_function&& other) noexcept
+    {
+        takeFrom(other);
+    }
+
+    ~small_function()
+    {
+        reset();
+    }
+
+    small_function& operator=(const small_function& other)
+    {
+        if(this != &other)
+        {
+            small_function copy{ other };
+            reset();
+            takeFrom(copy);
+        }
+
+        return *this;
+    }
+
+    small_function& operator=(small_function&& other) noexcept
+    {
+        if(this != &other)
+        {
+            reset();
+            takeFrom(other);
+        }
+
+        return *this;
+    }
+
+    explicit operator bool() const noexcept { return m_operations != nullptr; }
+
+    // true if the callable is stored in the buffer (or there is none), false if it's on the heap
+    bool isInline() const noexcept { return !m_operations || m_operations->storedInline; }
+
+    R operator()(Args... args) const
+    {
+        if(!m_operations)
+            throw std::bad_function_call{};
+
+        return m_operations->call(m_buffer, std::forward<Args>(args)...);
+    }
+
+private:
+    // what the small_function needs to know about the callable it holds, one table per type
+    struct Operations
+    {
+        R (*call)(unsigned char* buffer, Args&&... args);
+        void (*copy)(const unsigned char* from, unsigned char* to);
+        void (*move)(unsigned char* from, unsigned char* to) noexcept; // also destroys the one in from
+        void (*destroy)(unsigned char* buffer) noexcept;
+        bool storedInline;
+    };
+
+    template <typename Fcn>
+    static Fcn& callable(unsigned char* buffer) noexcept
+    {
+        if constexpr(fitsInline<Fcn>())
+            return *reinterpret_cast<Fcn*>(buffer);
+        else
+            return **reinterpret_cast<Fcn**>(buffer);
+    }
+
+    template <typename Fcn>
+    static R call(unsigned char* buffer, Args&&... args)
+    {
+        return callable<Fcn>(buffer)(std::forward<Args>(args)...);
+    }
+
+    template <typename Fcn>
+    static void copy(const unsigned char* from, unsigned char* to)
+    {
+        const Fcn& source{ callable<Fcn>(const_cast<unsigned char*>(from)) };
+
+        if constexpr(fitsInline<Fcn>())
+            ::new(static_cast<void*>(to)) Fcn(source);
+        else
+            *reinterpret_cast<Fcn**>(to) = new Fcn(source);
+    }
+
+    template <typename Fcn>
+    static void move(unsigned char* from, unsigned char* to) noexcept
+    {
+        if constexpr(fitsInline<Fcn>())
+        {
+            Fcn& source{ callable<Fcn>(from) };
+            ::new(static_cast<void*>(to)) Fcn(std::move(source));
+            source.~Fcn();
+        }
+        else
+        {
+            // the heap copy stays where it is, only the pointer moves
+            *reinterpret_cast<Fcn**>(to) = *reinterpret_cast<Fcn**>(from);
+        }
+    }
+
+    template <typename Fcn>
+    static void destroy(unsigned char* buffer) noexcept
+    {
+        if constexpr(fitsInline<Fcn>())
+            callable<Fcn>(buffer).~Fcn();
+        else
+            delete *reinterpret_cast<Fcn**>(buffer);
+    }
+
+    template <typename Fcn>
+    static constexpr Operations operationsFor{ &call<Fcn>, &copy<Fcn>, &move<Fcn>, &destroy<Fcn>, fitsInline<Fcn>() };
+
+    void takeFrom(small_function& other) noexcept
+    {
+        if(other.m_operations)
+        {
+            other.m_operations->move(other.m_buffer, m_buffer);
+            m_operations = other.m_operations;
+            other.m_operations = nullptr;
+        }
+    }
+
+    void reset() noexcept
+    {
+        if(m_operations)
+        {
+            m_operations->destroy(m_buffer);
+            m_operations = nullptr;
+        }
+    }
+
+    // mutable because calling a small_function is const (like std::function), but the callable may be a mutable lambda
+    alignas(std::max_align_t) mutable unsigned char m_buffer[BufferSize]{};
+    const Operations* m_operations{ nullptr };
+};
+
+#endif
@@ -0,0 +1,101 @@
+#include <iostream>
+#include <algorithm> // for std::max_element, std::partial_sort
+#include <chrono> // for std::chrono::steady_clock
+#include <cstdlib> // for std::atoi
+#include <random> // for std::mt19937
+#include <string>
+#include <vector>
+#include "student_table.h" // for StudentTable
+
+/*
+Compares std::max_element over Student structs (as in quiz_time.cpp) with StudentTable::bestStudent(), and
+std::partial_sort with StudentTable::topStudents(), for random points and for points that keep going up (so that
+every block has a new best point, the worst case for StudentTable).
+argv[1] is the number of students in millions (10 if not given).
+Build with optimisations, e.g.:
+
+    g++ -std=c++17 -O2 student_benchmark.cpp -o student_benchmark
+*/
+
+// the Student struct from quiz_time.cpp, kept here as the baseline
+struct Student
+{
+    std::string name{};
+    int point{};
+};
+
+template <typename Fcn>
+double timeIt(Fcn fcn)
+{
+    auto start{ std::chrono::steady_clock::now() };
+    fcn();
+    auto end{ std::chrono::steady_clock::now() };
+
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+void run(const char* name, const std::vector<Student>& students, const StudentTable& table)
+{
+    std::cout << name << ":\n";
+
+    std::size_t structBest{};
+    double structMs{ timeIt([&]{
+        auto best{ std::max_element(students.begin(), students.end(),
+                                    [](const Student& a, const Student& b) { return (a.point < b.point); }) };
+        structBest = static_cast<std::size_t>(best - students.begin());
+    }) };
+
+    std::size_t tableBest{};
+    double tableMs{ timeIt([&]{ tableBest = table.bestStudent(); }) };
+
+    std::cout << "  best student: max_element " << structMs << " ms, StudentTable " << tableMs << " ms"
+              << (structBest == tableBest ? "" : "  (different answers!)") << '\n';
+
+    // top 10, the baseline sorts row ids by the struct's points
+    constexpr std::size_t k{ 10 };
+    std::vector<std::size_t> rows(students.size());
+    for(std::size_t i{ 0 }; i < rows.size(); ++i)
+        rows[i] = i;
+
+    double partialMs{ timeIt([&]{
+        std::partial_sort(rows.begin(), rows.begin() + k, rows.end(), [&](std::size_t a, std::size_t b){
+            return (students[a].point > students[b].point) || (students[a].point == students[b].point && a < b);
+        });
+    }) };
+
+    std::vector<std::size_t> top{};
+    double topMs{ timeIt([&]{ top = table.topStudents(k); }) };
+
+    bool same{ std::equal(top.begin(), top.end(), rows.begin()) };
+    std::cout << "  top " << k << ": partial_sort " << partialMs << " ms, StudentTable " << topMs << " ms"
+              << (same ? "" : "  (different answers!)") << '\n';
+}
+
+int main(int argc, char* argv[])
+{
+    int millions{ argc > 1 ? std::atoi(argv[1]) : 10 };
+    if(millions < 1)
+        millions = 1;
+
+    const std::size_t count{ static_cast<std::size_t>(millions) * 1'000'000 };
+    std::mt19937 mt{ 13 };
+    std::uniform_int_distribution<int> pointDistribution{ 0, 1'000'000 };
+
+    for(bool increasing : { false, true })
+    {
+        std::vector<Student> students(count);
+        StudentTable table{};
+        table.reserve(count, count * 8);
+
+        for(std::size_t i{ 0 }; i < count; ++i)
+        {
+            students[i].name = "Student" + std::to_string(i % 1000);
+            students[i].point = increasing ? static_cast<int>(i) : pointDistribution(mt);
+            table.add(students[i].name, students[i].point);
+        }
+
+        run(increasing ? "points going up" : "random points", students, table);
+    }
+
+    return 0;
+}
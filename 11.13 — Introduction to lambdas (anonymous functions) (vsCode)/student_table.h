@@ -0,0 +1,250 @@
+#ifndef STUDENT_TABLE_H
+#define STUDENT_TABLE_H
+
+#include <algorithm> // for std::min, std::sort, std::nth_element, std::make_heap, std::sort_heap
+#include <climits> // for INT_MIN
+#include <cstddef> // for std::size_t, std::ptrdiff_t
+#include <string_view>
+#include <vector>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#include <immintrin.h>
+#define STUDENT_TABLE_HAS_AVX2 1
+#endif
+
+/*
+The students of Question #1 stored by column instead of as an array of Student structs.
+
+In std::array<Student, N> every point sits next to a std::string, so std::max_element has to walk over all the names
+(and their heap buffers, for longer names) just to compare ints. StudentTable keeps:
+  - all points next to each other in one array (points()),
+  - all names back to back in one character buffer, with the offset where each one starts.
+Rows are numbered in the order they were added (the row id), and name(row) and point(row) give the columns back.
+
+The queries only read the points array. They look at it in blocks of a few thousand points: the largest point of a
+block is found with SIMD (AVX2, picked at run time, 32 points per step), and only a block that can change the answer is
+looked at point by point.
+  - bestStudent() returns the row with the most points. Like std::max_element, the first one wins on a tie,
+  - topStudents(k) returns the rows of the k students with the most points, best first, earlier rows first on a tie
+    (the same order a stable sort by points, descending, would give).
+    It looks at the blocks with the highest best point first and stops as soon as the next block can't beat the k
+    students it has, so usually only about k blocks are looked at point by point.
+
+The string_view from name() points into the name buffer, which moves when it grows, so it's only good until the next
+add().
+*/
+
+class StudentTable
+{
+public:
+    using RowId = std::size_t;
+
+    static constexpr RowId npos{ static_cast<RowId>(-1) };
+
+    // room for rows students with nameBytes characters of names in total, so that adding them doesn't reallocate
+    void reserve(std::size_t rows, std::size_t nameBytes)
+    {
+        m_points.reserve(rows);
+        m_nameStarts.reserve(rows + 1);
+        m_names.reserve(nameBytes);
+    }
+
+    RowId add(std::string_view name, int point)
+    {
+        m_names.insert(m_names.end(), name.begin(), name.end());
+        m_nameStarts.push_back(m_names.size());
+        m_points.push_back(point);
+
+        return m_points.size() - 1;
+    }
+
+    std::size_t size() const { return m_points.size(); }
+    bool empty() const { return m_points.empty(); }
+
+    int point(RowId row) const { return m_points[row]; }
+    const int* points() const { return m_points.data(); }
+
+    std::string_view name(RowId row) const
+    {
+        std::size_t begin{ m_nameStarts[row] };
+        return { m_names.data() + begin, m_nameStarts[row + 1] - begin };
+    }
+
+    // the (first) row with the most points, npos if the table is empty
+    RowId bestStudent() const
+    {
+        const int* points{ m_points.data() };
+        const std::size_t count{ m_points.size() };
+
+        RowId best{ npos };
+        int bestPoint{ INT_MIN };
+
+        for(std::size_t begin{ 0 }; begin < count; begin += blockSize)
+        {
+            std::size_t size{ std::min(blockSize, count - begin) };
+
+            // only a strictly bigger maximum can change the answer, that keeps the first row on a tie
+            int blockBest{ blockMax(points + begin, size) };
+            if(best != npos && blockBest <= bestPoint)
+                continue;
+
+            for(std::size_t i{ 0 }; i < size; ++i)
+            {
+                if(points[begin + i] == blockBest)
+                {
+                    best = begin + i;
+                    bestPoint = blockBest;
+                    break;
+                }
+            }
+        }
+
+        return best;
+    }
+
+    // rows of the k students with the most points, best first (fewer if the table has less than k rows)
+    std::vector<RowId> topStudents(std::size_t k) const
+    {
+        const int* points{ m_points.data() };
+        const std::size_t count{ m_points.size() };
+        k = std::min(k, count);
+
+        struct Entry
+        {
+            int point;
+            RowId row;
+        };
+
+        // the best k entries so far, as a heap with the worst of them on top
+        auto better{ [](const Entry& a, const Entry& b){
+            return (a.point > b.point) || (a.point == b.point && a.row < b.row);
+        } };
+
+        std::vector<Entry> heap{};
+
+        if(k > 0)
+        {
+            // the best point of every block, then the blocks with the best points first
+            struct Block
+            {
+                int best;
+                std::size_t begin;
+            };
+
+            std::vector<Block> blocks{};
+            blocks.reserve(count / blockSize + 1);
+            for(std::size_t begin{ 0 }; begin < count; begin += blockSize)
+                blocks.push_back(Block{ blockMax(points + begin, std::min(blockSize, count - begin)), begin });
+
+            std::sort(blocks.begin(), blocks.end(), [](const Block& a, const Block& b){
+                return (a.best > b.best) || (a.best == b.best && a.begin < b.begin);
+            });
+
+            heap.reserve(k + blockSize);
+            for(const Block& block : blocks)
+            {
+                bool full{ heap.size() == k };
+                Entry worst{ full ? heap.front() : Entry{ INT_MIN, npos } };
+
+                if(full)
+                {
+                    // the blocks after this one don't have better points either
+                    if(block.best < worst.point)
+                        break;
+
+                    // a tie only gets in with an earlier row
+                    if(block.best == worst.point && block.begin > worst.row)
+                        continue;
+                }
+
+                // add whatever beats the worst entry, then keep the best k of those
+                std::size_t end{ std::min(block.begin + blockSize, count) };
+                for(std::size_t i{ block.begin }; i < end; ++i)
+                {
+                    Entry entry{ points[i], i };
+                    if(!full || better(entry, worst))
+                        heap.push_back(entry);
+                }
+
+                if(heap.size() > k)
+                {
+                    std::nth_element(heap.begin(), heap.begin() + static_cast<std::ptrdiff_t>(k), heap.end(), better);
+                    heap.resize(k);
+                }
+                std::make_heap(heap.begin(), heap.end(), better);
+            }
+        }
+
+        std::sort_heap(heap.begin(), heap.end(), better);
+
+        std::vector<RowId> rows(heap.size());
+        for(std::size_t i{ 0 }; i < heap.size(); ++i)
+            rows[i] = heap[i].row;
+
+        return rows;
+    }
+
+private:
+    // 8 KB of points, small enough to still be in the L1 cache when a block has to be looked at again
+    static constexpr std::size_t blockSize{ 2048 };
+
+    static int blockMaxScalar(const int* points, std::size_t size)
+    {
+        int best{ INT_MIN };
+        for(std::size_t i{ 0 }; i < size; ++i)
+            best = (points[i] > best) ? points[i] : best;
+
+        return best;
+    }
+
+#if defined(STUDENT_TABLE_HAS_AVX2)
+    __attribute__((target("avx2"))) static int blockMaxAvx2(const int* points, std::size_t size)
+    {
+        // 4 independent maximums of 8 points each, so the vpmaxsd's don't wait for each other
+        __m256i best0{ _mm256_set1_epi32(INT_MIN) };
+        __m256i best1{ best0 };
+        __m256i best2{ best0 };
+        __m256i best3{ best0 };
+
+        std::size_t i{ 0 };
+        for(; i + 32 <= size; i += 32)
+        {
+            best0 = _mm256_max_epi32(best0, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(points + i)));
+            best1 = _mm256_max_epi32(best1, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(points + i + 8)));
+            best2 = _mm256_max_epi32(best2, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(points + i + 16)));
+            best3 = _mm256_max_epi32(best3, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(points + i + 24)));
+        }
+
+        __m256i best{ _mm256_max_epi32(_mm256_max_epi32(best0, best1), _mm256_max_epi32(best2, best3)) };
+        __m128i half{ _mm_max_epi32(_mm256_castsi256_si128(best), _mm256_extracti128_si256(best, 1)) };
+        half = _mm_max_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(1, 0, 3, 2)));
+        half = _mm_max_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(2, 3, 0, 1)));
+
+        int rest{ blockMaxScalar(points + i, size - i) };
+        int vectorBest{ _mm_cvtsi128_si32(half) };
+
+        return (rest > vectorBest) ? rest : vectorBest;
+    }
+
+    static bool cpuHasAvx2()
+    {
+        static const bool hasAvx2{ __builtin_cpu_supports("avx2") != 0 };
+        return hasAvx2;
+    }
+#endif
+
+    static int blockMax(const int* points, std::size_t size)
+    {
+#if defined(STUDENT_TABLE_HAS_AVX2)
+        if(cpuHasAvx2())
+            return blockMaxAvx2(points, size);
+#endif
+        return blockMaxScalar(points, size);
+    }
+
+    std::vector<int> m_points{};
+    std::vector<char> m_names{};
+    std::vector<std::size_t> m_nameStarts{ 0 }; // name(row) is m_names[m_nameStarts[row]] up to m_nameStarts[row + 1]
+};
+
+#endif
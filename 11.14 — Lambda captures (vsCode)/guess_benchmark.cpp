@@ -0,0 +1,126 @@
+#include <iostream>
+#include <algorithm> // for std::find, std::min_element, std::shuffle
+#include <chrono> // for std::chrono::steady_clock
+#include <cmath> // for std::abs
+#include <random> // for std::mt19937
+#include <vector>
+#include "guess_set.h" // for GuessSet
+
+/*
+Plays the square number game from quiztime_3.cpp with n numbers and n guesses: every number is guessed once in a
+random order, and every 10th guess is first preceded by a wrong guess next to a number (which asks for the closest
+number). Compares the std::vector with std::find / erase / std::min_element against GuessSet.
+The vector needs O(n) per guess, so it's only run up to n = 10^5; GuessSet goes up to n = 10^6.
+Build with optimisations, e.g.:
+
+    g++ -std=c++17 -O2 guess_benchmark.cpp -o guess_benchmark
+*/
+
+// keeps the compiler from throwing away results we never look at
+volatile double g_sink{};
+
+std::vector<double> generate(int start, int count, int multiplier)
+{
+    std::vector<double> stack{};
+    stack.reserve(static_cast<std::size_t>(count));
+
+    for(int i{ 0 }; i < count; ++i)
+    {
+        double x{ (static_cast<double>(start) + i) * (static_cast<double>(start) + i) };
+        stack.push_back(x * multiplier);
+    }
+
+    return stack;
+}
+
+// what quiztime_3.cpp did with the vector, kept here as the baseline
+double playVector(std::vector<double> stack, const std::vector<double>& guesses)
+{
+    double total{ 0.0 };
+    for(double guess : guesses)
+    {
+        auto found{ std::find(stack.begin(), stack.end(), guess) };
+        if(found != stack.end())
+        {
+            stack.erase(found);
+            continue;
+        }
+
+        auto closest{ std::min_element(stack.begin(), stack.end(), [guess](double a, double b) {
+            return (std::abs(a - guess) < std::abs(b - guess));
+        }) };
+        if(closest != stack.end())
+            total += *closest;
+    }
+
+    return total;
+}
+
+double playGuessSet(const std::vector<double>& stack, const std::vector<double>& guesses)
+{
+    GuessSet set{ stack };
+
+    double total{ 0.0 };
+    for(double guess : guesses)
+    {
+        if(set.remove(guess))
+            continue;
+
+        double closest{};
+        if(set.findClosest(guess, closest))
+            total += closest;
+    }
+
+    return total;
+}
+
+template <typename Fcn>
+double timeIt(Fcn fcn)
+{
+    auto start{ std::chrono::steady_clock::now() };
+    fcn();
+    auto end{ std::chrono::steady_clock::now() };
+
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+int main()
+{
+    std::mt19937 mt{ 15 };
+
+    for(int count : { 10'000, 100'000, 1'000'000 })
+    {
+        std::vector<double> stack{ generate(4, count, 3) };
+
+        std::vector<double> order{ stack };
+        std::shuffle(order.begin(), order.end(), mt);
+
+        std::vector<double> guesses{};
+        guesses.reserve(order.size() + order.size() / 10);
+        for(std::size_t i{ 0 }; i < order.size(); ++i)
+        {
+            if(i % 10 == 0)
+                guesses.push_back(order[i] + 1.0); // wrong, the closest number is order[i] (or a neighbour)
+            guesses.push_back(order[i]);
+        }
+
+        std::cout << count << " numbers, " << guesses.size() << " guesses:\n";
+
+        double setTotal{};
+        double setMs{ timeIt([&]{ setTotal = playGuessSet(stack, guesses); }) };
+        std::cout << "  GuessSet:    " << setMs << " ms (" << setMs * 1e6 / static_cast<double>(guesses.size())
+                  << " ns per guess)\n";
+
+        if(count <= 100'000)
+        {
+            double vectorTotal{};
+            double vectorMs{ timeIt([&]{ vectorTotal = playVector(stack, guesses); }) };
+            std::cout << "  std::vector: " << vectorMs << " ms (" << vectorMs * 1e6 / static_cast<double>(guesses.size())
+                      << " ns per guess)" << (vectorTotal == setTotal ? "" : "  (different answers!)") << '\n';
+        }
+
+        g_sink = setTotal;
+    }
+
+    return 0;
+}
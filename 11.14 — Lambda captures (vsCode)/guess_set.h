@@ -0,0 +1,230 @@
+#ifndef GUESS_SET_H
+#define GUESS_SET_H
+
+#include <algorithm> // for std::sort, std::lower_bound
+#include <cmath> // for std::floor
+#include <cstddef> // for std::size_t
+#include <cstdint> // for std::uint64_t
+#include <vector>
+
+/*
+The numbers of the square number game, indexed so that a guess doesn't have to look through all of them.
+
+With a std::vector, every guess is a std::find (all numbers), a std::vector::erase (all numbers after it move) and,
+when the guess is wrong, a std::min_element (all numbers again). GuessSet keeps:
+  - the different numbers, sorted, so a guess is found with a binary search (O(log n)),
+  - how many of each number are left (with a negative start, e.g. -2, -1, 0, 1, 2, squares show up twice),
+  - one bit per number that says whether any of it is left, and on top of that one bit per 64 bits that says whether
+    any of those 64 is set, and so on, until a single 64 bit word is left. Removing a number clears its bit (and the
+    bits above it if its word became 0). The closest remaining number to a guess is the first set bit after the guess
+    and the last one before it, and each of those is found with a few bit scans going up and down the levels
+    (O(log n) with base 64, so 4 levels for 16 million numbers).
+
+The numbers are always whole numbers, so they are stored as long long. A guess that isn't a whole number can't be in
+the set, but still has a closest number. On a tie, findClosest() gives the smaller number, which is what
+std::min_element over the generated (increasing) numbers would pick.
+*/
+
+class GuessSet
+{
+public:
+    explicit GuessSet(const std::vector<double>& numbers)
+    {
+        std::vector<long long> sorted(numbers.begin(), numbers.end());
+        std::sort(sorted.begin(), sorted.end());
+
+        for(long long number : sorted)
+        {
+            if(m_numbers.empty() || m_numbers.back() != number)
+            {
+                m_numbers.push_back(number);
+                m_left.push_back(0);
+            }
+            ++m_left.back();
+        }
+        m_size = sorted.size();
+
+        // every number is there to begin with, so all bits are set
+        std::size_t bitCount{ m_numbers.size() };
+        do
+        {
+            std::size_t wordCount{ (bitCount + 63) / 64 };
+            if(wordCount == 0)
+                wordCount = 1;
+
+            std::vector<std::uint64_t> level(wordCount, ~0ull);
+            if(bitCount % 64 != 0)
+                level.back() = (1ull << (bitCount % 64)) - 1;
+            if(bitCount == 0)
+                level.back() = 0;
+
+            m_levels.push_back(level);
+            bitCount = wordCount;
+        } while(m_levels.back().size() > 1);
+    }
+
+    // numbers left (the same number counts as often as it's left)
+    std::size_t size() const { return m_size; }
+
+    bool contains(double number) const
+    {
+        std::size_t index{ indexOf(number) };
+        return index != npos && m_left[index] > 0;
+    }
+
+    // removes one of number, returns false if there's none left
+    bool remove(double number)
+    {
+        std::size_t index{ indexOf(number) };
+        if(index == npos || m_left[index] == 0)
+            return false;
+
+        --m_size;
+        if(--m_left[index] == 0)
+            clearBit(index);
+
+        return true;
+    }
+
+    // the remaining number closest to guess, false if there are none left
+    bool findClosest(double guess, double& closestOut) const
+    {
+        if(m_size == 0)
+            return false;
+
+        // the first number >= guess, and the last one before it
+        std::size_t split{ static_cast<std::size_t>(
+            std::lower_bound(m_numbers.begin(), m_numbers.end(), guess,
+                             [](long long number, double value) { return static_cast<double>(number) < value; }) -
+            m_numbers.begin()) };
+
+        std::size_t above{ findNext(0, split) };
+        std::size_t below{ split > 0 ? findPrevious(0, split - 1) : npos };
+
+        if(above == npos ||
+           (below != npos && guess - static_cast<double>(m_numbers[below]) <= static_cast<double>(m_numbers[above]) - guess))
+            closestOut = static_cast<double>(m_numbers[below]);
+        else
+            closestOut = static_cast<double>(m_numbers[above]);
+
+        return true;
+    }
+
+private:
+    static constexpr std::size_t npos{ static_cast<std::size_t>(-1) };
+
+    // index of number in m_numbers, npos if it's not one of them
+    std::size_t indexOf(double number) const
+    {
+        // not a whole number (or NaN): can't be one of ours
+        if(!(std::floor(number) == number))
+            return npos;
+
+        if(m_numbers.empty() || number < static_cast<double>(m_numbers.front()) ||
+           number > static_cast<double>(m_numbers.back()))
+            return npos;
+
+        long long value{ static_cast<long long>(number) };
+        auto found{ std::lower_bound(m_numbers.begin(), m_numbers.end(), value) };
+
+        if(found == m_numbers.end() || *found != value)
+            return npos;
+
+        return static_cast<std::size_t>(found - m_numbers.begin());
+    }
+
+    static int lowestBit(std::uint64_t word)
+    {
+#if defined(__GNUC__)
+        return __builtin_ctzll(word);
+#else
+        int bit{ 0 };
+        while(!(word & 1))
+        {
+            word >>= 1;
+            ++bit;
+        }
+        return bit;
+#endif
+    }
+
+    static int highestBit(std::uint64_t word)
+    {
+#if defined(__GNUC__)
+        return 63 - __builtin_clzll(word);
+#else
+        int bit{ 63 };
+        while(!(word & (1ull << 63)))
+        {
+            word <<= 1;
+            --bit;
+        }
+        return bit;
+#endif
+    }
+
+    // first set bit at position from or after it in a level, npos if there's none
+    std::size_t findNext(std::size_t level, std::size_t from) const
+    {
+        const std::vector<std::uint64_t>& bits{ m_levels[level] };
+
+        std::size_t word{ from / 64 };
+        if(word >= bits.size())
+            return npos;
+
+        std::uint64_t rest{ bits[word] & (~0ull << (from % 64)) };
+        if(rest)
+            return word * 64 + static_cast<std::size_t>(lowestBit(rest));
+
+        // the level above says which of the following words have anything in them
+        if(level + 1 == m_levels.size())
+            return npos;
+
+        std::size_t nextWord{ findNext(level + 1, word + 1) };
+        if(nextWord == npos)
+            return npos;
+
+        return nextWord * 64 + static_cast<std::size_t>(lowestBit(bits[nextWord]));
+    }
+
+    // last set bit at position from or before it in a level, npos if there's none
+    std::size_t findPrevious(std::size_t level, std::size_t from) const
+    {
+        const std::vector<std::uint64_t>& bits{ m_levels[level] };
+
+        std::size_t word{ from / 64 };
+        std::uint64_t rest{ bits[word] & (~0ull >> (63 - from % 64)) };
+        if(rest)
+            return word * 64 + static_cast<std::size_t>(highestBit(rest));
+
+        if(word == 0 || level + 1 == m_levels.size())
+            return npos;
+
+        std::size_t previousWord{ findPrevious(level + 1, word - 1) };
+        if(previousWord == npos)
+            return npos;
+
+        return previousWord * 64 + static_cast<std::size_t>(highestBit(bits[previousWord]));
+    }
+
+    void clearBit(std::size_t index)
+    {
+        for(std::vector<std::uint64_t>& bits : m_levels)
+        {
+            bits[index / 64] &= ~(1ull << (index % 64));
+
+            // the word still has other bits set, so the levels above stay as they are
+            if(bits[index / 64] != 0)
+                return;
+
+            index /= 64;
+        }
+    }
+
+    std::vector<long long> m_numbers{};           // the different numbers, sorted
+    std::vector<int> m_left{};                    // how many of each number are left
+    std::vector<std::vector<std::uint64_t>> m_levels{}; // m_levels[0] has a bit per number, each level above a bit per word
+    std::size_t m_size{ 0 };
+};
+
+#endif
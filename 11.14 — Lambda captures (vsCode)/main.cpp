@@ -4,6 +4,10 @@
 #include <string_view>
 #include <string>
 #include <vector>
+#include "../11.5 — Returning values by value, reference, and address (vsCode)/string_pool.h" // for StringPool, StringId
+#define SORT_INSTRUMENTATION // count in this lesson; without it the wrappers below cost nothing and count nothing
+#include "sort_instrumentation.h" // for InstrumentationSite, instrumentCompare, instrumentSwap
+#include "../11.7 — Function Pointers (vsCode)/introsort.h" // for introSort
 
 struct Car
 {
@@ -11,6 +15,13 @@ struct Car
     std::string model{};
 };
 
+// a Car with its make and model in a StringPool: 8 bytes instead of 64, and the same make is only stored once
+struct InternedCar
+{
+    StringId make{};
+    StringId model{};
+};
+
 struct CEnemy
 {
 
@@ -203,6 +214,42 @@ int main()
         std::cout << car.make << ' ' << car.model << '\n';
     }
 
+    // the same with the strings in a pool: the lambda captures the pool by reference to get the makes back
+    StringPool carNames{};
+    std::array<InternedCar, 3> arr_interned{ { { carNames.intern("Volkswagen"), carNames.intern("Golf") },
+                                               { carNames.intern("Toyota"), carNames.intern("Corolla") },
+                                               { carNames.intern("Honda"), carNames.intern("Civic") } } };
+
+    std::sort(arr_interned.begin(), arr_interned.end(),
+                [&carNames](const InternedCar& a, const InternedCar& b){
+                    return (carNames.view(a.make) < carNames.view(b.make));
+                });
+
+    for(const auto& car : arr_interned )
+    {
+        std::cout << carNames.view(car.make) << ' ' << carNames.view(car.model) << '\n';
+    }
+
+    /*
+    When we want to compare sorts, counting with a captured reference gets repetitive. instrumentCompare() (see
+    sort_instrumentation.h) wraps any comparison, a lambda or a function pointer, and counts the comparisons (and how
+    many were true) for a named site; instrumentSwap() counts the swaps of a sort that takes one, like introSort():
+    */
+    static const InstrumentationSite carSort{ "std::sort, cars by model" };
+    static const InstrumentationSite numberSort{ "introSort, evens first" };
+
+    std::sort(arr_car.begin(), arr_car.end(), instrumentCompare(carSort, [](const Car& a, const Car& b){
+        return (a.model < b.model);
+    }));
+
+    std::vector<int> numbers{ 9, 4, 7, 2, 8, 1, 6, 3, 5, 0, 13, 12, 11, 10, 15, 14, 17, 16, 19, 18 };
+    introSort(numbers.data(), static_cast<int>(numbers.size()), instrumentCompare(numberSort, [](int x, int y){
+        // true means x goes after y: odd numbers after even ones, otherwise ascending
+        return (x % 2 != y % 2) ? (x % 2 != 0) : (x > y);
+    }), instrumentSwap(numberSort));
+
+    printInstrumentation(stdout);
+
 
     std::cout << std::endl;
     ////////////////////////////////////////////////////////////////////////////////////////////
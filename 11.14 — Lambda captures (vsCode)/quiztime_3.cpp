@@ -1,16 +1,11 @@
 #include <iostream>
-#include <cmath> // for std::pow(a, b);
+#include <cmath> // for std::pow(a, b); // std::abs
 #include <random> // for std::mt19937
 #include <ctime> // for std::time
 #include <vector>
 #include <algorithm> // for std::find // std::min_elements
-
-void printStack(const std::vector<double>& stack)
-{
-	for (auto element : stack)
-		std::cout << element << ' ';
-	std::cout << "(cap " << stack.capacity() << " length " << stack.size() << ")\n";
-}
+#include "guess_set.h" // for GuessSet
+#include "../11.9 — std::vector capacity and stack behavior (vsCode)/print_stack.h" // for printStack
 
 int main()
 {
@@ -134,28 +129,38 @@ int main()
 
     printStack(stack);
 
+    /*
+    std::find, erase and std::min_element each go through the whole list on every guess. For a lot of numbers, the
+    guesses are looked up in a GuessSet (see guess_set.h) instead, which finds, removes and finds the closest number
+    without looking at all of them. stack keeps the numbers as they were generated.
+    */
+    GuessSet guesses{ stack };
+
     double choice{};
 
-    for(int i{ second_int }; i != 0; --i)
+    while(guesses.size() > 0)
     {
         std::cout << '>';
         std::cin >> choice;
-        auto found{ std::find(stack.begin(), stack.end(), choice) };
 
-        if(i < 2)
+        if(guesses.remove(choice))
         {
-            std::cout << "Nice! You found all numbers, good job!\n";
-            break;
-        }
-
-        if(found != stack.end())
-        { 
-            stack.erase(found);
-            std::cout << "Nice! " << i - 1 << " numbers left.\n";
+            if(guesses.size() == 0)
+                std::cout << "Nice! You found all numbers, good job!\n";
+            else
+                std::cout << "Nice! " << guesses.size() << " numbers left.\n";
         }
         else
         {
-            std::cout << choice << " is wrong!\n";
+            std::cout << choice << " is wrong!";
+
+            // only if the guess wasn't off by more than 4
+            double closest{};
+            if(guesses.findClosest(choice, closest) && std::abs(closest - choice) <= 4)
+                std::cout << " Try " << closest << " next time.";
+
+            std::cout << '\n';
+            break;
         }
     }
         
@@ -0,0 +1,378 @@
+#ifndef SORT_INSTRUMENTATION_H
+#define SORT_INSTRUMENTATION_H
+
+#include <cstdint> // for std::uint64_t
+#include <cstdio> // for std::FILE, std::fprintf
+#include <string>
+#include <utility> // for std::swap, std::forward
+
+#if defined(SORT_INSTRUMENTATION)
+#include <atomic>
+#include <mutex>
+#endif
+
+/*
+Counting what a sort (or a search) does: comparisons, how they came out, and swaps.
+
+Above, the lambda passed to std::sort counts its comparisons in a variable captured by reference. That works for one
+call in one place. For comparing sort engines on real data, the counting is done by wrappers instead, with the counts
+kept per named call site:
+
+    static const InstrumentationSite site{ "introSort, evens first" };
+    introSort(array, size, instrumentCompare(site, evensFirst), instrumentSwap(site));
+    printInstrumentation();     // "introSort, evens first: 1234 comparisons (567 true, 667 false), 89 swaps"
+
+  - instrumentCompare(site, comparisonFcn) takes any comparison (a function pointer like evensFirst, a lambda, a
+    function object) and counts every call and how many of them returned true. That split is how the branch on the
+    result goes: a comparison that is true about half the time, at random, is one the CPU can't predict.
+  - instrumentSwap(site, swapFcn) does the same for a swap (std::swap if none is given). introSort() takes one as its
+    4th argument; std::sort has no way to pass one in, so there only comparisons are counted.
+  - site.counts() adds up the counts of all threads that used the site, also of those that have ended. Subtracting
+    two counts() gives what happened in between. printInstrumentation() prints every site.
+
+Sites should live as long as the program (static, like above); they're up to 128. The counts are per thread: each
+thread adds to its own counters, atomics that only it writes, with relaxed loads and stores (a plain add, no locked
+instruction and no cache line going back and forth between cores), and counts() reads them with relaxed loads.
+
+The counting only happens when the program is compiled with -DSORT_INSTRUMENTATION (or with #define
+SORT_INSTRUMENTATION before including this header, the same way in every .cpp file of the program). Without it,
+instrumentCompare() and instrumentSwap() return the comparison and the swap they were given, unchanged, so the sort
+compiles exactly as if they weren't there; counts() is all 0 and printInstrumentation() prints nothing.
+*/
+
+struct InstrumentationCounts
+{
+    std::uint64_t comparisons{ 0 };
+    std::uint64_t comparisonsTrue{ 0 }; // how many comparisons returned true
+    std::uint64_t swaps{ 0 };
+
+    std::uint64_t comparisonsFalse() const { return comparisons - comparisonsTrue; }
+
+    InstrumentationCounts operator-(const InstrumentationCounts& earlier) const
+    {
+        return { comparisons - earlier.comparisons, comparisonsTrue - earlier.comparisonsTrue, swaps - earlier.swaps };
+    }
+};
+
+namespace sort_instrumentation
+{
+    struct StdSwap
+    {
+        template <typename T>
+        void operator()(T& a, T& b) const
+        {
+            using std::swap;
+            swap(a, b);
+        }
+    };
+
+    inline void print(std::FILE* out, const std::string& name, const InstrumentationCounts& counts)
+    {
+        std::fprintf(out, "%s: %llu comparisons (%llu true, %llu false), %llu swaps\n", name.c_str(),
+                     static_cast<unsigned long long>(counts.comparisons),
+                     static_cast<unsigned long long>(counts.comparisonsTrue),
+                     static_cast<unsigned long long>(counts.comparisonsFalse()),
+                     static_cast<unsigned long long>(counts.swaps));
+    }
+}
+
+#if defined(SORT_INSTRUMENTATION)
+
+class InstrumentationSite;
+
+namespace sort_instrumentation
+{
+    constexpr int maxSites{ 128 };
+
+    constexpr int comparisons{ 0 };
+    constexpr int comparisonsTrue{ 1 };
+    constexpr int swaps{ 2 };
+    constexpr int counterKinds{ 3 };
+
+    // the counters of one thread, only ever written by that thread
+    struct alignas(64) ThreadCounters
+    {
+        std::atomic<std::uint64_t> counts[maxSites][counterKinds];
+        ThreadCounters* previous;
+        ThreadCounters* next;
+    };
+
+    struct Registry
+    {
+        std::mutex mutex{};
+        int siteCount{ 0 };
+        const InstrumentationSite* sites[maxSites]{};
+        ThreadCounters* threads{ nullptr };                      // the threads that are still running
+        std::uint64_t ended[maxSites][counterKinds]{};           // what the threads that have ended counted
+    };
+
+    // never destroyed, threads can still end (and hand in their counts) after main() has returned
+    inline Registry& registry()
+    {
+        static Registry* s_registry{ new Registry{} };
+        return *s_registry;
+    }
+
+    // constant initialized and trivially destructible, so using it costs no guard check
+    inline thread_local ThreadCounters* t_counters{ nullptr };
+
+    // hands the thread's counts over to the registry when the thread ends
+    struct ThreadExit
+    {
+        ~ThreadExit()
+        {
+            ThreadCounters* counters{ t_counters };
+            if(!counters)
+                return;
+
+            Registry& shared{ registry() };
+            std::lock_guard<std::mutex> lock{ shared.mutex };
+            for(int site{ 0 }; site < maxSites; ++site)
+            {
+                for(int kind{ 0 }; kind < counterKinds; ++kind)
+                    shared.ended[site][kind] += counters->counts[site][kind].load(std::memory_order_relaxed);
+            }
+
+            (counters->previous ? counters->previous->next : shared.threads) = counters->next;
+            if(counters->next)
+                counters->next->previous = counters->previous;
+
+            t_counters = nullptr;
+            delete counters;
+        }
+    };
+
+    // the first count on a thread
+    inline ThreadCounters* attachThread()
+    {
+        ThreadCounters* counters{ new ThreadCounters{} };
+        for(auto& site : counters->counts)
+        {
+            for(auto& count : site)
+                count.store(0, std::memory_order_relaxed);
+        }
+
+        Registry& shared{ registry() };
+        {
+            std::lock_guard<std::mutex> lock{ shared.mutex };
+            counters->previous = nullptr;
+            counters->next = shared.threads;
+            if(shared.threads)
+                shared.threads->previous = counters;
+            shared.threads = counters;
+        }
+
+        static thread_local ThreadExit t_exit{};
+        static_cast<void>(t_exit);
+
+        t_counters = counters;
+        return counters;
+    }
+
+    // only this thread writes the count, so a load and a store are enough (and much cheaper than fetch_add)
+    inline void increase(std::atomic<std::uint64_t>& count, std::uint64_t amount)
+    {
+        count.store(count.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+
+    inline std::atomic<std::uint64_t>* siteCounts(int site)
+    {
+        ThreadCounters* counters{ t_counters };
+        if(!counters)
+            counters = attachThread();
+
+        return counters->counts[site];
+    }
+
+    inline void addComparison(int site, bool result)
+    {
+        if(site < 0)
+            return;
+
+        std::atomic<std::uint64_t>* counts{ siteCounts(site) };
+        increase(counts[comparisons], 1);
+        increase(counts[comparisonsTrue], result);
+    }
+
+    inline void addSwap(int site)
+    {
+        if(site >= 0)
+            increase(siteCounts(site)[swaps], 1);
+    }
+}
+
+class InstrumentationSite
+{
+public:
+    explicit InstrumentationSite(std::string name)
+        : m_name{ std::move(name) }
+    {
+        sort_instrumentation::Registry& shared{ sort_instrumentation::registry() };
+        std::lock_guard<std::mutex> lock{ shared.mutex };
+        if(shared.siteCount < sort_instrumentation::maxSites)
+        {
+            m_id = shared.siteCount++;
+            shared.sites[m_id] = this;
+        }
+    }
+
+    ~InstrumentationSite()
+    {
+        if(m_id < 0)
+            return;
+
+        sort_instrumentation::Registry& shared{ sort_instrumentation::registry() };
+        std::lock_guard<std::mutex> lock{ shared.mutex };
+        shared.sites[m_id] = nullptr;
+    }
+
+    InstrumentationSite(const InstrumentationSite&) = delete;
+    InstrumentationSite& operator=(const InstrumentationSite&) = delete;
+
+    const std::string& name() const { return m_name; }
+
+    // -1 when there were too many sites already (then nothing is counted for this one)
+    int id() const { return m_id; }
+
+    InstrumentationCounts counts() const
+    {
+        InstrumentationCounts result{};
+        if(m_id < 0)
+            return result;
+
+        sort_instrumentation::Registry& shared{ sort_instrumentation::registry() };
+        std::lock_guard<std::mutex> lock{ shared.mutex };
+        return countsLocked(shared);
+    }
+
+    // counts(), for when the registry's mutex is locked already
+    InstrumentationCounts countsLocked(sort_instrumentation::Registry& shared) const
+    {
+        namespace si = sort_instrumentation;
+
+        std::uint64_t totals[si::counterKinds]{};
+        for(int kind{ 0 }; kind < si::counterKinds; ++kind)
+            totals[kind] = shared.ended[m_id][kind];
+
+        for(si::ThreadCounters* thread{ shared.threads }; thread; thread = thread->next)
+        {
+            for(int kind{ 0 }; kind < si::counterKinds; ++kind)
+                totals[kind] += thread->counts[m_id][kind].load(std::memory_order_relaxed);
+        }
+
+        return { totals[si::comparisons], totals[si::comparisonsTrue], totals[si::swaps] };
+    }
+
+private:
+    std::string m_name{};
+    int m_id{ -1 };
+};
+
+template <typename Compare>
+class InstrumentedCompare
+{
+public:
+    InstrumentedCompare(const InstrumentationSite& site, Compare comparisonFcn)
+        : m_site{ site.id() }, m_comparisonFcn{ comparisonFcn }
+    {
+    }
+
+    template <typename A, typename B>
+    bool operator()(A&& a, B&& b) const
+    {
+        bool result{ static_cast<bool>(m_comparisonFcn(std::forward<A>(a), std::forward<B>(b))) };
+        sort_instrumentation::addComparison(m_site, result);
+
+        return result;
+    }
+
+private:
+    int m_site;
+    mutable Compare m_comparisonFcn; // a mutable lambda can be wrapped too
+};
+
+template <typename Swap>
+class InstrumentedSwap
+{
+public:
+    InstrumentedSwap(const InstrumentationSite& site, Swap swapFcn)
+        : m_site{ site.id() }, m_swapFcn{ swapFcn }
+    {
+    }
+
+    template <typename T>
+    void operator()(T& a, T& b) const
+    {
+        sort_instrumentation::addSwap(m_site);
+        m_swapFcn(a, b);
+    }
+
+private:
+    int m_site;
+    mutable Swap m_swapFcn;
+};
+
+template <typename Compare>
+InstrumentedCompare<Compare> instrumentCompare(const InstrumentationSite& site, Compare comparisonFcn)
+{
+    return { site, comparisonFcn };
+}
+
+template <typename Swap = sort_instrumentation::StdSwap>
+InstrumentedSwap<Swap> instrumentSwap(const InstrumentationSite& site, Swap swapFcn = {})
+{
+    return { site, swapFcn };
+}
+
+inline void printInstrumentation(std::FILE* out = stderr)
+{
+    sort_instrumentation::Registry& shared{ sort_instrumentation::registry() };
+    std::lock_guard<std::mutex> lock{ shared.mutex };
+    for(int id{ 0 }; id < shared.siteCount; ++id)
+    {
+        if(const InstrumentationSite* site{ shared.sites[id] })
+            sort_instrumentation::print(out, site->name(), site->countsLocked(shared));
+    }
+}
+
+#else
+
+// without SORT_INSTRUMENTATION: nothing is counted, and the wrappers are the functions they wrap
+class InstrumentationSite
+{
+public:
+    explicit InstrumentationSite(std::string name)
+        : m_name{ std::move(name) }
+    {
+    }
+
+    InstrumentationSite(const InstrumentationSite&) = delete;
+    InstrumentationSite& operator=(const InstrumentationSite&) = delete;
+
+    const std::string& name() const { return m_name; }
+    int id() const { return -1; }
+    InstrumentationCounts counts() const { return {}; }
+
+private:
+    std::string m_name{};
+};
+
+template <typename Compare>
+Compare instrumentCompare(const InstrumentationSite&, Compare comparisonFcn)
+{
+    return comparisonFcn;
+}
+
+template <typename Swap = sort_instrumentation::StdSwap>
+Swap instrumentSwap(const InstrumentationSite&, Swap swapFcn = {})
+{
+    return swapFcn;
+}
+
+inline void printInstrumentation(std::FILE* = stderr)
+{
+}
+
+#endif
+
+#endif
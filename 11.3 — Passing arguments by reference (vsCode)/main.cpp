@@ -1,6 +1,7 @@
 #include <iostream>
 #include <cmath> // for std::sin() and std::cos()
 #include <string>
+#include "sincos_batch.h" // for the batch getSinCos
 
 //To pass a variable by reference, we simply declare the function parameters as references rather than as normal variables:
 void addOne(int& ref)// ref is a reference variable
@@ -109,6 +110,21 @@ int main()
     std::cout << "The sin is " << sin << '\n';
     std::cout << "The cos is " << cos << '\n';
 
+    /*
+    When there are a lot of angles, the batch version of getSinCos() (see sincos_batch.h) takes arrays instead: the angles
+    as input, and two arrays as out parameters that it fills in. It works on several angles at once and reduces the angles
+    in degrees, so even very large angles come out exact.
+    */
+    double angles[]{ 0.0, 30.0, 45.0, 90.0, 180.0, -270.0, 1e15 + 30.0 };
+    constexpr std::size_t angleCount{ sizeof(angles) / sizeof(angles[0]) };
+    double sins[angleCount]{};
+    double coss[angleCount]{};
+
+    getSinCos(angles, sins, coss, angleCount);
+
+    for(std::size_t i{ 0 }; i < angleCount; ++i)
+        std::cout << "getSinCos(" << angles[i] << "): sin " << sins[i] << ", cos " << coss[i] << '\n';
+
     /*
     This function takes one parameter (by value) as input, and “returns” two parameters (by reference) as output. Parameters that 
     are only used for returning values back to the caller are called out parameters. We’ve named these out parameters with the 
@@ -0,0 +1,291 @@
+#ifndef SINCOS_BATCH_H
+#define SINCOS_BATCH_H
+
+#include <cmath> // for std::sin, std::cos, std::fmod, std::nearbyint
+#include <cstddef> // for std::size_t
+#include <limits> // for std::numeric_limits
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64)
+#include <immintrin.h>
+#if defined(__GNUC__)
+#define SINCOS_BATCH_HAS_AVX2 1
+#endif
+#endif
+
+/*
+Batch version of getSinCos(): the sine and cosine of a whole array of angles in degrees.
+
+getSinCos(degrees, sinOut, cosOut) converts one angle to radians and calls std::sin() and std::cos() separately.
+The batch version works on arrays and writes the results to two separate output arrays, which lets it process 4 angles
+at once with AVX2 (picked at run time) and compute the sine and the cosine from the same polynomial work:
+
+  - range reduction happens in degrees: the angle is split into a multiple of 90 degrees (the quadrant) and a rest
+    between -45 and 45 degrees. For degrees that subtraction is exact, unlike taking an angle in radians modulo pi/2,
+    so even huge angles like 1e15 degrees come out right,
+  - the rest is turned into radians (r * pi/180, with the rounding error of that product carried along),
+  - one pair of polynomials gives sin and cos of the rest, and the quadrant decides which one goes where and the signs.
+
+SinCosAccuracy picks how exact the results are:
+  - libm:     std::sin/std::cos per angle, the same results as getSinCos() (no speedup, for reference),
+  - accurate: within about 1 ulp of the exact result,
+  - fast:     shorter polynomials, absolute error below about 4e-7 (plenty for headings you're going to display).
+*/
+
+enum class SinCosAccuracy
+{
+    libm,
+    accurate,
+    fast,
+};
+
+namespace sincos_batch
+{
+    constexpr double pi{ 3.14159265358979323846 };
+
+    // pi / 180 as the double closest to it, and what's missing from it
+    constexpr double degreesToRadians{ 0.017453292519943295 };
+    constexpr double degreesToRadiansLow{ 2.9486522708701687e-19 };
+
+    // above this, q * 90 is no longer exact in a double, so those angles are reduced with std::fmod first
+    constexpr double largeAngle{ 70368744177664.0 }; // 2^46
+
+    // Taylor coefficients, enough terms for |x| <= pi/4
+    constexpr double sin3{ -1.0 / 6.0 };
+    constexpr double sin5{ 1.0 / 120.0 };
+    constexpr double sin7{ -1.0 / 5040.0 };
+    constexpr double sin9{ 1.0 / 362880.0 };
+    constexpr double sin11{ -1.0 / 39916800.0 };
+    constexpr double sin13{ 1.0 / 6227020800.0 };
+    constexpr double sin15{ -1.0 / 1307674368000.0 };
+    constexpr double sin17{ 1.0 / 355687428096000.0 };
+
+    constexpr double cos4{ 1.0 / 24.0 };
+    constexpr double cos6{ -1.0 / 720.0 };
+    constexpr double cos8{ 1.0 / 40320.0 };
+    constexpr double cos10{ -1.0 / 3628800.0 };
+    constexpr double cos12{ 1.0 / 479001600.0 };
+    constexpr double cos14{ -1.0 / 87178291200.0 };
+    constexpr double cos16{ 1.0 / 20922789888000.0 };
+
+    // x * y as an exact sum high + low (Dekker's algorithm, works without an FMA instruction)
+    inline void twoProduct(double x, double y, double& high, double& low)
+    {
+        constexpr double splitter{ 134217729.0 }; // 2^27 + 1
+
+        double xs{ splitter * x };
+        double xHigh{ xs - (xs - x) };
+        double xLow{ x - xHigh };
+
+        double ys{ splitter * y };
+        double yHigh{ ys - (ys - y) };
+        double yLow{ y - yHigh };
+
+        high = x * y;
+        low = ((xHigh * yHigh - high) + xHigh * yLow + xLow * yHigh) + xLow * yLow;
+    }
+
+    // sin and cos of x (|x| <= pi/4)
+    inline void polynomial(double x, double& s, double& c, bool fast)
+    {
+        double x2{ x * x };
+
+        if(fast)
+        {
+            s = x + x * x2 * (sin3 + x2 * (sin5 + x2 * sin7));
+            c = 1.0 + x2 * (-0.5 + x2 * (cos4 + x2 * (cos6 + x2 * cos8)));
+            return;
+        }
+
+        double sinTail{ sin5 + x2 * (sin7 + x2 * (sin9 + x2 * (sin11 + x2 * (sin13 + x2 * (sin15 + x2 * sin17))))) };
+        double cosTail{ cos6 + x2 * (cos8 + x2 * (cos10 + x2 * (cos12 + x2 * (cos14 + x2 * cos16)))) };
+
+        s = x + x * x2 * (sin3 + x2 * sinTail);
+
+        // 1 - x^2/2 is computed as (1 - h) + ((1 - (1 - h)) - h) to keep the bits that fall off the end of 1 - h
+        double h{ 0.5 * x2 };
+        double w{ 1.0 - h };
+        c = w + (((1.0 - w) - h) + x2 * x2 * (cos4 + x2 * cosTail));
+    }
+
+    inline void scalar(double degrees, double& sinOut, double& cosOut, SinCosAccuracy accuracy)
+    {
+        if(accuracy == SinCosAccuracy::libm)
+        {
+            double radians{ degrees * pi / 180.0 };
+            sinOut = std::sin(radians);
+            cosOut = std::cos(radians);
+            return;
+        }
+
+        if(!std::isfinite(degrees))
+        {
+            sinOut = std::numeric_limits<double>::quiet_NaN();
+            cosOut = sinOut;
+            return;
+        }
+
+        // std::fmod is exact, so huge angles lose nothing here
+        if(std::fabs(degrees) > largeAngle)
+            degrees = std::fmod(degrees, 360.0);
+
+        double q{ std::nearbyint(degrees / 90.0) };
+        double rest{ degrees - q * 90.0 };   // exact
+
+        double x{};
+        double xLow{};
+        twoProduct(rest, degreesToRadians, x, xLow);
+        xLow += rest * degreesToRadiansLow;
+
+        double s{};
+        double c{};
+        polynomial(x, s, c, accuracy == SinCosAccuracy::fast);
+
+        // sin(x + xLow) ~ sin(x) + xLow*cos(x), cos(x + xLow) ~ cos(x) - xLow*sin(x)
+        if(accuracy == SinCosAccuracy::accurate)
+        {
+            double sCorrected{ s + xLow * c };
+            c = c - xLow * s;
+            s = sCorrected;
+        }
+
+        // put the quadrant back: sin(r + 90q) and cos(r + 90q)
+        long long quadrant{ static_cast<long long>(q) & 3 };
+        switch(quadrant)
+        {
+        case 0: sinOut = s;     cosOut = c;     break;
+        case 1: sinOut = c;     cosOut = -s;    break;
+        case 2: sinOut = -s;    cosOut = -c;    break;
+        default: sinOut = -c;   cosOut = s;     break;
+        }
+    }
+
+#if defined(SINCOS_BATCH_HAS_AVX2)
+
+    inline bool cpuHasAvx2Fma()
+    {
+        static const bool has{ __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma") };
+        return has;
+    }
+
+    __attribute__((target("avx2,fma"))) inline void avx2(const double* degrees, double* sinOut, double* cosOut,
+                                                          std::size_t count, bool fast)
+    {
+        const __m256d ninety{ _mm256_set1_pd(90.0) };
+        const __m256d invNinety{ _mm256_set1_pd(1.0 / 90.0) };
+        const __m256d toRadians{ _mm256_set1_pd(degreesToRadians) };
+        const __m256d toRadiansLow{ _mm256_set1_pd(degreesToRadiansLow) };
+        const __m256d signBit{ _mm256_set1_pd(-0.0) };
+        const __m256d large{ _mm256_set1_pd(largeAngle) };
+        const __m256i one{ _mm256_set1_epi64x(1) };
+        const __m256i two{ _mm256_set1_epi64x(2) };
+
+        std::size_t i{ 0 };
+        for(; i + 4 <= count; i += 4)
+        {
+            __m256d d{ _mm256_loadu_pd(degrees + i) };
+
+            // huge (or infinite or NaN) angles go through the scalar code
+            __m256d absolute{ _mm256_andnot_pd(signBit, d) };
+            if(_mm256_movemask_pd(_mm256_cmp_pd(absolute, large, _CMP_NLE_UQ)) != 0)
+            {
+                for(std::size_t lane{ 0 }; lane < 4; ++lane)
+                    scalar(degrees[i + lane], sinOut[i + lane], cosOut[i + lane],
+                           fast ? SinCosAccuracy::fast : SinCosAccuracy::accurate);
+                continue;
+            }
+
+            __m256d q{ _mm256_round_pd(_mm256_mul_pd(d, invNinety), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC) };
+            __m256d rest{ _mm256_fnmadd_pd(q, ninety, d) };  // exact
+
+            __m256d x{ _mm256_mul_pd(rest, toRadians) };
+            __m256d x2{ _mm256_mul_pd(x, x) };
+
+            __m256d s{};
+            __m256d c{};
+
+            if(fast)
+            {
+                __m256d sp{ _mm256_fmadd_pd(x2, _mm256_set1_pd(sin7), _mm256_set1_pd(sin5)) };
+                sp = _mm256_fmadd_pd(x2, sp, _mm256_set1_pd(sin3));
+                s = _mm256_fmadd_pd(_mm256_mul_pd(x, x2), sp, x);
+
+                __m256d cp{ _mm256_fmadd_pd(x2, _mm256_set1_pd(cos8), _mm256_set1_pd(cos6)) };
+                cp = _mm256_fmadd_pd(x2, cp, _mm256_set1_pd(cos4));
+                cp = _mm256_fmadd_pd(x2, cp, _mm256_set1_pd(-0.5));
+                c = _mm256_fmadd_pd(x2, cp, _mm256_set1_pd(1.0));
+            }
+            else
+            {
+                // the rounding error of rest * pi/180
+                __m256d xLow{ _mm256_fmadd_pd(rest, toRadiansLow, _mm256_fmsub_pd(rest, toRadians, x)) };
+
+                __m256d sp{ _mm256_fmadd_pd(x2, _mm256_set1_pd(sin17), _mm256_set1_pd(sin15)) };
+                sp = _mm256_fmadd_pd(x2, sp, _mm256_set1_pd(sin13));
+                sp = _mm256_fmadd_pd(x2, sp, _mm256_set1_pd(sin11));
+                sp = _mm256_fmadd_pd(x2, sp, _mm256_set1_pd(sin9));
+                sp = _mm256_fmadd_pd(x2, sp, _mm256_set1_pd(sin7));
+                sp = _mm256_fmadd_pd(x2, sp, _mm256_set1_pd(sin5));
+                sp = _mm256_fmadd_pd(x2, sp, _mm256_set1_pd(sin3));
+                s = _mm256_fmadd_pd(_mm256_mul_pd(x, x2), sp, x);
+
+                __m256d cp{ _mm256_fmadd_pd(x2, _mm256_set1_pd(cos16), _mm256_set1_pd(cos14)) };
+                cp = _mm256_fmadd_pd(x2, cp, _mm256_set1_pd(cos12));
+                cp = _mm256_fmadd_pd(x2, cp, _mm256_set1_pd(cos10));
+                cp = _mm256_fmadd_pd(x2, cp, _mm256_set1_pd(cos8));
+                cp = _mm256_fmadd_pd(x2, cp, _mm256_set1_pd(cos6));
+                cp = _mm256_fmadd_pd(x2, cp, _mm256_set1_pd(cos4));
+
+                __m256d h{ _mm256_mul_pd(_mm256_set1_pd(0.5), x2) };
+                __m256d w{ _mm256_sub_pd(_mm256_set1_pd(1.0), h) };
+                __m256d lost{ _mm256_sub_pd(_mm256_sub_pd(_mm256_set1_pd(1.0), w), h) };
+                c = _mm256_add_pd(w, _mm256_fmadd_pd(_mm256_mul_pd(x2, x2), cp, lost));
+
+                __m256d sCorrected{ _mm256_fmadd_pd(xLow, c, s) };
+                c = _mm256_fnmadd_pd(xLow, s, c);
+                s = sCorrected;
+            }
+
+            // quadrant: odd quadrants swap sin and cos, sin is negative in quadrants 2 and 3, cos in 1 and 2
+            // (q can be far bigger than an int, q mod 4 is worked out in doubles first, exactly)
+            __m256d qMod4{ _mm256_fnmadd_pd(_mm256_set1_pd(4.0),
+                                            _mm256_round_pd(_mm256_mul_pd(q, _mm256_set1_pd(0.25)), _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC),
+                                            q) };
+            __m256i quadrant{ _mm256_cvtepi32_epi64(_mm256_cvtpd_epi32(qMod4)) };
+            __m256d swap{ _mm256_castsi256_pd(_mm256_cmpeq_epi64(_mm256_and_si256(quadrant, one), one)) };
+            __m256d sinNegative{ _mm256_castsi256_pd(_mm256_cmpeq_epi64(_mm256_and_si256(quadrant, two), two)) };
+            __m256i nextQuadrant{ _mm256_add_epi64(quadrant, one) };
+            __m256d cosNegative{ _mm256_castsi256_pd(_mm256_cmpeq_epi64(_mm256_and_si256(nextQuadrant, two), two)) };
+
+            __m256d sinResult{ _mm256_blendv_pd(s, c, swap) };
+            __m256d cosResult{ _mm256_blendv_pd(c, s, swap) };
+            sinResult = _mm256_xor_pd(sinResult, _mm256_and_pd(sinNegative, signBit));
+            cosResult = _mm256_xor_pd(cosResult, _mm256_and_pd(cosNegative, signBit));
+
+            _mm256_storeu_pd(sinOut + i, sinResult);
+            _mm256_storeu_pd(cosOut + i, cosResult);
+        }
+
+        for(; i < count; ++i)
+            scalar(degrees[i], sinOut[i], cosOut[i], fast ? SinCosAccuracy::fast : SinCosAccuracy::accurate);
+    }
+
+#endif
+}
+
+// sinOut[i] and cosOut[i] are the sine and cosine of degrees[i], for i from 0 to count-1
+inline void getSinCos(const double* degrees, double* sinOut, double* cosOut, std::size_t count,
+                      SinCosAccuracy accuracy = SinCosAccuracy::accurate)
+{
+#if defined(SINCOS_BATCH_HAS_AVX2)
+    if(accuracy != SinCosAccuracy::libm && sincos_batch::cpuHasAvx2Fma())
+    {
+        sincos_batch::avx2(degrees, sinOut, cosOut, count, accuracy == SinCosAccuracy::fast);
+        return;
+    }
+#endif
+
+    for(std::size_t i{ 0 }; i < count; ++i)
+        sincos_batch::scalar(degrees[i], sinOut[i], cosOut[i], accuracy);
+}
+
+#endif
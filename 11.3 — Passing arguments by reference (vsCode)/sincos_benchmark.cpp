@@ -0,0 +1,133 @@
+#include <iostream>
+#include <cmath> // for std::sin() and std::cos()
+#include <chrono> // for std::chrono::steady_clock
+#include <random> // for std::mt19937
+#include <vector>
+#include "sincos_batch.h" // for the batch getSinCos
+
+/*
+Compares getSinCos() one angle at a time with the batch getSinCos() in each SinCosAccuracy mode,
+and reports the largest error of each against a long double reference.
+Build with optimisations, e.g.:
+
+    g++ -std=c++17 -O2 sincos_benchmark.cpp -o sincos_benchmark
+*/
+
+// getSinCos() from main.cpp, kept here as the baseline
+void getSinCos(double degrees, double& sinOut, double& cosOut)
+{
+    // sin() and cos() take radians, not degrees, so we need to convert
+    constexpr double pi { 3.14159265358979323846 };// the value of pi
+    double radians{ degrees * pi / 180.0 };
+    sinOut = std::sin(radians);
+    cosOut = std::cos(radians);
+}
+
+// keeps the compiler from throwing away results we never look at
+volatile double g_sink{};
+
+// runs fcn repetitions times and returns the nanoseconds per angle
+template <typename Fcn>
+double timeIt(int repetitions, std::size_t count, Fcn fcn)
+{
+    auto start{ std::chrono::steady_clock::now() };
+    for(int i{ 0 }; i < repetitions; ++i)
+        fcn();
+    auto end{ std::chrono::steady_clock::now() };
+
+    return std::chrono::duration<double, std::nano>(end - start).count() / repetitions / static_cast<double>(count);
+}
+
+// sin and cos of degrees in long double, reduced in degrees first so the reference itself doesn't lose digits
+void referenceSinCos(double degrees, long double& sinOut, long double& cosOut)
+{
+    long double rest{ std::fmod(static_cast<long double>(degrees), 360.0L) };
+    long double quadrant{ std::nearbyint(rest / 90.0L) };
+    rest -= quadrant * 90.0L;
+
+    long double radians{ rest * 3.14159265358979323846264338327950288L / 180.0L };
+    long double s{ std::sin(radians) };
+    long double c{ std::cos(radians) };
+
+    switch((static_cast<int>(quadrant) % 4 + 4) % 4)
+    {
+    case 0: sinOut = s;  cosOut = c;  break;
+    case 1: sinOut = c;  cosOut = -s; break;
+    case 2: sinOut = -s; cosOut = -c; break;
+    default: sinOut = -c; cosOut = s; break;
+    }
+}
+
+// largest absolute error of the results against the reference
+double maxError(const std::vector<double>& angles, const std::vector<double>& sins, const std::vector<double>& coss)
+{
+    double worst{ 0.0 };
+    for(std::size_t i{ 0 }; i < angles.size(); ++i)
+    {
+        long double s{};
+        long double c{};
+        referenceSinCos(angles[i], s, c);
+
+        double sinError{ static_cast<double>(std::fabs(sins[i] - s)) };
+        double cosError{ static_cast<double>(std::fabs(coss[i] - c)) };
+        if(sinError > worst)
+            worst = sinError;
+        if(cosError > worst)
+            worst = cosError;
+    }
+
+    return worst;
+}
+
+void run(const char* name, const std::vector<double>& angles)
+{
+    const std::size_t count{ angles.size() };
+    std::vector<double> sins(count);
+    std::vector<double> coss(count);
+
+    constexpr int repetitions{ 20 };
+
+    std::cout << name << " (" << count << " angles):\n";
+
+    double baselineNs{ timeIt(repetitions, count, [&]{
+        for(std::size_t i{ 0 }; i < count; ++i)
+            getSinCos(angles[i], sins[i], coss[i]);
+        g_sink = sins[count / 2];
+    }) };
+    std::cout << "  getSinCos (one at a time): " << baselineNs << " ns/angle, max error "
+              << maxError(angles, sins, coss) << '\n';
+
+    struct Mode { const char* name; SinCosAccuracy accuracy; };
+    for(Mode mode : { Mode{ "libm    ", SinCosAccuracy::libm },
+                      Mode{ "accurate", SinCosAccuracy::accurate },
+                      Mode{ "fast    ", SinCosAccuracy::fast } })
+    {
+        double ns{ timeIt(repetitions, count, [&]{
+            getSinCos(angles.data(), sins.data(), coss.data(), count, mode.accuracy);
+            g_sink = sins[count / 2];
+        }) };
+        std::cout << "  getSinCos (batch, " << mode.name << "): " << ns << " ns/angle, max error "
+                  << maxError(angles, sins, coss) << '\n';
+    }
+}
+
+int main()
+{
+    constexpr std::size_t count{ 1'000'000 };
+    std::mt19937 mt{ 20 };
+
+    std::vector<double> headings(count);
+    std::uniform_real_distribution<double> circle{ -360.0, 360.0 };
+    for(double& angle : headings)
+        angle = circle(mt);
+
+    std::vector<double> large(count);
+    std::uniform_real_distribution<double> far{ -1e12, 1e12 };
+    for(double& angle : large)
+        angle = far(mt);
+
+    run("angles between -360 and 360", headings);
+    run("angles up to 1e12", large);
+
+    return 0;
+}
@@ -0,0 +1,372 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <algorithm> // for std::max
+#include <cassert> // for assert
+#include <cstddef> // for std::size_t, std::max_align_t
+#include <memory_resource> // for std::pmr::memory_resource, std::pmr::new_delete_resource
+#include <new> // for placement new, std::align_val_t
+#include <utility> // for std::exchange
+#include <vector>
+
+/*
+Arrays that give their memory back by themselves, from an arena or a pool instead of new[].
+
+allotaceArray(size) in main.cpp returns new int[size], and whoever gets the pointer has to remember delete[]. Called
+thousands of times, every one of those is a trip through the general purpose heap (which has to find a fitting piece
+of memory, and splits and merges them, so the heap gets fragmented). Here:
+
+  - ArraySpan<T> is an array of count elements that owns its memory, like a std::unique_ptr<T[]> that knows its size.
+    It can only be moved, not copied, and when it goes out of scope the elements are destroyed and the memory goes back
+    to where it came from. The memory is aligned to at least alignof(T), or to more if asked for (e.g. 64 bytes, a cache
+    line, for SIMD loads). Like new T[count], the elements are default-initialized (so ints are not set to 0).
+
+  - MonotonicArena hands out memory by moving a pointer forward through big blocks (64 KB unless told otherwise), and
+    never frees anything on its own. Giving memory back does nothing. reset() starts again at the beginning of the first
+    block, in O(1): the blocks are kept, so the next round (e.g. the next request) doesn't allocate anything from the
+    heap once the arena has grown big enough. No ArraySpan from the arena may still be around at reset() (asserted in
+    debug builds).
+
+  - SizeClassPool rounds sizes up to a power of two, from 16 to 4096 bytes (the size classes), and keeps a free list for
+    each of them, so memory that comes back is handed out again for the next array of the same class. New slots are cut
+    from 64 KB chunks. Larger arrays, and alignments above 64 bytes, go straight to operator new.
+
+Both are a std::pmr::memory_resource, so they also work with std::pmr::vector and the other std::pmr containers, and
+an ArraySpan can use any std::pmr::memory_resource (std::pmr::new_delete_resource() is plain operator new and delete).
+Neither is thread safe: use one per thread (or per request).
+*/
+
+template <typename T>
+class ArraySpan
+{
+public:
+    ArraySpan() = default;
+
+    // count elements from resource, aligned to alignment bytes (a power of two, at least alignof(T) is used)
+    ArraySpan(std::pmr::memory_resource& resource, std::size_t count, std::size_t alignment = alignof(T))
+        : m_resource{ &resource }, m_alignment{ std::max(alignment, alignof(T)) }
+    {
+        assert((m_alignment & (m_alignment - 1)) == 0 && "the alignment has to be a power of two");
+
+        if(count == 0)
+            return;
+
+        T* data{ static_cast<T*>(resource.allocate(count * sizeof(T), m_alignment)) };
+
+        std::size_t constructed{ 0 };
+        try
+        {
+            for(; constructed < count; ++constructed)
+                ::new(static_cast<void*>(data + constructed)) T;
+        }
+        catch(...)
+        {
+            while(constructed > 0)
+                data[--constructed].~T();
+            resource.deallocate(data, count * sizeof(T), m_alignment);
+            throw;
+        }
+
+        m_data = data;
+        m_size = count;
+    }
+
+    ArraySpan(ArraySpan&& other) noexcept
+        : m_resource{ other.m_resource }, m_data{ std::exchange(other.m_data, nullptr) },
+          m_size{ std::exchange(other.m_size, 0) }, m_alignment{ other.m_alignment }
+    {
+    }
+
+    ArraySpan& operator=(ArraySpan&& other) noexcept
+    {
+        if(this != &other)
+        {
+            reset();
+            m_resource = other.m_resource;
+            m_data = std::exchange(other.m_data, nullptr);
+            m_size = std::exchange(other.m_size, 0);
+            m_alignment = other.m_alignment;
+        }
+
+        return *this;
+    }
+
+    ArraySpan(const ArraySpan&) = delete;
+    ArraySpan& operator=(const ArraySpan&) = delete;
+
+    ~ArraySpan()
+    {
+        reset();
+    }
+
+    // destroys the elements and gives the memory back now, the span is empty afterwards
+    void reset()
+    {
+        if(!m_data)
+            return;
+
+        for(std::size_t i{ m_size }; i > 0; --i)
+            m_data[i - 1].~T();
+        m_resource->deallocate(m_data, m_size * sizeof(T), m_alignment);
+
+        m_data = nullptr;
+        m_size = 0;
+    }
+
+    T* data() { return m_data; }
+    const T* data() const { return m_data; }
+    std::size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+    T& operator[](std::size_t index) { return m_data[index]; }
+    const T& operator[](std::size_t index) const { return m_data[index]; }
+
+    T* begin() { return m_data; }
+    T* end() { return m_data + m_size; }
+    const T* begin() const { return m_data; }
+    const T* end() const { return m_data + m_size; }
+
+private:
+    std::pmr::memory_resource* m_resource{ nullptr };
+    T* m_data{ nullptr };
+    std::size_t m_size{ 0 };
+    std::size_t m_alignment{ alignof(T) };
+};
+
+namespace arena
+{
+    // blocks and chunks are aligned to a cache line, so that 64 byte alignment never needs padding at their start
+    constexpr std::size_t blockAlignment{ 64 };
+
+    inline char* allocateBlock(std::size_t size)
+    {
+        return static_cast<char*>(::operator new(size, std::align_val_t{ blockAlignment }));
+    }
+
+    inline void freeBlock(char* block, std::size_t size)
+    {
+        ::operator delete(block, size, std::align_val_t{ blockAlignment });
+    }
+
+    // position moved up to the next multiple of alignment (a power of two)
+    inline char* alignUp(char* position, std::size_t alignment)
+    {
+        std::size_t address{ reinterpret_cast<std::size_t>(position) };
+        std::size_t padding{ (alignment - (address & (alignment - 1))) & (alignment - 1) };
+        return position + padding;
+    }
+}
+
+class MonotonicArena : public std::pmr::memory_resource
+{
+public:
+    explicit MonotonicArena(std::size_t blockSize = 64 * 1024)
+        : m_blockSize{ blockSize }
+    {
+    }
+
+    MonotonicArena(const MonotonicArena&) = delete;
+    MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+    ~MonotonicArena() override
+    {
+        for(const Block& block : m_blocks)
+            arena::freeBlock(block.data, block.size);
+    }
+
+    // everything handed out so far can be handed out again, the blocks stay
+    void reset()
+    {
+        assert(m_live == 0 && "memory from the arena is still in use");
+
+        m_block = 0;
+        m_position = m_blocks.empty() ? nullptr : m_blocks[0].data;
+        m_end = m_blocks.empty() ? nullptr : m_blocks[0].data + m_blocks[0].size;
+    }
+
+    // bytes in all blocks together
+    std::size_t capacity() const
+    {
+        std::size_t bytes{ 0 };
+        for(const Block& block : m_blocks)
+            bytes += block.size;
+
+        return bytes;
+    }
+
+protected:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        // (the padding for the alignment alone can already go past the end of the block)
+        char* start{ m_position ? arena::alignUp(m_position, alignment) : nullptr };
+        if(!start || start > m_end || static_cast<std::size_t>(m_end - start) < bytes)
+            start = nextBlock(bytes, alignment);
+
+        m_position = start + bytes;
+        ++m_live;
+
+        return start;
+    }
+
+    void do_deallocate(void*, std::size_t, std::size_t) override
+    {
+        // nothing is freed before reset()
+        --m_live;
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+
+private:
+    struct Block
+    {
+        char* data;
+        std::size_t size;
+    };
+
+    // moves on to the next block that has room for bytes, and returns where they go in it
+    char* nextBlock(std::size_t bytes, std::size_t alignment)
+    {
+        // the blocks after the current one are left from before the last reset()
+        std::size_t next{ m_blocks.empty() ? 0 : m_block + 1 };
+        if(next == m_blocks.size() || m_blocks[next].size < bytes + alignment)
+        {
+            // a bigger request than a block gets a block big enough for it. A block from before that is too small is
+            // replaced by that, so the arena doesn't keep collecting blocks from round to round
+            std::size_t size{ std::max(m_blockSize, bytes + alignment) };
+            char* data{ arena::allocateBlock(size) };
+
+            if(next == m_blocks.size())
+                m_blocks.push_back(Block{ data, size });
+            else
+            {
+                arena::freeBlock(m_blocks[next].data, m_blocks[next].size);
+                m_blocks[next] = Block{ data, size };
+            }
+        }
+        m_block = next;
+
+        const Block& block{ m_blocks[m_block] };
+        m_end = block.data + block.size;
+
+        return arena::alignUp(block.data, alignment);
+    }
+
+    std::size_t m_blockSize{};
+    std::vector<Block> m_blocks{};
+    std::size_t m_block{ 0 };       // the block m_position is in
+    char* m_position{ nullptr };    // where the next allocation starts
+    char* m_end{ nullptr };         // the end of the current block
+    std::size_t m_live{ 0 };        // allocations not given back yet
+};
+
+class SizeClassPool : public std::pmr::memory_resource
+{
+public:
+    static constexpr std::size_t smallestClass{ 16 };
+    static constexpr std::size_t largestClass{ 4096 };
+    static constexpr std::size_t chunkSize{ 64 * 1024 };
+
+    SizeClassPool() = default;
+
+    SizeClassPool(const SizeClassPool&) = delete;
+    SizeClassPool& operator=(const SizeClassPool&) = delete;
+
+    ~SizeClassPool() override
+    {
+        for(char* chunk : m_chunks)
+            arena::freeBlock(chunk, chunkSize);
+    }
+
+protected:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        std::size_t index{ classIndex(bytes, alignment) };
+        if(index == noClass)
+            return ::operator new(bytes, std::align_val_t{ alignment });
+
+        SizeClass& sizeClass{ m_classes[index] };
+
+        // memory that came back first, it's probably still in the cache
+        if(sizeClass.freeList)
+        {
+            FreeSlot* slot{ sizeClass.freeList };
+            sizeClass.freeList = slot->next;
+            return slot;
+        }
+
+        const std::size_t slotSize{ smallestClass << index };
+        if(sizeClass.position == sizeClass.end)
+        {
+            m_chunks.reserve(m_chunks.size() + 1);
+            char* chunk{ arena::allocateBlock(chunkSize) };
+            m_chunks.push_back(chunk);
+
+            sizeClass.position = chunk;
+            sizeClass.end = chunk + chunkSize;
+        }
+
+        // the chunk starts 64 byte aligned and the slots are a power of two big, so each slot is aligned to its size
+        // (or to 64 bytes, whichever is less)
+        void* slot{ sizeClass.position };
+        sizeClass.position += slotSize;
+
+        return slot;
+    }
+
+    void do_deallocate(void* memory, std::size_t bytes, std::size_t alignment) override
+    {
+        std::size_t index{ classIndex(bytes, alignment) };
+        if(index == noClass)
+        {
+            ::operator delete(memory, bytes, std::align_val_t{ alignment });
+            return;
+        }
+
+        FreeSlot* slot{ ::new(memory) FreeSlot{ m_classes[index].freeList } };
+        m_classes[index].freeList = slot;
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+
+private:
+    static constexpr std::size_t classCount{ 9 }; // 16, 32, ... 4096
+    static constexpr std::size_t noClass{ static_cast<std::size_t>(-1) };
+
+    // a slot on a free list keeps the pointer to the next free slot in its first bytes
+    struct FreeSlot
+    {
+        FreeSlot* next;
+    };
+
+    struct SizeClass
+    {
+        FreeSlot* freeList{ nullptr };
+        char* position{ nullptr }; // the part of the newest chunk that wasn't handed out yet
+        char* end{ nullptr };
+    };
+
+    // the size class for bytes with alignment, noClass if it's too big for the pool
+    static std::size_t classIndex(std::size_t bytes, std::size_t alignment)
+    {
+        if(bytes > largestClass || alignment > arena::blockAlignment)
+            return noClass;
+
+        std::size_t needed{ std::max(bytes, alignment) };
+        std::size_t index{ 0 };
+        while((smallestClass << index) < needed)
+            ++index;
+
+        return index;
+    }
+
+    SizeClass m_classes[classCount]{};
+    std::vector<char*> m_chunks{};
+};
+
+#endif
@@ -0,0 +1,147 @@
+#include <iostream>
+#include <chrono> // for std::chrono::steady_clock
+#include <cstddef> // for std::size_t
+#include <memory_resource> // for std::pmr::monotonic_buffer_resource, std::pmr::unsynchronized_pool_resource
+#include <utility> // for std::move
+#include <vector>
+#include "arena.h" // for ArraySpan, MonotonicArena, SizeClassPool
+
+/*
+Compares new[]/delete[] (allotaceArray() from main.cpp) with ArraySpan from MonotonicArena, SizeClassPool and the
+std::pmr resources, for something like a request handler: every request allocates a few thousand small arrays, frees
+some of them right away and the rest at the end of the request.
+
+    g++ -std=c++17 -O2 arena_benchmark.cpp -o arena_benchmark
+*/
+
+// allotaceArray() from main.cpp, kept here as the baseline
+int* allotaceArray(int size)
+{
+    return new int[size];
+}
+
+template <typename Fcn>
+double timeIt(Fcn fcn)
+{
+    auto start{ std::chrono::steady_clock::now() };
+    fcn();
+    auto end{ std::chrono::steady_clock::now() };
+
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+constexpr int requests{ 2'000 };
+constexpr int arraysPerRequest{ 2'000 };
+
+// the same sizes for every run: 4 ... 515 ints, from a simple LCG
+std::vector<int> makeSizes()
+{
+    std::vector<int> sizes(arraysPerRequest);
+    unsigned state{ 12345 };
+    for(int& size : sizes)
+    {
+        state = state * 1664525u + 1013904223u;
+        size = 4 + static_cast<int>((state >> 16) % 512);
+    }
+
+    return sizes;
+}
+
+long long runNewDelete(const std::vector<int>& sizes)
+{
+    long long sum{ 0 };
+    std::vector<int*> kept{};
+    kept.reserve(sizes.size());
+
+    for(int request{ 0 }; request < requests; ++request)
+    {
+        for(std::size_t i{ 0 }; i < sizes.size(); ++i)
+        {
+            int* array{ allotaceArray(sizes[i]) };
+            array[0] = request;
+            array[sizes[i] - 1] = static_cast<int>(i);
+            sum += array[0] + array[sizes[i] - 1];
+
+            // every third array is only needed for a moment
+            if(i % 3 == 0)
+                delete[] array;
+            else
+                kept.push_back(array);
+        }
+
+        for(int* array : kept)
+            delete[] array;
+        kept.clear();
+    }
+
+    return sum;
+}
+
+// the same with ArraySpan from resource; reset() is called after every request
+template <typename Reset>
+long long runSpans(std::pmr::memory_resource& resource, const std::vector<int>& sizes, Reset reset)
+{
+    long long sum{ 0 };
+    std::vector<ArraySpan<int>> kept{};
+    kept.reserve(sizes.size());
+
+    for(int request{ 0 }; request < requests; ++request)
+    {
+        for(std::size_t i{ 0 }; i < sizes.size(); ++i)
+        {
+            ArraySpan<int> array{ resource, static_cast<std::size_t>(sizes[i]) };
+            array[0] = request;
+            array[array.size() - 1] = static_cast<int>(i);
+            sum += array[0] + array[array.size() - 1];
+
+            if(i % 3 != 0)
+                kept.push_back(std::move(array));
+        }
+
+        kept.clear();
+        reset();
+    }
+
+    return sum;
+}
+
+int main()
+{
+    const std::vector<int> sizes{ makeSizes() };
+    long long expected{ 0 };
+    long long sum{ 0 };
+
+    auto report{ [&](const char* name, double ms){
+        std::cout << name << ms << " ms" << (sum == expected ? "" : " (DIFFERENT RESULT)") << '\n';
+    } };
+
+    std::cout << requests << " requests of " << arraysPerRequest << " arrays\n";
+
+    double ms{ timeIt([&]{ expected = runNewDelete(sizes); }) };
+    sum = expected;
+    report("new[]/delete[]:                       ", ms);
+
+    ms = timeIt([&]{ sum = runSpans(*std::pmr::new_delete_resource(), sizes, []{}); });
+    report("ArraySpan, new_delete_resource:       ", ms);
+
+    MonotonicArena arena{};
+    ms = timeIt([&]{ sum = runSpans(arena, sizes, [&]{ arena.reset(); }); });
+    report("ArraySpan, MonotonicArena:            ", ms);
+
+    // release() gives the memory back to the heap, so every request starts with new blocks again
+    std::pmr::monotonic_buffer_resource monotonic{};
+    ms = timeIt([&]{ sum = runSpans(monotonic, sizes, [&]{ monotonic.release(); }); });
+    report("ArraySpan, monotonic_buffer_resource: ", ms);
+
+    SizeClassPool pool{};
+    ms = timeIt([&]{ sum = runSpans(pool, sizes, []{}); });
+    report("ArraySpan, SizeClassPool:             ", ms);
+
+    std::pmr::unsynchronized_pool_resource stdPool{};
+    ms = timeIt([&]{ sum = runSpans(stdPool, sizes, []{}); });
+    report("ArraySpan, unsynchronized_pool:       ", ms);
+
+    std::cout << "arena blocks: " << arena.capacity() / 1024 << " KB\n";
+
+    return 0;
+}
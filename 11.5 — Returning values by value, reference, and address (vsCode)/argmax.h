@@ -0,0 +1,242 @@
+#ifndef ARGMAX_H
+#define ARGMAX_H
+
+#include <algorithm> // for std::min
+#include <climits> // for INT_MIN
+#include <cstddef> // for std::size_t
+#include <vector>
+#include "../11.13 — Introduction to lambdas (anonymous functions) (vsCode)/parallel_for.h" // for parallel_repeat, ThreadPool
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#include <immintrin.h>
+#define ARGMAX_HAS_X86 1
+#endif
+
+#if defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define ARGMAX_HAS_NEON 1
+#endif
+
+/*
+The index of the largest value, for arrays of hundreds of millions of ints.
+
+argmax(values, count) returns the index of the largest value. When the largest value is there more than once, the
+first index wins, like std::max_element. For count 0 it returns count (there is no largest value).
+
+The array is looked at in blocks of 4096 ints (16 KB, they stay in the L1 cache):
+  - the largest value of every block is found with SIMD: AVX-512 (64 ints per step) or AVX2 (32 ints per step), picked
+    at run time from what the CPU can do, or NEON on 64 bit ARM (16 ints per step). Anything else uses a plain loop,
+  - a block only counts if its largest value is bigger than the largest one so far, so at the end the first block that
+    has the largest value is known, and only that one block is looked at again, int by int, for the first index.
+So the array is read once, and the work per int is a single (vector) max.
+
+From 4 million ints on, the array is split into one part per thread (parallel_repeat() from 11.13), every thread finds
+the largest value of its part, and the parts are compared in order (so the first index still wins). threadCount 0 uses
+all cores. Going through memory this fast, one thread is often already limited by how fast memory can be read, so more
+threads mostly help on machines with several memory channels.
+*/
+
+namespace argmax_kernel
+{
+    constexpr std::size_t blockSize{ 4096 };
+    constexpr std::size_t valuesPerThread{ 1 << 22 };
+
+    using BlockMaxFcn = int (*)(const int* values, std::size_t size);
+
+    inline int blockMaxScalar(const int* values, std::size_t size)
+    {
+        int best{ INT_MIN };
+        for(std::size_t i{ 0 }; i < size; ++i)
+            best = (values[i] > best) ? values[i] : best;
+
+        return best;
+    }
+
+#if defined(ARGMAX_HAS_X86)
+    __attribute__((target("avx2"))) inline int blockMaxAvx2(const int* values, std::size_t size)
+    {
+        // 4 independent maximums of 8 ints each, so the vpmaxsd's don't wait for each other
+        __m256i best0{ _mm256_set1_epi32(INT_MIN) };
+        __m256i best1{ best0 };
+        __m256i best2{ best0 };
+        __m256i best3{ best0 };
+
+        std::size_t i{ 0 };
+        for(; i + 32 <= size; i += 32)
+        {
+            best0 = _mm256_max_epi32(best0, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i)));
+            best1 = _mm256_max_epi32(best1, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i + 8)));
+            best2 = _mm256_max_epi32(best2, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i + 16)));
+            best3 = _mm256_max_epi32(best3, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i + 24)));
+        }
+
+        __m256i best{ _mm256_max_epi32(_mm256_max_epi32(best0, best1), _mm256_max_epi32(best2, best3)) };
+        __m128i half{ _mm_max_epi32(_mm256_castsi256_si128(best), _mm256_extracti128_si256(best, 1)) };
+        half = _mm_max_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(1, 0, 3, 2)));
+        half = _mm_max_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(2, 3, 0, 1)));
+
+        int rest{ blockMaxScalar(values + i, size - i) };
+        int vectorBest{ _mm_cvtsi128_si32(half) };
+
+        return (rest > vectorBest) ? rest : vectorBest;
+    }
+
+    // gcc 12 warns about the _mm512_undefined_epi32() inside its own _mm512_max_epi32(), which isn't a problem here
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+    __attribute__((target("avx512f"))) inline int blockMaxAvx512(const int* values, std::size_t size)
+    {
+        __m512i best0{ _mm512_set1_epi32(INT_MIN) };
+        __m512i best1{ best0 };
+        __m512i best2{ best0 };
+        __m512i best3{ best0 };
+
+        std::size_t i{ 0 };
+        for(; i + 64 <= size; i += 64)
+        {
+            best0 = _mm512_max_epi32(best0, _mm512_loadu_si512(values + i));
+            best1 = _mm512_max_epi32(best1, _mm512_loadu_si512(values + i + 16));
+            best2 = _mm512_max_epi32(best2, _mm512_loadu_si512(values + i + 32));
+            best3 = _mm512_max_epi32(best3, _mm512_loadu_si512(values + i + 48));
+        }
+
+        __m512i best{ _mm512_max_epi32(_mm512_max_epi32(best0, best1), _mm512_max_epi32(best2, best3)) };
+
+        int rest{ blockMaxScalar(values + i, size - i) };
+        int vectorBest{ _mm512_reduce_max_epi32(best) };
+
+        return (rest > vectorBest) ? rest : vectorBest;
+    }
+#pragma GCC diagnostic pop
+#endif
+
+#if defined(ARGMAX_HAS_NEON)
+    inline int blockMaxNeon(const int* values, std::size_t size)
+    {
+        int32x4_t best0{ vdupq_n_s32(INT_MIN) };
+        int32x4_t best1{ best0 };
+        int32x4_t best2{ best0 };
+        int32x4_t best3{ best0 };
+
+        std::size_t i{ 0 };
+        for(; i + 16 <= size; i += 16)
+        {
+            best0 = vmaxq_s32(best0, vld1q_s32(values + i));
+            best1 = vmaxq_s32(best1, vld1q_s32(values + i + 4));
+            best2 = vmaxq_s32(best2, vld1q_s32(values + i + 8));
+            best3 = vmaxq_s32(best3, vld1q_s32(values + i + 12));
+        }
+
+        int rest{ blockMaxScalar(values + i, size - i) };
+        int vectorBest{ vmaxvq_s32(vmaxq_s32(vmaxq_s32(best0, best1), vmaxq_s32(best2, best3))) };
+
+        return (rest > vectorBest) ? rest : vectorBest;
+    }
+#endif
+
+    // the best kernel this CPU can run, found once
+    inline BlockMaxFcn bestBlockMax()
+    {
+        static const BlockMaxFcn fcn{ []() -> BlockMaxFcn {
+#if defined(ARGMAX_HAS_X86)
+            if(__builtin_cpu_supports("avx512f"))
+                return blockMaxAvx512;
+            if(__builtin_cpu_supports("avx2"))
+                return blockMaxAvx2;
+#elif defined(ARGMAX_HAS_NEON)
+            return blockMaxNeon;
+#endif
+            return blockMaxScalar;
+        }() };
+
+        return fcn;
+    }
+
+    // the largest value of a range of blocks, and where the first block that has it starts
+    struct Largest
+    {
+        int value;
+        std::size_t blockBegin;
+    };
+
+    inline Largest largestBlock(const int* values, std::size_t begin, std::size_t end, BlockMaxFcn blockMax)
+    {
+        Largest largest{ blockMax(values + begin, std::min(blockSize, end - begin)), begin };
+
+        for(std::size_t block{ begin + blockSize }; block < end; block += blockSize)
+        {
+            int value{ blockMax(values + block, std::min(blockSize, end - block)) };
+            if(value > largest.value)
+                largest = Largest{ value, block };
+        }
+
+        return largest;
+    }
+
+    // argmax() with a given kernel and number of parts
+    inline std::size_t argmaxWith(const int* values, std::size_t count, unsigned parts, BlockMaxFcn blockMax)
+    {
+        if(count == 0)
+            return count;
+
+        // the parts start at a block, so that the blocks are the same however many parts there are
+        std::size_t blocks{ (count + blockSize - 1) / blockSize };
+        if(parts > blocks)
+            parts = static_cast<unsigned>(blocks);
+
+        auto partBegin{ [&](unsigned part){
+            return std::min(count, static_cast<std::size_t>(static_cast<unsigned long long>(blocks) * part / parts) * blockSize);
+        } };
+
+        Largest largest{};
+        if(parts <= 1)
+            largest = largestBlock(values, 0, count, blockMax);
+        else
+        {
+            std::vector<Largest> results(parts);
+
+            ParallelOptions options{};
+            options.grainSize = 1;
+            parallel_repeat(static_cast<int>(parts), [&](int part){
+                unsigned index{ static_cast<unsigned>(part) };
+                results[index] = largestBlock(values, partBegin(index), partBegin(index + 1), blockMax);
+            }, options);
+
+            // in order, and only a bigger value replaces the one before, so the first part with it wins
+            largest = results[0];
+            for(const Largest& result : results)
+            {
+                if(result.value > largest.value)
+                    largest = result;
+            }
+        }
+
+        std::size_t end{ std::min(largest.blockBegin + blockSize, count) };
+        for(std::size_t i{ largest.blockBegin }; i < end; ++i)
+        {
+            if(values[i] == largest.value)
+                return i;
+        }
+
+        return count; // can't happen, the block has the value
+    }
+
+    inline unsigned partCount(std::size_t count, unsigned threadCount)
+    {
+        if(threadCount == 0)
+            threadCount = ThreadPool::instance().threadCount() + 1;
+
+        std::size_t most{ count / valuesPerThread };
+        return most < 1 ? 1u : static_cast<unsigned>(std::min<std::size_t>(threadCount, most));
+    }
+}
+
+// index of the (first) largest value, count if count is 0 (threadCount 0 uses all cores)
+inline std::size_t argmax(const int* values, std::size_t count, unsigned threadCount = 0)
+{
+    return argmax_kernel::argmaxWith(values, count, argmax_kernel::partCount(count, threadCount),
+                                     argmax_kernel::bestBlockMax());
+}
+
+#endif
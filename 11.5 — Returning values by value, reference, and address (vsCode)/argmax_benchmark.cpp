@@ -0,0 +1,113 @@
+#include <iostream>
+#include <algorithm> // for std::max_element
+#include <chrono> // for std::chrono::steady_clock
+#include <cstddef> // for std::size_t
+#include <vector>
+#include "argmax.h" // for argmax, argmax_kernel
+
+/*
+Compares getIndexOfLargestValue() as it was in main.cpp (which returned the largest value, not its index) with a plain
+correct loop, std::max_element and argmax() with every kernel, for 100 million ints. The throughput is in GB/s of ints
+read.
+
+    g++ -std=c++17 -O2 -pthread argmax_benchmark.cpp -o argmax_benchmark
+*/
+
+// getIndexOfLargestValue() from main.cpp, kept here as the baseline
+int getIndexOfLargestValue_old(const std::vector<int>& array)
+{
+    std::size_t lenght{ array.size() };
+
+    int theBigestIndex{ 0 };
+
+    for(std::size_t i{ 0 }; i < lenght; ++i)
+    {
+        if(array[i] > theBigestIndex)
+        {
+            theBigestIndex = array[i];
+        }
+    }
+
+    return theBigestIndex;
+}
+
+// what the loop should have been
+std::size_t indexOfLargestLoop(const std::vector<int>& array)
+{
+    std::size_t best{ 0 };
+    for(std::size_t i{ 1 }; i < array.size(); ++i)
+    {
+        if(array[i] > array[best])
+            best = i;
+    }
+
+    return best;
+}
+
+template <typename Fcn>
+double timeIt(Fcn fcn)
+{
+    auto start{ std::chrono::steady_clock::now() };
+    fcn();
+    auto end{ std::chrono::steady_clock::now() };
+
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+int main()
+{
+    constexpr std::size_t count{ 100'000'000 };
+
+    // slowly rising with noise, so new largest values keep showing up until the end (the worst case for the loops)
+    std::vector<int> values(count);
+    unsigned state{ 12345 };
+    for(std::size_t i{ 0 }; i < count; ++i)
+    {
+        state = state * 1664525u + 1013904223u;
+        values[i] = static_cast<int>(i / 16) + static_cast<int>((state >> 16) % 1000) - 2'000'000'000;
+    }
+
+    const std::size_t expected{ indexOfLargestLoop(values) };
+    const double gigabytes{ static_cast<double>(count * sizeof(int)) / 1e9 };
+
+    auto report{ [&](const char* name, double ms, bool correct){
+        std::cout << name << ms << " ms, " << gigabytes / (ms / 1000.0) << " GB/s" << (correct ? "" : " (WRONG)") << '\n';
+    } };
+
+    int oldResult{};
+    double ms{ timeIt([&]{ oldResult = getIndexOfLargestValue_old(values); }) };
+    report("old getIndexOfLargestValue: ", ms, oldResult == static_cast<int>(expected));
+
+    std::size_t result{};
+    ms = timeIt([&]{ result = indexOfLargestLoop(values); });
+    report("correct loop:               ", ms, result == expected);
+
+    ms = timeIt([&]{ result = static_cast<std::size_t>(std::max_element(values.begin(), values.end()) - values.begin()); });
+    report("std::max_element:           ", ms, result == expected);
+
+    ms = timeIt([&]{ result = argmax_kernel::argmaxWith(values.data(), count, 1, argmax_kernel::blockMaxScalar); });
+    report("argmax, scalar blocks:      ", ms, result == expected);
+
+#if defined(ARGMAX_HAS_X86)
+    if(__builtin_cpu_supports("avx2"))
+    {
+        ms = timeIt([&]{ result = argmax_kernel::argmaxWith(values.data(), count, 1, argmax_kernel::blockMaxAvx2); });
+        report("argmax, AVX2:               ", ms, result == expected);
+    }
+
+    if(__builtin_cpu_supports("avx512f"))
+    {
+        ms = timeIt([&]{ result = argmax_kernel::argmaxWith(values.data(), count, 1, argmax_kernel::blockMaxAvx512); });
+        report("argmax, AVX-512:            ", ms, result == expected);
+    }
+#endif
+
+    ms = timeIt([&]{ result = argmax(values.data(), count, 1); });
+    report("argmax, 1 thread:           ", ms, result == expected);
+
+    ms = timeIt([&]{ result = argmax(values.data(), count); });
+    report("argmax, all threads:        ", ms, result == expected);
+    std::cout << "(all threads is " << ThreadPool::instance().threadCount() + 1 << " here)\n";
+
+    return 0;
+}
@@ -1,16 +1,26 @@
 #include <iostream>
 #include <array>
 #include <tuple>
+#include <optional>
 #include  <string>
+#include <string_view>
 #include <utility> // for std::pair
 #include <vector>
+#include "arena.h" // for ArraySpan, MonotonicArena, SizeClassPool
+#include "argmax.h" // for argmax
+#include "string_pool.h" // for StringPool, StringId
+#include "../11.8 — The stack and the heap (vsCode)/alloc_tracking.h" // for AllocationScope
+#include "../11.6 — Inline functions (vsCode)/constexpr_math.h" // for constexpr_math::sumTo
+#include "../11.13 — Introduction to lambdas (anonymous functions) (vsCode)/record_file.h" // for RecordWriter, RecordFile
+#include <cstdio> // for std::remove
 
 //function protytypes for Quiz time:
-int sumTo(int);
+long long sumTo(int);
 void printEmployeeName(const struct Employee& emp);
 std::pair<int, int> minmax(int,int);
 int getIndexOfLargestValue(const std::vector<int>& array);
 const std::string& getElement(const std::vector<std::string>& vec_str, std::size_t index);
+std::optional<std::string_view> findElement(const std::vector<std::string>& vec_str, std::size_t index);
 
 int doubleValue(int x)
 {
@@ -24,6 +34,12 @@ int* allotaceArray(int size)
     return new int[size];
 }
 
+// like allotaceArray(), but the array comes from resource (e.g. an arena) and gives its memory back by itself
+ArraySpan<int> allocateArray(std::pmr::memory_resource& resource, int size)
+{
+    return ArraySpan<int>{ resource, static_cast<std::size_t>(size) };
+}
+
 // Returns a reference to the index element of array
 int& getElement(std::array<int, 25>& array, int index)
 {
@@ -76,6 +92,34 @@ struct Employee
     std::string name;
 };
 
+// how S and Employee are stored in a record file (see record_file.h in 11.13)
+template <>
+struct RecordLayout<S>
+{
+    static constexpr const char* name{ "S" };
+    static constexpr auto fields()
+    {
+        return std::make_tuple(record_file::field("m_x", &S::m_x), record_file::field("m_y", &S::m_y));
+    }
+};
+
+template <>
+struct RecordLayout<Employee>
+{
+    static constexpr const char* name{ "Employee" };
+    static constexpr auto fields()
+    {
+        return std::make_tuple(record_file::field("x", &Employee::x), record_file::field("name", &Employee::name));
+    }
+};
+
+// an Employee whose name is kept in a StringPool (see string_pool.h): 8 bytes instead of 40, however long the name is
+struct InternedEmployee
+{
+    int x;
+    StringId name;
+};
+
 
 int main()
 {
@@ -167,6 +211,30 @@ int main()
 
     delete[] array;
 
+    /*
+    The same without a delete[] to forget: allocateArray() returns an ArraySpan (see arena.h), which frees its memory
+    when it goes out of scope. Here the memory comes from an arena, which just moves a pointer forward instead of asking
+    the heap every time, and which can be reset() in one go once all the arrays are gone (e.g. after every request).
+    A SizeClassPool reuses the memory of arrays that were given back for new arrays of about the same size.
+    */
+    MonotonicArena arena{};
+    {
+        ArraySpan<int> numbers{ allocateArray(arena, 12) };
+        ArraySpan<float> simdNumbers{ arena, 16, 64 }; // 64 byte aligned, for SIMD loads
+
+        numbers[0] = 5;
+        simdNumbers[0] = 1.5f;
+        std::cout << "arena arrays: " << numbers.size() << " ints and " << simdNumbers.size() << " floats\n";
+    } // both arrays give their memory back here
+    arena.reset(); // and the arena can hand all of it out again
+
+    SizeClassPool pool{};
+    {
+        ArraySpan<int> first{ allocateArray(pool, 12) };
+    }
+    ArraySpan<int> second{ allocateArray(pool, 12) }; // gets the memory first had
+    std::cout << "pool array: " << second.size() << " ints\n";
+
     /*
     This works because dynamically allocated memory is not destroyed at the end of the block in which it is allocated, so that 
     memory will still exist when the address is returned back to the caller. Keeping track of manual allocations can be difficult. 
@@ -418,7 +486,7 @@ int main()
     the largest element in the array. 
     */
     std::vector array_quiz{23, 56, 67, 34, 56, 89, 123};
-    std::cout << "The largest element is: " << getIndexOfLargestValue(array_quiz) << '\n';
+    std::cout << "The largest element is at index: " << getIndexOfLargestValue(array_quiz) << '\n';
 
     /*
     5) A function named getElement() that takes an array of std::string (as a std::vector) and an index and returns the array 
@@ -428,20 +496,76 @@ int main()
 
     std::cout << getElement(vec_str, 10) << '\n';
 
+    /*
+    getElement() needs a string to return a reference to when the index isn't valid, so it keeps a static one around.
+    findElement() returns a std::optional instead, which is empty for an invalid index, and holds a std::string_view
+    (not a copy) of the element otherwise:
+    */
+    if(std::optional<std::string_view> element{ findElement(vec_str, 10) })
+        std::cout << *element << '\n';
+    else
+        std::cout << "there's no element 10\n";
 
-    return 0;
-}
+    /*
+    When the same names show up over and over, a StringPool keeps every name once and the records only an id:
+    */
+    StringPool names{};
+    std::vector<InternedEmployee> employees{ { 1, names.intern("Jezus") }, { 2, names.intern("Jezus") } };
+    std::cout << names.view(employees[1].name) << " is stored " << names.size() << " time(s) for "
+              << employees.size() << " employees\n";
 
-int sumTo(int x)
-{
-    if(x == 1)
+    /*
+    Employees that are written to a file (see record_file.h in 11.13) can be read back without building them again:
+    the file is mapped into memory, a column is returned as a view into it, and a record is returned by value.
+    */
     {
-        return 1;
+        RecordWriter<Employee> writer{};
+        std::string error{};
+        bool written{ writer.open("employees.records", error) };
+        if(written)
+        {
+            writer.add({ 1, "Jezus" });
+            writer.add({ 2, "Maria" });
+            written = writer.finish(error);
+        }
+
+        RecordFile<Employee> employeeFile{};
+        if(written && employeeFile.open("employees.records", error))
+        {
+            StringColumnView employeeNames{ employeeFile.column(&Employee::name) };
+            Employee second{ employeeFile[1] };
+            std::cout << employeeFile.size() << " employees in the file, the first is " << employeeNames[0]
+                      << " and the second " << second.name << " (" << second.x << ")\n";
+        }
+        else
+            std::cout << error << '\n';
+        std::remove("employees.records");
     }
-    else
-    {   
-        return x + sumTo(x-1);
+
+    /*
+    Returning by reference (getElement()), returning a small struct by value (returnStruct()) and passing by const
+    reference (printEmployeeName()) don't allocate anything. Compiled with -DALLOC_TRACKING, the scope shows it (see
+    alloc_tracking.h in 11.8):
+    */
+    {
+        AllocationScope scope{ "getElement, returnStruct, printEmployeeName" };
+        const std::string& element{ getElement(vec_str, 2) };
+        S returned{ returnStruct() };
+        printEmployeeName(emp);
+
+        if(scope.allocations() != 0)
+            std::cout << "allocated " << scope.bytes() << " bytes for " << element << ' ' << returned.m_x << '\n';
     }
+
+
+    return 0;
+}
+
+// the closed form n * (n + 1) / 2 (see constexpr_math.h): no recursion that never ends for 0 or a negative number,
+// and a long long, which holds the sum for any int
+long long sumTo(int x)
+{
+    return constexpr_math::sumTo(x);
 }
 void printEmployeeName(const Employee& emp)
 {
@@ -453,21 +577,13 @@ std::pair<int, int> minmax(int x, int y)
     return {x-y, x+y};
 }
 
+// the index of the (first) largest element, -1 for an empty array (see argmax.h)
 int getIndexOfLargestValue(const std::vector<int>& array)
 {
-    std::size_t lenght{ array.size() };
-
-    int theBigestIndex{ 0 };
+    if(array.empty())
+        return -1;
 
-    for(int i{ 0 }; i < lenght; ++i)
-    {
-        if(array[i] > theBigestIndex)
-        {
-            theBigestIndex = array[i];
-        }
-    }
-
-    return theBigestIndex;
+    return static_cast<int>(argmax(array.data(), array.size()));
 }
 
 const std::string& getElement(const std::vector<std::string>& vec_str, std::size_t index)
@@ -476,7 +592,7 @@ const std::string& getElement(const std::vector<std::string>& vec_str, std::size
 
     static std::string oj{ "error" };
 
-    if((index > 0) && (index < vec_str.size()))
+    if(index < vec_str.size())
     {
         return vec_str[x];
     }
@@ -484,4 +600,12 @@ const std::string& getElement(const std::vector<std::string>& vec_str, std::size
     {
         return oj;
     }
+}
+
+std::optional<std::string_view> findElement(const std::vector<std::string>& vec_str, std::size_t index)
+{
+    if(index < vec_str.size())
+        return vec_str[index];
+
+    return std::nullopt;
 }
\ No newline at end of file
@@ -0,0 +1,220 @@
+#ifndef STRING_POOL_H
+#define STRING_POOL_H
+
+#include <cstddef> // for std::size_t
+#include <cstdint> // for std::uint32_t
+#include <cstring> // for std::memcpy
+#include <functional> // for std::hash
+#include <memory> // for std::unique_ptr
+#include <mutex> // for std::unique_lock
+#include <optional>
+#include <shared_mutex> // for std::shared_mutex, std::shared_lock
+#include <stdexcept> // for std::length_error
+#include <string_view>
+#include <vector>
+
+/*
+Every different string stored once, and a 32 bit id for it.
+
+When the same makes and models (or names) show up millions of times, a std::string per record means millions of copies
+of the same few characters: 32 bytes for every std::string, plus a heap allocation for every string longer than 15
+characters. pool.intern("Volkswagen") stores the characters the first time and returns an id (a StringId, 4 bytes);
+every later intern("Volkswagen") finds them and returns the same id. So records can keep the id instead of the string,
+and two ids are equal exactly when their strings are.
+
+  - pool.view(id) gives the string back as a std::string_view. The characters never move (they're kept in 64 KB
+    chunks that are never given back before the pool goes away), so the string_view stays good as long as the pool,
+  - pool.find(text) returns the id if text is already in the pool, and std::nullopt (without adding it) if it isn't,
+  - lookups use a hash table with the hash of every string next to its id, so a miss rarely compares any characters.
+
+There are two kinds of pool:
+  - StringPool, for one thread. Nothing is locked.
+  - ConcurrentStringPool, which many threads can intern() into and view() from at the same time. Lookups share a
+    std::shared_mutex, only adding a new string takes it for itself.
+*/
+
+using StringId = std::uint32_t;
+
+namespace string_pool
+{
+    // a mutex that doesn't lock anything, for a pool that's only used from one thread
+    struct NoMutex
+    {
+        void lock() {}
+        void unlock() {}
+        void lock_shared() {}
+        void unlock_shared() {}
+    };
+}
+
+template <typename Mutex>
+class BasicStringPool
+{
+public:
+    BasicStringPool() = default;
+
+    BasicStringPool(const BasicStringPool&) = delete;
+    BasicStringPool& operator=(const BasicStringPool&) = delete;
+
+    // the id of text, which is added if it isn't in the pool yet
+    StringId intern(std::string_view text)
+    {
+        const std::uint32_t hash{ hashOf(text) };
+
+        {
+            std::shared_lock<Mutex> lock{ m_mutex };
+            if(std::optional<StringId> id{ lookup(text, hash) })
+                return *id;
+        }
+
+        std::unique_lock<Mutex> lock{ m_mutex };
+
+        // another thread might have added it in the meantime
+        if(std::optional<StringId> id{ lookup(text, hash) })
+            return *id;
+
+        return add(text, hash);
+    }
+
+    // the id of text if it's in the pool
+    std::optional<StringId> find(std::string_view text) const
+    {
+        std::shared_lock<Mutex> lock{ m_mutex };
+        return lookup(text, hashOf(text));
+    }
+
+    // the string with the id (which has to come from this pool)
+    std::string_view view(StringId id) const
+    {
+        std::shared_lock<Mutex> lock{ m_mutex };
+        return m_views[id];
+    }
+
+    // how many different strings there are
+    std::size_t size() const
+    {
+        std::shared_lock<Mutex> lock{ m_mutex };
+        return m_views.size();
+    }
+
+    // the memory the pool uses: the characters, the table and the views
+    std::size_t memoryUsed() const
+    {
+        std::shared_lock<Mutex> lock{ m_mutex };
+        return m_chunks.size() * chunkSize + m_bigBytes + m_slots.capacity() * sizeof(Slot) +
+               m_views.capacity() * sizeof(std::string_view);
+    }
+
+private:
+    static constexpr std::size_t chunkSize{ 64 * 1024 };
+    static constexpr StringId noId{ static_cast<StringId>(-1) };
+
+    struct Slot
+    {
+        std::uint32_t hash;
+        StringId id; // noId for an empty slot
+    };
+
+    static std::uint32_t hashOf(std::string_view text)
+    {
+        return static_cast<std::uint32_t>(std::hash<std::string_view>{}(text));
+    }
+
+    // the slots are a power of two, and the ones after the hash's own slot are tried until an empty one
+    std::optional<StringId> lookup(std::string_view text, std::uint32_t hash) const
+    {
+        if(m_slots.empty())
+            return std::nullopt;
+
+        const std::size_t mask{ m_slots.size() - 1 };
+        for(std::size_t index{ hash & mask };; index = (index + 1) & mask)
+        {
+            const Slot& slot{ m_slots[index] };
+            if(slot.id == noId)
+                return std::nullopt;
+            if(slot.hash == hash && m_views[slot.id] == text)
+                return slot.id;
+        }
+    }
+
+    StringId add(std::string_view text, std::uint32_t hash)
+    {
+        if(m_views.size() >= noId)
+            throw std::length_error{ "the string pool is full" };
+
+        // at most half full, so a lookup only has to go past a slot or two
+        if((m_views.size() + 1) * 2 > m_slots.size())
+            grow();
+
+        StringId id{ static_cast<StringId>(m_views.size()) };
+        m_views.push_back(store(text));
+        insert(Slot{ hash, id });
+
+        return id;
+    }
+
+    void insert(Slot slot)
+    {
+        const std::size_t mask{ m_slots.size() - 1 };
+        std::size_t index{ slot.hash & mask };
+        while(m_slots[index].id != noId)
+            index = (index + 1) & mask;
+
+        m_slots[index] = slot;
+    }
+
+    void grow()
+    {
+        std::vector<Slot> old(m_slots.empty() ? 64 : m_slots.size() * 2, Slot{ 0, noId });
+        old.swap(m_slots);
+
+        for(const Slot& slot : old)
+        {
+            if(slot.id != noId)
+                insert(slot);
+        }
+    }
+
+    // copies the characters into a chunk, where they stay
+    std::string_view store(std::string_view text)
+    {
+        if(text.empty())
+            return {};
+
+        // a long string gets its own piece of memory, so that it doesn't leave most of a chunk unused
+        if(text.size() > chunkSize / 4)
+        {
+            m_big.push_back(std::make_unique<char[]>(text.size()));
+            m_bigBytes += text.size();
+            std::memcpy(m_big.back().get(), text.data(), text.size());
+            return { m_big.back().get(), text.size() };
+        }
+
+        if(static_cast<std::size_t>(m_end - m_position) < text.size())
+        {
+            m_chunks.push_back(std::make_unique<char[]>(chunkSize));
+            m_position = m_chunks.back().get();
+            m_end = m_position + chunkSize;
+        }
+
+        char* characters{ m_position };
+        std::memcpy(characters, text.data(), text.size());
+        m_position += text.size();
+
+        return { characters, text.size() };
+    }
+
+    mutable Mutex m_mutex{};
+    std::vector<Slot> m_slots{};
+    std::vector<std::string_view> m_views{};           // m_views[id] is the string with that id
+    std::vector<std::unique_ptr<char[]>> m_chunks{};
+    std::vector<std::unique_ptr<char[]>> m_big{};
+    std::size_t m_bigBytes{ 0 };
+    char* m_position{ nullptr };                       // the free part of the newest chunk
+    char* m_end{ nullptr };
+};
+
+using StringPool = BasicStringPool<string_pool::NoMutex>;
+using ConcurrentStringPool = BasicStringPool<std::shared_mutex>;
+
+#endif
@@ -0,0 +1,139 @@
+#define ALLOC_TRACKING
+#include "../11.8 — The stack and the heap (vsCode)/alloc_tracking.h" // for AllocationScope
+
+#include <iostream>
+#include <chrono> // for std::chrono::steady_clock
+#include <cstddef> // for std::size_t
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "string_pool.h" // for StringPool, ConcurrentStringPool, StringId
+
+/*
+Memory and time for 2 million car records with std::string members (like Car in 11.14) against records with interned
+ids (InternedCar), where the makes and models come from a list of 30 makes with 10 models each. The memory is what the
+records and their strings take on the heap, measured with alloc_tracking.h from 11.8.
+
+    g++ -std=c++17 -O2 -pthread string_pool_benchmark.cpp -o string_pool_benchmark
+*/
+
+// Car from 11.14, kept here as the baseline
+struct Car
+{
+    std::string make{};
+    std::string model{};
+};
+
+struct InternedCar
+{
+    StringId make{};
+    StringId model{};
+};
+
+template <typename Fcn>
+double timeIt(Fcn fcn)
+{
+    auto start{ std::chrono::steady_clock::now() };
+    fcn();
+    auto end{ std::chrono::steady_clock::now() };
+
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+constexpr std::size_t recordCount{ 2'000'000 };
+
+const char* const makes[]{ "Volkswagen", "Toyota", "Honda", "Mercedes-Benz", "Alfa Romeo", "Aston Martin", "Bentley",
+                           "Chevrolet", "Chrysler", "Citroen", "Dacia", "Ferrari", "Fiat", "Ford", "Hyundai", "Jaguar",
+                           "Jeep", "Kia", "Lamborghini", "Land Rover", "Lexus", "Maserati", "Mazda", "Mitsubishi",
+                           "Nissan", "Peugeot", "Porsche", "Renault", "Skoda", "Volvo" };
+
+// "Estate Comfortline 3" and so on: the longer model names don't fit into a std::string without the heap
+std::string modelName(std::size_t make, std::size_t model)
+{
+    static const char* const names[]{ "Sedan", "Estate Comfortline", "Hatchback", "Coupe Performance Edition", "SUV",
+                                      "Cabriolet Sport Line", "Van", "Pickup Double Cab", "Limousine", "Roadster" };
+    return std::string{ names[model] } + ' ' + std::to_string(make);
+}
+
+int main()
+{
+    std::vector<std::string> models{};
+    for(std::size_t make{ 0 }; make < 30; ++make)
+    {
+        for(std::size_t model{ 0 }; model < 10; ++model)
+            models.push_back(modelName(make, model));
+    }
+
+    auto pick{ [](std::size_t i){ return (i * 2654435761u) % 300; } };
+
+    long long carBytes{};
+    double carMs{};
+    {
+        AllocationScope scope{};
+        std::vector<Car> cars{};
+        carMs = timeIt([&]{
+            cars.reserve(recordCount);
+            for(std::size_t i{ 0 }; i < recordCount; ++i)
+            {
+                std::size_t which{ pick(i) };
+                cars.push_back(Car{ makes[which / 10], models[which] });
+            }
+        });
+        carBytes = scope.peakLiveBytes();
+    }
+
+    long long internedBytes{};
+    double internedMs{};
+    std::size_t uniqueStrings{};
+    {
+        AllocationScope scope{};
+        StringPool pool{};
+        std::vector<InternedCar> cars{};
+        internedMs = timeIt([&]{
+            cars.reserve(recordCount);
+            for(std::size_t i{ 0 }; i < recordCount; ++i)
+            {
+                std::size_t which{ pick(i) };
+                cars.push_back(InternedCar{ pool.intern(makes[which / 10]), pool.intern(models[which]) });
+            }
+        });
+        internedBytes = scope.peakLiveBytes();
+        uniqueStrings = pool.size();
+    }
+
+    std::cout << recordCount << " records\n";
+    std::cout << "Car (std::string):  " << carMs << " ms, " << carBytes / (1024 * 1024) << " MB, "
+              << static_cast<double>(carBytes) / recordCount << " bytes per record\n";
+    std::cout << "InternedCar:        " << internedMs << " ms, " << internedBytes / (1024 * 1024) << " MB, "
+              << static_cast<double>(internedBytes) / recordCount << " bytes per record (" << uniqueStrings
+              << " strings in the pool)\n";
+    std::cout << "memory " << static_cast<double>(carBytes) / static_cast<double>(internedBytes) << " times less\n";
+
+    // the same with 4 threads interning into one ConcurrentStringPool
+    ConcurrentStringPool shared{};
+    std::vector<InternedCar> sharedCars(recordCount);
+    double concurrentMs{ timeIt([&]{
+        std::vector<std::thread> threads{};
+        for(std::size_t t{ 0 }; t < 4; ++t)
+        {
+            threads.emplace_back([&, t]{
+                for(std::size_t i{ t }; i < recordCount; i += 4)
+                {
+                    std::size_t which{ pick(i) };
+                    sharedCars[i] = InternedCar{ shared.intern(makes[which / 10]), shared.intern(models[which]) };
+                }
+            });
+        }
+        for(std::thread& thread : threads)
+            thread.join();
+    }) };
+
+    bool same{ shared.size() == uniqueStrings };
+    for(std::size_t i{ 0 }; i < recordCount && same; ++i)
+        same = shared.view(sharedCars[i].model) == models[pick(i)];
+
+    std::cout << "ConcurrentStringPool, 4 threads: " << concurrentMs << " ms" << (same ? "" : " (WRONG)") << '\n';
+
+    return 0;
+}
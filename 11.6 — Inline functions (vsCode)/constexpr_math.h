@@ -0,0 +1,119 @@
+#ifndef CONSTEXPR_MATH_H
+#define CONSTEXPR_MATH_H
+
+#include <array>
+#include <cstddef> // for std::size_t
+#include <cstdint> // for std::uint64_t
+#include <limits> // for std::numeric_limits
+
+/*
+constexpr versions of sumTo() (lessons 11.5 and 11.10), factorial_of_an_integer_N() (11.10) and min() (11.6), that
+check for overflow.
+
+Inlining removes the call, constexpr removes the work too: a constexpr function called with constants can be worked
+out by the compiler, and in a constant expression it has to be, e.g.
+    constexpr long long sum{ constexpr_math::sumTo(100) };  // 5050, in the program as a number, even with -O0
+    static_assert(constexpr_math::factorial(6) == 720);
+With optimization, the compiler also does that for plain calls with constant arguments: std::cout << sumTo(100) becomes
+std::cout << 5050, with no call left. And with run time arguments there's not much to call:
+  - sumTo(n) is the closed form n * (n + 1) / 2, with no recursion,
+  - factorial(n) is a lookup in factorialTable, 0! to 20! (21! needs more than 64 bits), built at compile time,
+  - min(x, y) is one comparison (std::min, but constexpr in C++17 too).
+
+The int versions in the lessons silently overflow: sumTo(100000) and factorial_of_an_integer_N(13) are wrong. Here:
+  - sumTo() returns a long long and factorial() a std::uint64_t, which hold sumTo() of any int and every factorial of
+    an int that fits in 64 bits at all,
+  - when the result still doesn't fit, sumTo() and factorial() are a compile error in a constant expression (they
+    call overflowed_in_constant_expression(), which isn't constexpr, so the error message names it), and at run time
+    they return the largest value the type has (saturate),
+  - sumTo_checked() and factorial_checked() return a Checked, the (saturated) value plus whether it overflowed, for
+    when the caller has to know.
+sumTo(n) is 0 for n < 1 and factorial(n) is 1 for n < 2, like in lesson 11.10.
+*/
+
+namespace constexpr_math
+{
+    template <typename T>
+    struct Checked
+    {
+        T value;            // the result, or the largest T if it didn't fit
+        bool overflowed;
+    };
+
+    // deliberately not constexpr: reaching this while the compiler evaluates a constant expression is a compile error,
+    // at run time it passes the saturated value on
+    template <typename T>
+    T overflowed_in_constant_expression(T saturated)
+    {
+        return saturated;
+    }
+
+    template <typename T>
+    constexpr T valueOrError(Checked<T> result)
+    {
+        return result.overflowed ? overflowed_in_constant_expression(result.value) : result.value;
+    }
+
+    constexpr int largestFactorial{ 20 };
+
+    constexpr std::array<std::uint64_t, largestFactorial + 1> makeFactorialTable()
+    {
+        std::array<std::uint64_t, largestFactorial + 1> table{};
+        table[0] = 1;
+        for(int n{ 1 }; n <= largestFactorial; ++n)
+            table[static_cast<std::size_t>(n)] = table[static_cast<std::size_t>(n - 1)] * static_cast<std::uint64_t>(n);
+
+        return table;
+    }
+
+    // factorialTable[n] is n!
+    inline constexpr std::array<std::uint64_t, largestFactorial + 1> factorialTable{ makeFactorialTable() };
+
+    // 1 + 2 + ... + n (0 for n < 1)
+    constexpr Checked<long long> sumTo_checked(long long n)
+    {
+        if(n < 1)
+            return { 0, false };
+
+        // n * (n + 1) / 2, but one of n and n + 1 is even and gets halved first, so the product is the result itself
+        // (and n + 1 isn't worked out for an odd n, it could be one more than a long long holds)
+        const long long first{ n % 2 == 0 ? n / 2 : n };
+        const long long second{ n % 2 == 0 ? n + 1 : n / 2 + 1 };
+
+        constexpr long long largest{ std::numeric_limits<long long>::max() };
+        if(first > largest / second)
+            return { largest, true };
+
+        return { first * second, false };
+    }
+
+    constexpr long long sumTo(long long n)
+    {
+        return valueOrError(sumTo_checked(n));
+    }
+
+    // n! (1 for n < 2)
+    constexpr Checked<std::uint64_t> factorial_checked(int n)
+    {
+        if(n < 2)
+            return { 1, false };
+        if(n > largestFactorial)
+            return { std::numeric_limits<std::uint64_t>::max(), true };
+
+        return { factorialTable[static_cast<std::size_t>(n)], false };
+    }
+
+    constexpr std::uint64_t factorial(int n)
+    {
+        return valueOrError(factorial_checked(n));
+    }
+
+    // the smaller of x and y (x when they're equal, like std::min)
+    template <typename T>
+    constexpr const T& min(const T& x, const T& y)
+    {
+        return y < x ? y : x;
+    }
+}
+
+#endif
@@ -1,13 +1,14 @@
 #include <iostream>
+#include "constexpr_math.h" // for constexpr_math::min
 
 int min(int x, int y)
 {
-    return x > y ? x : y;
+    return x > y ? y : x;
 }
 
 inline int min2(int x, int y)
 {
-    return x > y ? x : y;
+    return x > y ? y : x;
 }
 
 int main()
@@ -98,6 +99,15 @@ int main()
     need to use the inline keyword in this context.
     */
 
+    /*
+    constexpr goes one step further: a constexpr function with constant arguments can be worked out by the compiler
+    itself, and in a constexpr variable it has to be, so there's no call and no comparison left even without
+    optimization. constexpr_math::min() (see constexpr_math.h) works for any type that has <:
+    */
+    constexpr int smallest{ constexpr_math::min(345, 234) };
+    std::cout << smallest << '\n';
+    static_assert(constexpr_math::min(6.5, 7.0) == 6.5, "worked out while compiling");
+
 
     std::cout << std::endl;
     ////////////////////////////////////////////////////////////////////////////////////////////
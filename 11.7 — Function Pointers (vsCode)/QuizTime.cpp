@@ -1,5 +1,12 @@
 #include <iostream>
 #include <limits> // for std::numeric_limits
+#include "batch_arithmetic.h" // for evaluateBatch, divideByConstant
+#include "bulk_input.h" // for BulkInput
+#include "expression_engine.h" // for Expression
+#include "quiz_server.h" // for QuizServer
+#include <charconv> // for std::from_chars, std::to_chars
+#include <cstdio> // for std::fwrite
+#include <string>
 
 void ignoreLine()
 {
@@ -86,8 +93,116 @@ fcn_ptr getArithmeticFunction(char c)
     return nullptr;
 }
 
-int main()
+// Bulk mode: reads "x op y" triples (one value per line, like the questions main() asks) from a file or from stdin ("-")
+// and prints one "x op y = result" line for each, without going through std::cin/std::cout per value
+int runBulk(const char* path)
 {
+    std::string pathString{ path };
+    BulkInput input{ pathString == "-" ? BulkInput{ stdin, &std::cerr } : BulkInput{ pathString, &std::cerr } };
+
+    if(!input.isOpen())
+    {
+        std::cerr << "Can't open " << path << '\n';
+        return 1;
+    }
+
+    std::string output{};
+    output.reserve(BulkInput::blockSize + 64);
+
+    auto appendInt{ [&output](int value)
+    {
+        char digits[16];
+        auto [end, error]{ std::to_chars(digits, digits + sizeof(digits), value) };
+        (void)error;
+        output.append(digits, end);
+    } };
+
+    int x{};
+    char op{};
+    int y{};
+
+    // the results wrap around like the batch functions do (see batch_arithmetic.h), so that no triple in the input,
+    // INT_MIN / -1 or an overflowing product included, is undefined behaviour
+    auto evaluate{ [](char operation, int a, int b)
+    {
+        using namespace batch_arithmetic;
+
+        switch(operation)
+        {
+        case '+':
+            return addWrapping(a, b);
+        case '-':
+            return subtractWrapping(a, b);
+        case '*':
+            return multiplyWrapping(a, b);
+        default:
+            return divideDefined(a, b);
+        }
+    } };
+
+    while(input.readInteger(x) && input.readOperation(op) && input.readInteger(y))
+    {
+        appendInt(x);
+        output += ' ';
+        output += op;
+        output += ' ';
+        appendInt(y);
+        output += " = ";
+
+        if(op == '/' && y == 0)
+            output += "division by zero";
+        else
+            appendInt(evaluate(op, x, y));
+        output += '\n';
+
+        // write in big blocks
+        if(output.size() >= BulkInput::blockSize)
+        {
+            std::fwrite(output.data(), 1, output.size(), stdout);
+            output.clear();
+        }
+    }
+
+    std::fwrite(output.data(), 1, output.size(), stdout);
+    std::fflush(stdout);
+
+    return input.errorCount() == 0 ? 0 : 2;
+}
+
+// Server mode: answers "x op y" lines from any number of TCP clients (see quiz_server.h)
+int runServer(const char* portText)
+{
+    std::string portString{ portText ? portText : "7070" };
+    int port{};
+    auto [end, error]{ std::from_chars(portString.data(), portString.data() + portString.size(), port) };
+    if(error != std::errc{} || end != portString.data() + portString.size() || port < 1 || port > 65535)
+    {
+        std::cerr << "Not a port: " << portString << '\n';
+        return 1;
+    }
+
+    QuizServer server{};
+    std::string startError{};
+    if(!server.start(port, startError))
+    {
+        std::cerr << startError << '\n';
+        return 1;
+    }
+
+    std::cerr << "Serving on port " << port << " (one \"x op y\" per line, \"stats\" for the metrics, Ctrl+C to stop)\n";
+    return server.run();
+}
+
+int main(int argc, char* argv[])
+{
+    // QuizTime --serve [port] answers over TCP
+    if(argc > 1 && std::string{ argv[1] } == "--serve")
+        return runServer(argc > 2 ? argv[2] : nullptr);
+
+    // QuizTime <file> (or QuizTime - for stdin) reads the whole input in bulk instead of asking for it
+    if(argc > 1)
+        return runBulk(argv[1]);
+
     std::cout << std::endl;
     ////////////////////////////////////////////////////////////////////////////////////////////
     std::cout << "////////////////////////////////////////////////////////////////////" << '\n';
@@ -134,6 +249,50 @@ int main()
 
     std::cout << x << ' ' << op << ' ' << y << " = " << fcn(x, y) << '\n';
 
+    /*
+    Extra: the same operation for a whole column of pairs at once (see batch_arithmetic.h). The operator is looked at
+    once, and the work is done by SIMD instructions several pairs at a time:
+    */
+    constexpr int columnX[]{ 10, 20, 30, 40, 50, 60, 70, 80, 90 };
+    constexpr int columnY[]{ 1, 2, 3, 4, 0, 6, 7, 8, 9 };
+    int columnResults[std::size(columnX)]{};
+
+    BatchResult batch{ evaluateBatch(op, columnX, columnY, columnResults, std::size(columnX)) };
+
+    for(std::size_t i{ 0 }; i < std::size(columnX); ++i)
+        std::cout << columnX[i] << ' ' << op << ' ' << columnY[i] << " = " << columnResults[i] << '\n';
+
+    if(batch.divisionsByZero > 0)
+        std::cout << batch.divisionsByZero << " division(s) by zero, those results are 0\n";
+
+    // dividing a whole column by the same number has its own fast path
+    divideByConstant(columnX, 7, columnResults, std::size(columnX));
+
+    for(std::size_t i{ 0 }; i < std::size(columnX); ++i)
+        std::cout << columnX[i] << " / 7 = " << columnResults[i] << '\n';
+
+    /*
+    Extra: a whole formula instead of one operator (see expression_engine.h). It is parsed once, compiled into a short
+    program, and that program is then run for one pair of values, or for whole columns at once:
+    */
+    Expression formula{};
+    ExpressionError error{};
+    if(formula.compile("(x + y) * (x - y) / 2", { "x", "y" }, error))
+    {
+        std::cout << formula.disassemble();
+
+        const int values[]{ x, y };
+        std::cout << "(x + y) * (x - y) / 2 with x = " << x << ", y = " << y << ": " << formula.evaluate(values) << '\n';
+
+        const int* const columns[]{ columnX, columnY };
+        formula.evaluateColumns(columns, columnResults, std::size(columnX));
+
+        for(std::size_t i{ 0 }; i < std::size(columnX); ++i)
+            std::cout << "x = " << columnX[i] << ", y = " << columnY[i] << ": " << columnResults[i] << '\n';
+    }
+    else
+        std::cout << error.message << " at " << error.position << '\n';
+
 
 
     return 0;
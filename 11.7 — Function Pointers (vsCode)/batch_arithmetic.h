@@ -0,0 +1,419 @@
+#ifndef BATCH_ARITHMETIC_H
+#define BATCH_ARITHMETIC_H
+
+#include <cstddef> // for std::size_t
+#include <cstdint> // for std::uint32_t, std::uint64_t
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64)
+#include <immintrin.h>
+#define BATCH_ARITHMETIC_X86 1
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define BATCH_ARITHMETIC_NEON 1
+#endif
+
+/*
+Batch version of the calculator: applies one operator ('+', '-', '*', '/') to whole columns of (x, y) pairs.
+
+getArithmeticFunction() hands out one function pointer per pair, which is one indirect call per element.
+evaluateBatch() looks at the operator once and then runs a loop that does 4 (SSE2, NEON) or 8 (AVX2) pairs per
+instruction. The AVX2 loops are picked at run time, only on CPUs that have AVX2.
+
+The results are defined for every input:
+  - '+', '-' and '*' wrap around on overflow (like unsigned arithmetic) instead of being undefined behavior,
+  - x / 0 writes 0, the number of divisions by zero is returned in BatchResult,
+  - INT_MIN / -1 wraps around to INT_MIN.
+Apart from that every result is the same as add(), subtract(), multiply() and division() from QuizTime.cpp.
+
+divideByConstant() is the fast path for a column divided by one fixed divisor: instead of a division per element it
+does one multiply and shift (the divisor's "magic number" is worked out once per call).
+*/
+
+struct BatchResult
+{
+    bool validOperator{};               // false if op wasn't one of '+', '-', '*', '/' (nothing was written)
+    std::size_t divisionsByZero{};      // how many y were 0 (those results are 0)
+};
+
+namespace batch_arithmetic
+{
+    // the scalar versions, used for the elements left over after the vector loops and as the fallback
+
+    inline int addWrapping(int x, int y)
+    {
+        return static_cast<int>(static_cast<std::uint32_t>(x) + static_cast<std::uint32_t>(y));
+    }
+
+    inline int subtractWrapping(int x, int y)
+    {
+        return static_cast<int>(static_cast<std::uint32_t>(x) - static_cast<std::uint32_t>(y));
+    }
+
+    inline int multiplyWrapping(int x, int y)
+    {
+        return static_cast<int>(static_cast<std::uint32_t>(x) * static_cast<std::uint32_t>(y));
+    }
+
+    inline int divideDefined(int x, int y)
+    {
+        if(y == 0)
+            return 0;
+        if(y == -1)
+            return subtractWrapping(0, x);// -INT_MIN wraps to INT_MIN
+
+        return x / y;
+    }
+
+    inline std::size_t countZeros(const int* y, std::size_t count)
+    {
+        std::size_t zeros{ 0 };
+        for(std::size_t i{ 0 }; i < count; ++i)
+            zeros += (y[i] == 0);
+
+        return zeros;
+    }
+
+    // the loops below are plain enough for the compiler to vectorize them if there's no hand-written version
+    inline void addScalar(const int* x, const int* y, int* out, std::size_t first, std::size_t count)
+    {
+        for(std::size_t i{ first }; i < count; ++i)
+            out[i] = addWrapping(x[i], y[i]);
+    }
+
+    inline void subtractScalar(const int* x, const int* y, int* out, std::size_t first, std::size_t count)
+    {
+        for(std::size_t i{ first }; i < count; ++i)
+            out[i] = subtractWrapping(x[i], y[i]);
+    }
+
+    inline void multiplyScalar(const int* x, const int* y, int* out, std::size_t first, std::size_t count)
+    {
+        for(std::size_t i{ first }; i < count; ++i)
+            out[i] = multiplyWrapping(x[i], y[i]);
+    }
+
+    inline void divideScalar(const int* x, const int* y, int* out, std::size_t first, std::size_t count)
+    {
+        for(std::size_t i{ first }; i < count; ++i)
+            out[i] = divideDefined(x[i], y[i]);
+    }
+
+#if defined(BATCH_ARITHMETIC_X86)
+
+    // Dividing two ints as doubles and truncating gives exactly the int quotient (a double has 53 bits, plenty for the
+    // 31 bits of an int quotient), and x86 has no integer division instruction for vectors.
+    // INT_MIN / -1 (2^31) doesn't fit, cvttpd turns it into INT_MIN which is exactly the wrap around we want.
+
+    // AVX2 versions, compiled for AVX2 even if the rest of the program isn't and only called if the CPU has it
+#if defined(__GNUC__)
+#define BATCH_ARITHMETIC_HAS_AVX2 1
+
+    __attribute__((target("avx2"))) inline void addAvx2(const int* x, const int* y, int* out, std::size_t count)
+    {
+        std::size_t i{ 0 };
+        for(; i + 8 <= count; i += 8)
+        {
+            __m256i a{ _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + i)) };
+            __m256i b{ _mm256_loadu_si256(reinterpret_cast<const __m256i*>(y + i)) };
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_add_epi32(a, b));
+        }
+        addScalar(x, y, out, i, count);
+    }
+
+    __attribute__((target("avx2"))) inline void subtractAvx2(const int* x, const int* y, int* out, std::size_t count)
+    {
+        std::size_t i{ 0 };
+        for(; i + 8 <= count; i += 8)
+        {
+            __m256i a{ _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + i)) };
+            __m256i b{ _mm256_loadu_si256(reinterpret_cast<const __m256i*>(y + i)) };
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_sub_epi32(a, b));
+        }
+        subtractScalar(x, y, out, i, count);
+    }
+
+    __attribute__((target("avx2"))) inline void multiplyAvx2(const int* x, const int* y, int* out, std::size_t count)
+    {
+        std::size_t i{ 0 };
+        for(; i + 8 <= count; i += 8)
+        {
+            __m256i a{ _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + i)) };
+            __m256i b{ _mm256_loadu_si256(reinterpret_cast<const __m256i*>(y + i)) };
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_mullo_epi32(a, b));
+        }
+        multiplyScalar(x, y, out, i, count);
+    }
+
+    __attribute__((target("avx2"))) inline void divideAvx2(const int* x, const int* y, int* out, std::size_t count)
+    {
+        const __m256i zero{ _mm256_setzero_si256() };
+        const __m256i one{ _mm256_set1_epi32(1) };
+
+        std::size_t i{ 0 };
+        for(; i + 8 <= count; i += 8)
+        {
+            __m256i a{ _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + i)) };
+            __m256i b{ _mm256_loadu_si256(reinterpret_cast<const __m256i*>(y + i)) };
+
+            // divide by 1 where y is 0, and clear those results afterwards
+            __m256i isZero{ _mm256_cmpeq_epi32(b, zero) };
+            b = _mm256_blendv_epi8(b, one, isZero);
+
+            __m128i q[2];
+            for(int half{ 0 }; half < 2; ++half)
+            {
+                __m128i a4{ half == 0 ? _mm256_castsi256_si128(a) : _mm256_extracti128_si256(a, 1) };
+                __m128i b4{ half == 0 ? _mm256_castsi256_si128(b) : _mm256_extracti128_si256(b, 1) };
+                q[half] = _mm256_cvttpd_epi32(_mm256_div_pd(_mm256_cvtepi32_pd(a4), _mm256_cvtepi32_pd(b4)));
+            }
+
+            __m256i quotient{ _mm256_set_m128i(q[1], q[0]) };
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_andnot_si256(isZero, quotient));
+        }
+        divideScalar(x, y, out, i, count);
+    }
+
+    inline bool cpuHasAvx2()
+    {
+        static const bool hasAvx2{ __builtin_cpu_supports("avx2") != 0 };
+        return hasAvx2;
+    }
+#endif
+
+    // SSE2 versions, every x86-64 CPU has SSE2
+    inline void addSse2(const int* x, const int* y, int* out, std::size_t count)
+    {
+        std::size_t i{ 0 };
+        for(; i + 4 <= count; i += 4)
+        {
+            __m128i a{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(x + i)) };
+            __m128i b{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(y + i)) };
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_add_epi32(a, b));
+        }
+        addScalar(x, y, out, i, count);
+    }
+
+    inline void subtractSse2(const int* x, const int* y, int* out, std::size_t count)
+    {
+        std::size_t i{ 0 };
+        for(; i + 4 <= count; i += 4)
+        {
+            __m128i a{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(x + i)) };
+            __m128i b{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(y + i)) };
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_sub_epi32(a, b));
+        }
+        subtractScalar(x, y, out, i, count);
+    }
+
+    inline void multiplySse2(const int* x, const int* y, int* out, std::size_t count)
+    {
+        std::size_t i{ 0 };
+        for(; i + 4 <= count; i += 4)
+        {
+            __m128i a{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(x + i)) };
+            __m128i b{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(y + i)) };
+
+            // SSE2 has no 32-bit multiply, multiply lanes 0/2 and 1/3 as 64-bit and keep the low halves
+            __m128i even{ _mm_mul_epu32(a, b) };
+            __m128i odd{ _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32)) };
+            __m128i product{ _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                                                _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0))) };
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), product);
+        }
+        multiplyScalar(x, y, out, i, count);
+    }
+
+    inline void divideSse2(const int* x, const int* y, int* out, std::size_t count)
+    {
+        const __m128i zero{ _mm_setzero_si128() };
+        const __m128i one{ _mm_set1_epi32(1) };
+
+        std::size_t i{ 0 };
+        for(; i + 4 <= count; i += 4)
+        {
+            __m128i a{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(x + i)) };
+            __m128i b{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(y + i)) };
+
+            __m128i isZero{ _mm_cmpeq_epi32(b, zero) };
+            b = _mm_or_si128(_mm_andnot_si128(isZero, b), _mm_and_si128(isZero, one));
+
+            // two lanes per double division
+            __m128i qLow{ _mm_cvttpd_epi32(_mm_div_pd(_mm_cvtepi32_pd(a), _mm_cvtepi32_pd(b))) };
+            __m128i qHigh{ _mm_cvttpd_epi32(_mm_div_pd(_mm_cvtepi32_pd(_mm_srli_si128(a, 8)),
+                                                       _mm_cvtepi32_pd(_mm_srli_si128(b, 8)))) };
+            __m128i quotient{ _mm_unpacklo_epi64(qLow, qHigh) };
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_andnot_si128(isZero, quotient));
+        }
+        divideScalar(x, y, out, i, count);
+    }
+
+#elif defined(BATCH_ARITHMETIC_NEON)
+
+    inline void addNeon(const int* x, const int* y, int* out, std::size_t count)
+    {
+        std::size_t i{ 0 };
+        for(; i + 4 <= count; i += 4)
+            vst1q_s32(out + i, vaddq_s32(vld1q_s32(x + i), vld1q_s32(y + i)));
+        addScalar(x, y, out, i, count);
+    }
+
+    inline void subtractNeon(const int* x, const int* y, int* out, std::size_t count)
+    {
+        std::size_t i{ 0 };
+        for(; i + 4 <= count; i += 4)
+            vst1q_s32(out + i, vsubq_s32(vld1q_s32(x + i), vld1q_s32(y + i)));
+        subtractScalar(x, y, out, i, count);
+    }
+
+    inline void multiplyNeon(const int* x, const int* y, int* out, std::size_t count)
+    {
+        std::size_t i{ 0 };
+        for(; i + 4 <= count; i += 4)
+            vst1q_s32(out + i, vmulq_s32(vld1q_s32(x + i), vld1q_s32(y + i)));
+        multiplyScalar(x, y, out, i, count);
+    }
+
+    // NEON has no integer division either, the scalar loop is as good as it gets there
+    inline void divideNeon(const int* x, const int* y, int* out, std::size_t count)
+    {
+        divideScalar(x, y, out, 0, count);
+    }
+
+#endif
+
+    // magic number for dividing by a fixed divisor d (the "direct computation" method):
+    // for every 32-bit n, n / d == (n * magic) >> 64 with magic = 2^64 / d + 1 (d > 1)
+    inline std::uint64_t magicFor(std::uint32_t d)
+    {
+        return ~std::uint64_t{ 0 } / d + 1;
+    }
+
+    inline std::uint32_t divideByMagic(std::uint32_t n, std::uint64_t magic)
+    {
+#if defined(__SIZEOF_INT128__)
+        return static_cast<std::uint32_t>((static_cast<unsigned __int128>(magic) * n) >> 64);
+#else
+        // high 64 bits of a 64 x 32 bit product, without a 128-bit type
+        std::uint64_t low{ (magic & 0xFFFFFFFFu) * n };
+        std::uint64_t high{ (magic >> 32) * n };
+        return static_cast<std::uint32_t>((high + (low >> 32)) >> 32);
+#endif
+    }
+}
+
+// out[i] = x[i] op y[i] for i from 0 to count-1
+inline BatchResult evaluateBatch(char op, const int* x, const int* y, int* out, std::size_t count)
+{
+    using namespace batch_arithmetic;
+
+    BatchResult result{ true, 0 };
+
+#if defined(BATCH_ARITHMETIC_HAS_AVX2)
+    bool avx2{ cpuHasAvx2() };
+#endif
+
+    switch(op)
+    {
+    case '+':
+#if defined(BATCH_ARITHMETIC_HAS_AVX2)
+        if(avx2) { addAvx2(x, y, out, count); break; }
+#endif
+#if defined(BATCH_ARITHMETIC_X86)
+        addSse2(x, y, out, count);
+#elif defined(BATCH_ARITHMETIC_NEON)
+        addNeon(x, y, out, count);
+#else
+        addScalar(x, y, out, 0, count);
+#endif
+        break;
+
+    case '-':
+#if defined(BATCH_ARITHMETIC_HAS_AVX2)
+        if(avx2) { subtractAvx2(x, y, out, count); break; }
+#endif
+#if defined(BATCH_ARITHMETIC_X86)
+        subtractSse2(x, y, out, count);
+#elif defined(BATCH_ARITHMETIC_NEON)
+        subtractNeon(x, y, out, count);
+#else
+        subtractScalar(x, y, out, 0, count);
+#endif
+        break;
+
+    case '*':
+#if defined(BATCH_ARITHMETIC_HAS_AVX2)
+        if(avx2) { multiplyAvx2(x, y, out, count); break; }
+#endif
+#if defined(BATCH_ARITHMETIC_X86)
+        multiplySse2(x, y, out, count);
+#elif defined(BATCH_ARITHMETIC_NEON)
+        multiplyNeon(x, y, out, count);
+#else
+        multiplyScalar(x, y, out, 0, count);
+#endif
+        break;
+
+    case '/':
+        result.divisionsByZero = countZeros(y, count);
+#if defined(BATCH_ARITHMETIC_HAS_AVX2)
+        if(avx2) { divideAvx2(x, y, out, count); break; }
+#endif
+#if defined(BATCH_ARITHMETIC_X86)
+        divideSse2(x, y, out, count);
+#elif defined(BATCH_ARITHMETIC_NEON)
+        divideNeon(x, y, out, count);
+#else
+        divideScalar(x, y, out, 0, count);
+#endif
+        break;
+
+    default:
+        result.validOperator = false;
+        break;
+    }
+
+    return result;
+}
+
+// out[i] = x[i] / divisor for i from 0 to count-1, with the same rules as evaluateBatch()
+inline BatchResult divideByConstant(const int* x, int divisor, int* out, std::size_t count)
+{
+    using namespace batch_arithmetic;
+
+    if(divisor == 0)
+    {
+        for(std::size_t i{ 0 }; i < count; ++i)
+            out[i] = 0;
+        return { true, count };
+    }
+
+    if(divisor == 1 || divisor == -1)
+    {
+        for(std::size_t i{ 0 }; i < count; ++i)
+            out[i] = divisor == 1 ? x[i] : subtractWrapping(0, x[i]);
+        return { true, 0 };
+    }
+
+    // divide the magnitudes, then put the sign back (the quotient rounds towards zero, like x / y does)
+    std::uint32_t magnitude{ divisor < 0 ? 0u - static_cast<std::uint32_t>(divisor) : static_cast<std::uint32_t>(divisor) };
+    std::uint64_t magic{ magicFor(magnitude) };
+    std::uint32_t divisorSign{ divisor < 0 ? 0xFFFFFFFFu : 0u };
+
+    for(std::size_t i{ 0 }; i < count; ++i)
+    {
+        std::uint32_t n{ static_cast<std::uint32_t>(x[i]) };
+        std::uint32_t sign{ static_cast<std::uint32_t>(x[i] >> 31) };  // all ones if x[i] is negative
+
+        std::uint32_t absolute{ (n ^ sign) - sign };
+        std::uint32_t quotient{ divideByMagic(absolute, magic) };
+
+        sign ^= divisorSign;
+        out[i] = static_cast<int>((quotient ^ sign) - sign);
+    }
+
+    return { true, 0 };
+}
+
+#endif
@@ -0,0 +1,247 @@
+#ifndef BULK_INPUT_H
+#define BULK_INPUT_H
+
+#include <charconv> // for std::from_chars
+#include <cstddef> // for std::size_t
+#include <cstdio> // for std::FILE, std::fopen, std::fread
+#include <ostream>
+#include <string>
+#include <system_error> // for std::errc
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h> // for open
+#include <sys/mman.h> // for mmap
+#include <sys/stat.h> // for fstat
+#include <unistd.h> // for close
+#define BULK_INPUT_HAS_MMAP 1
+#endif
+
+/*
+Fast input for the calculator when the operands come from a (big) file or a pipe instead of a person.
+
+getInteger() and getOperation() go through std::cin one token at a time and check fail() after every read. BulkInput
+reads the input in big blocks (or maps a whole file into memory) and picks the numbers out with std::from_chars,
+without touching iostreams at all.
+
+readInteger() and readOperation() follow the same rules as getInteger() and getOperation():
+  - whitespace (including empty lines) before the value is skipped,
+  - whatever follows the value on the same line is ignored (that's what ignoreLine() does),
+  - a line without a valid integer, or a number too big for an int, is reported as
+        "Oops, that input is invalid (offset N).  Please try again."
+    and the next line is tried instead, N being the byte offset of the bad input,
+  - a line whose first character isn't '+', '-', '*' or '/' is skipped when an operation is expected
+    (reported too, since nobody is there to see a prompt being repeated).
+Both return false once the input has run out.
+*/
+class BulkInput
+{
+public:
+    static constexpr std::size_t blockSize{ 1 << 20 };
+
+    // reads from an already opened stream (e.g. stdin) in blocks
+    explicit BulkInput(std::FILE* file, std::ostream* errors = nullptr)
+        : m_file{ file }, m_errors{ errors }
+    {
+        m_buffer.resize(blockSize);
+        m_data = m_buffer.data();
+    }
+
+    // maps the whole file into memory if the system can do that, otherwise reads it in blocks
+    explicit BulkInput(const std::string& path, std::ostream* errors = nullptr)
+        : m_errors{ errors }
+    {
+#if defined(BULK_INPUT_HAS_MMAP)
+        int fd{ ::open(path.c_str(), O_RDONLY) };
+        if(fd >= 0)
+        {
+            struct stat info{};
+            if(::fstat(fd, &info) == 0 && info.st_size > 0)
+            {
+                void* mapped{ ::mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0) };
+                if(mapped != MAP_FAILED)
+                {
+                    ::madvise(mapped, static_cast<std::size_t>(info.st_size), MADV_SEQUENTIAL);
+
+                    m_mapped = mapped;
+                    m_mappedSize = static_cast<std::size_t>(info.st_size);
+                    m_data = static_cast<const char*>(mapped);
+                    m_end = m_mappedSize;
+                    m_endOfInput = true;
+                }
+            }
+            ::close(fd);
+
+            if(m_mapped)
+                return;
+        }
+#endif
+        m_file = std::fopen(path.c_str(), "rb");
+        m_ownsFile = true;
+        m_buffer.resize(blockSize);
+        m_data = m_buffer.data();
+
+        if(!m_file)
+            m_endOfInput = true;
+    }
+
+    ~BulkInput()
+    {
+#if defined(BULK_INPUT_HAS_MMAP)
+        if(m_mapped)
+            ::munmap(m_mapped, m_mappedSize);
+#endif
+        if(m_ownsFile && m_file)
+            std::fclose(m_file);
+    }
+
+    BulkInput(const BulkInput&) = delete;
+    BulkInput& operator=(const BulkInput&) = delete;
+
+    // false if the file given to the constructor couldn't be opened
+    bool isOpen() const { return m_mapped || m_file; }
+
+    bool readInteger(int& x)
+    {
+        while(true)
+        {
+            if(!skipWhitespace())
+                return false;
+
+            // make sure a whole number is in the buffer (an int has at most 11 characters, plus a '+')
+            fill(16);
+
+            const char* first{ m_data + m_position };
+            const char* last{ m_data + m_end };
+
+            // std::cin >> x accepts a leading '+', std::from_chars doesn't
+            if(*first == '+' && last - first > 1 && first[1] >= '0' && first[1] <= '9')
+                ++first;
+
+            auto [end, error]{ std::from_chars(first, last, x) };
+
+            if(error == std::errc{})
+            {
+                m_position = static_cast<std::size_t>(end - m_data);
+                ignoreLine();
+                return true;
+            }
+
+            reportError("Oops, that input is invalid");
+            ignoreLine();
+        }
+    }
+
+    bool readOperation(char& op)
+    {
+        while(true)
+        {
+            if(!skipWhitespace())
+                return false;
+
+            op = m_data[m_position];
+            if(op == '+' || op == '-' || op == '*' || op == '/')
+            {
+                ++m_position;
+                ignoreLine();
+                return true;
+            }
+
+            reportError("Oops, that operation is invalid");
+            ignoreLine();
+        }
+    }
+
+    std::size_t errorCount() const { return m_errorCount; }
+
+    // bytes of input used up so far
+    std::size_t offset() const { return m_consumed + m_position; }
+
+private:
+    // makes sure at least wanted bytes (or whatever is left of the input) are in the buffer after m_position
+    void fill(std::size_t wanted)
+    {
+        if(m_endOfInput || m_end - m_position >= wanted)
+            return;
+
+        // move what's left to the front of the buffer and read another block after it
+        std::size_t left{ m_end - m_position };
+        for(std::size_t i{ 0 }; i < left; ++i)
+            m_buffer[i] = m_buffer[m_position + i];
+
+        m_consumed += m_position;
+        m_position = 0;
+        m_end = left;
+
+        while(m_end < wanted && !m_endOfInput)
+        {
+            std::size_t got{ std::fread(m_buffer.data() + m_end, 1, m_buffer.size() - m_end, m_file) };
+            m_end += got;
+
+            if(got == 0)
+                m_endOfInput = true;
+        }
+    }
+
+    // returns false if the input has run out
+    bool skipWhitespace()
+    {
+        while(true)
+        {
+            while(m_position < m_end)
+            {
+                char c{ m_data[m_position] };
+                if(c != ' ' && c != '\n' && c != '\t' && c != '\r' && c != '\v' && c != '\f')
+                    return true;
+                ++m_position;
+            }
+
+            fill(1);
+            if(m_position >= m_end)
+                return false;
+        }
+    }
+
+    // skips the rest of the current line, including the '\n'
+    void ignoreLine()
+    {
+        while(true)
+        {
+            while(m_position < m_end)
+            {
+                if(m_data[m_position++] == '\n')
+                    return;
+            }
+
+            fill(1);
+            if(m_position >= m_end)
+                return;
+        }
+    }
+
+    void reportError(const char* message)
+    {
+        ++m_errorCount;
+
+        if(m_errors)
+            *m_errors << message << " (offset " << offset() << ").  Please try again.\n";
+    }
+
+    std::FILE* m_file{ nullptr };
+    bool m_ownsFile{ false };
+
+    void* m_mapped{ nullptr };
+    std::size_t m_mappedSize{ 0 };
+
+    std::vector<char> m_buffer{};
+    const char* m_data{ nullptr };  // either m_buffer or the mapped file
+    std::size_t m_position{ 0 };    // next byte to look at
+    std::size_t m_end{ 0 };         // end of the valid bytes in m_data
+    std::size_t m_consumed{ 0 };    // bytes dropped from the front of m_buffer so far
+    bool m_endOfInput{ false };
+
+    std::ostream* m_errors{ nullptr };
+    std::size_t m_errorCount{ 0 };
+};
+
+#endif
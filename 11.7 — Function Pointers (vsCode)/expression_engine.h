@@ -0,0 +1,591 @@
+#ifndef EXPRESSION_ENGINE_H
+#define EXPRESSION_ENGINE_H
+
+#include <algorithm> // for std::copy, std::fill_n, std::find, std::min, std::max
+#include <charconv> // for std::from_chars
+#include <cstddef> // for std::size_t
+#include <cstdint> // for std::uint8_t
+#include <string>
+#include <system_error> // for std::errc
+#include <vector>
+#include "batch_arithmetic.h" // for evaluateBatch, divideByConstant and the scalar operations
+
+/*
+The calculator for whole formulas instead of one operator: "(x + y) * (x - y) / 2" over the variables x and y.
+
+Working such a formula out with getArithmeticFunction() means going back to the text (or a tree) for every operator, a
+switch on the character and a call per step, and all of that again for every set of values. Expression parses the
+text once (checking it and working out the constant parts) and compiles it into a short program, a list of 4-byte
+instructions "slot = slot op slot":
+
+    Expression formula{};
+    ExpressionError error{};
+    if(!formula.compile("(x + y) * (x - y) / 2", { "x", "y" }, error))
+        std::cout << error.message << " at " << error.position << '\n';
+
+    const int values[]{ 7, 3 };
+    formula.evaluate(values);               // 20
+
+The slots are the variables, the constants and the temporaries of the program, all in one array; the program starts by
+loading the variables and constants it uses into theirs (that's cheaper than copying them in before every run). Constant
+parts are worked out at compile time ("2 * 3 * x" is 6 * x). There are two ways to run it:
+  - evaluate(variables) for one set of values, with threaded dispatch: every instruction jumps straight to the code of
+    the next one (with GCC and Clang, through a table of label addresses), so there's no loop and no switch, and the
+    CPU predicts every jump on its own. That is still an interpreter: an instruction costs about as much as a step of
+    a getArithmeticFunction() chain that the compiler sees whole (in chapter11_benchmarks, evaluate() is no faster,
+    usually a bit slower), so evaluate() is for formulas that aren't known until run time, not for speed,
+  - evaluateColumns(columns, out, count) for many sets at once, one column per variable: the program runs over
+    blockSize rows at a time, each instruction over the whole block with evaluateBatch() (SIMD, see
+    batch_arithmetic.h), and a division by a constant with divideByConstant(). The temporaries of one block stay in
+    the L1 cache, and the dispatch happens once per instruction and block instead of once per value. This is where
+    the speedup is: a few times faster per row than the chain or evaluate().
+
+The arithmetic is that of batch_arithmetic.h, the same as add(), subtract(), multiply() and division() from
+QuizTime.cpp, but defined for every input: overflow wraps around and x / 0 is 0 (the divisions by zero are counted),
+in both modes and in the constants worked out at compile time.
+
+The grammar is the usual one: + - * / with * and / first, left to right, parentheses, a unary - or +, int literals
+and variable names ([A-Za-z_][A-Za-z0-9_]*). Variables, constants and temporaries together are up to 256.
+*/
+
+struct ExpressionError
+{
+    std::size_t position{};     // where in the text it went wrong
+    std::string message{};
+};
+
+namespace expression_engine
+{
+    enum Opcode : std::uint8_t
+    {
+        add,
+        subtract,
+        multiply,
+        divide,
+        loadVariable,       // result = variables[a]
+        loadConstant,       // result = constants[a]
+        end,
+    };
+
+    struct Instruction
+    {
+        std::uint8_t opcode;
+        std::uint8_t result;
+        std::uint8_t a;
+        std::uint8_t b;
+    };
+
+    constexpr int maxSlots{ 256 };
+    constexpr int maxNesting{ 64 };
+
+    // 4 KB per temporary, a block of a whole program stays in the L1 cache
+    constexpr std::size_t blockSize{ 1024 };
+
+    inline char operatorOf(std::uint8_t opcode)
+    {
+        constexpr char operators[]{ '+', '-', '*', '/' };
+        return operators[opcode];
+    }
+
+    inline int apply(std::uint8_t opcode, int x, int y)
+    {
+        using namespace batch_arithmetic;
+
+        switch(opcode)
+        {
+        case add:
+            return addWrapping(x, y);
+        case subtract:
+            return subtractWrapping(x, y);
+        case multiply:
+            return multiplyWrapping(x, y);
+        default:
+            return divideDefined(x, y);
+        }
+    }
+
+    inline bool isSpace(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+    }
+
+    inline bool isDigit(char c)
+    {
+        return c >= '0' && c <= '9';
+    }
+
+    inline bool isNameStart(char c)
+    {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+    }
+}
+
+class Expression
+{
+public:
+    // false (and error filled in) if text isn't a valid formula over variableNames
+    bool compile(const std::string& text, const std::vector<std::string>& variableNames, ExpressionError& error)
+    {
+        *this = Expression{};
+        m_variableNames = variableNames;
+        m_text = &text;
+        m_error = &error;
+
+        Operand result{};
+        bool compiled{ parseSum(result, 0, 0) };
+        if(compiled)
+        {
+            skipSpace();
+            if(m_position < text.size())
+                compiled = fail("unexpected character");
+        }
+        compiled = compiled && link(result);
+
+        m_text = nullptr;
+        m_error = nullptr;
+        m_pending.clear();
+        if(!compiled)
+            *this = Expression{};
+
+        return compiled;
+    }
+
+    std::size_t variableCount() const { return m_variableNames.size(); }
+    const std::vector<std::string>& variableNames() const { return m_variableNames; }
+
+    // the instructions, not counting the loads and the end
+    std::size_t size() const { return m_code.empty() ? 0 : m_code.size() - m_loadCount - 1; }
+
+    // variables[i] is the value of variableNames()[i]
+    int evaluate(const int* variables) const
+    {
+        std::size_t divisionsByZero{ 0 };
+        return evaluate(variables, divisionsByZero);
+    }
+
+    // also adds the number of divisions by zero to divisionsByZero
+    int evaluate(const int* variables, std::size_t& divisionsByZero) const
+    {
+        using namespace batch_arithmetic;
+        using namespace expression_engine;
+
+        if(m_code.empty())
+            return 0;
+
+        int slots[maxSlots];
+        const int* constants{ m_constants.data() };
+        const Instruction* instruction{ m_code.data() };
+        std::size_t zeros{ 0 };
+
+#if defined(__GNUC__)
+        // in the same order as the opcodes
+        static const void* const labels[]{ &&doAdd, &&doSubtract, &&doMultiply, &&doDivide, &&doLoadVariable,
+                                           &&doLoadConstant, &&doEnd };
+#define EXPRESSION_ENGINE_NEXT goto *labels[instruction->opcode]
+
+        EXPRESSION_ENGINE_NEXT;
+
+    doAdd:
+        slots[instruction->result] = addWrapping(slots[instruction->a], slots[instruction->b]);
+        ++instruction;
+        EXPRESSION_ENGINE_NEXT;
+
+    doSubtract:
+        slots[instruction->result] = subtractWrapping(slots[instruction->a], slots[instruction->b]);
+        ++instruction;
+        EXPRESSION_ENGINE_NEXT;
+
+    doMultiply:
+        slots[instruction->result] = multiplyWrapping(slots[instruction->a], slots[instruction->b]);
+        ++instruction;
+        EXPRESSION_ENGINE_NEXT;
+
+    doDivide:
+        zeros += (slots[instruction->b] == 0);
+        slots[instruction->result] = divideDefined(slots[instruction->a], slots[instruction->b]);
+        ++instruction;
+        EXPRESSION_ENGINE_NEXT;
+
+    doLoadVariable:
+        slots[instruction->result] = variables[instruction->a];
+        ++instruction;
+        EXPRESSION_ENGINE_NEXT;
+
+    doLoadConstant:
+        slots[instruction->result] = constants[instruction->a];
+        ++instruction;
+        EXPRESSION_ENGINE_NEXT;
+
+#undef EXPRESSION_ENGINE_NEXT
+    doEnd:
+#else
+        // without label addresses: a switch per instruction
+        for(; instruction->opcode != end; ++instruction)
+        {
+            switch(instruction->opcode)
+            {
+            case loadVariable:
+                slots[instruction->result] = variables[instruction->a];
+                break;
+            case loadConstant:
+                slots[instruction->result] = constants[instruction->a];
+                break;
+            case divide:
+                zeros += (slots[instruction->b] == 0);
+                [[fallthrough]];
+            default:
+                slots[instruction->result] = apply(instruction->opcode, slots[instruction->a], slots[instruction->b]);
+                break;
+            }
+        }
+#endif
+
+        divisionsByZero += zeros;
+        return slots[m_result];
+    }
+
+    // out[row] = the formula over columns[0][row], columns[1][row], ... for row from 0 to count-1 (out must not
+    // overlap the columns); returns the number of divisions by zero
+    std::size_t evaluateColumns(const int* const* columns, int* out, std::size_t count) const
+    {
+        using namespace expression_engine;
+
+        const std::size_t variables{ m_variableNames.size() };
+        const std::size_t firstTemporary{ variables + m_constants.size() };
+        std::size_t divisionsByZero{ 0 };
+
+        if(m_code.empty() || count == 0)
+            return 0;
+
+        // the constants as columns of one block, and the temporaries, except for the first one, which is out itself
+        const std::size_t rows{ std::min(count, blockSize) };
+        std::vector<int> buffer((m_constants.size() + (m_temporaryCount > 0 ? m_temporaryCount - 1 : 0)) * rows);
+        for(std::size_t constant{ 0 }; constant < m_constants.size(); ++constant)
+            std::fill_n(buffer.data() + constant * rows, rows, m_constants[constant]);
+
+        const int* operands[maxSlots];
+        int* temporaries[maxSlots];
+        for(std::size_t constant{ 0 }; constant < m_constants.size(); ++constant)
+            operands[variables + constant] = buffer.data() + constant * rows;
+        for(std::size_t temporary{ 1 }; temporary < m_temporaryCount; ++temporary)
+            temporaries[temporary] = buffer.data() + (m_constants.size() + temporary - 1) * rows;
+
+        for(std::size_t first{ 0 }; first < count; first += rows)
+        {
+            const std::size_t n{ std::min(rows, count - first) };
+
+            for(std::size_t variable{ 0 }; variable < variables; ++variable)
+                operands[variable] = columns[variable] + first;
+            temporaries[0] = out + first;
+            for(std::size_t temporary{ 0 }; temporary < m_temporaryCount; ++temporary)
+                operands[firstTemporary + temporary] = temporaries[temporary];
+
+            // the loads are what operands already does
+            for(const Instruction* instruction{ m_code.data() + m_loadCount }; instruction->opcode != end; ++instruction)
+            {
+                int* result{ temporaries[instruction->result - firstTemporary] };
+                if(instruction->opcode == divide && isConstant(instruction->b))
+                    divisionsByZero += divideByConstant(operands[instruction->a], constantOf(instruction->b), result, n)
+                                           .divisionsByZero;
+                else
+                    divisionsByZero += evaluateBatch(operatorOf(instruction->opcode), operands[instruction->a],
+                                                     operands[instruction->b], result, n).divisionsByZero;
+            }
+
+            // a formula that is just a variable or a constant
+            if(m_result < firstTemporary)
+                std::copy(operands[m_result], operands[m_result] + n, out + first);
+        }
+
+        return divisionsByZero;
+    }
+
+    // the program without the loads, one instruction per line, e.g. "t0 = x + 3"
+    std::string disassemble() const
+    {
+        std::string listing{};
+        for(std::size_t index{ m_loadCount }; index < m_code.size(); ++index)
+        {
+            const expression_engine::Instruction& instruction{ m_code[index] };
+            if(instruction.opcode == expression_engine::end)
+                break;
+
+            listing += slotName(instruction.result) + " = " + slotName(instruction.a) + ' ' +
+                       expression_engine::operatorOf(instruction.opcode) + ' ' + slotName(instruction.b) + '\n';
+        }
+
+        if(!m_code.empty())
+            listing += "result " + slotName(m_result) + '\n';
+
+        return listing;
+    }
+
+private:
+    struct Operand
+    {
+        enum Kind
+        {
+            variable,
+            constant,
+            temporary,
+        };
+
+        Kind kind{ constant };
+        std::size_t index{ 0 };
+    };
+
+    // an instruction before the slots are known (the constants and temporaries are numbered after the variables)
+    struct Pending
+    {
+        std::uint8_t opcode;
+        std::size_t temporary;
+        Operand a;
+        Operand b;
+    };
+
+    bool fail(const char* message)
+    {
+        m_error->position = m_position;
+        m_error->message = message;
+        return false;
+    }
+
+    void skipSpace()
+    {
+        while(m_position < m_text->size() && expression_engine::isSpace((*m_text)[m_position]))
+            ++m_position;
+    }
+
+    // the next character that isn't a space, 0 at the end of the text
+    char peek()
+    {
+        skipSpace();
+        return m_position < m_text->size() ? (*m_text)[m_position] : '\0';
+    }
+
+    Operand constant(int value)
+    {
+        auto found{ std::find(m_constants.begin(), m_constants.end(), value) };
+        if(found == m_constants.end())
+            found = m_constants.insert(m_constants.end(), value);
+
+        return { Operand::constant, static_cast<std::size_t>(found - m_constants.begin()) };
+    }
+
+    // result = a op b, or the constant it is
+    Operand emit(std::uint8_t opcode, std::size_t depth, Operand a, Operand b)
+    {
+        if(a.kind == Operand::constant && b.kind == Operand::constant &&
+           !(opcode == expression_engine::divide && m_constants[b.index] == 0))
+            return constant(expression_engine::apply(opcode, m_constants[a.index], m_constants[b.index]));
+
+        m_pending.push_back(Pending{ opcode, depth, a, b });
+        m_temporaryCount = std::max(m_temporaryCount, depth + 1);
+
+        return { Operand::temporary, depth };
+    }
+
+    // the temporaries are numbered by depth: the operands of an operator at depth d are worked out at depth d and
+    // d + 1, so nothing that is still needed gets overwritten
+
+    // sum := product (('+' | '-') product)*
+    bool parseSum(Operand& result, std::size_t depth, int nesting)
+    {
+        if(!parseProduct(result, depth, nesting))
+            return false;
+
+        for(char c{ peek() }; c == '+' || c == '-'; c = peek())
+        {
+            ++m_position;
+            Operand right{};
+            if(!parseProduct(right, depth + 1, nesting))
+                return false;
+
+            result = emit(c == '+' ? expression_engine::add : expression_engine::subtract, depth, result, right);
+        }
+
+        return true;
+    }
+
+    // product := factor (('*' | '/') factor)*
+    bool parseProduct(Operand& result, std::size_t depth, int nesting)
+    {
+        if(!parseFactor(result, depth, nesting))
+            return false;
+
+        for(char c{ peek() }; c == '*' || c == '/'; c = peek())
+        {
+            ++m_position;
+            Operand right{};
+            if(!parseFactor(right, depth + 1, nesting))
+                return false;
+
+            result = emit(c == '*' ? expression_engine::multiply : expression_engine::divide, depth, result, right);
+        }
+
+        return true;
+    }
+
+    // factor := number | name | '(' sum ')' | ('-' | '+') factor
+    bool parseFactor(Operand& result, std::size_t depth, int nesting)
+    {
+        using namespace expression_engine;
+
+        if(nesting >= maxNesting)
+            return fail("nested too deep");
+
+        const char c{ peek() };
+        const char* begin{ m_text->data() + m_position };
+        const char* textEnd{ m_text->data() + m_text->size() };
+
+        if(c == '-' || c == '+')
+        {
+            ++m_position;
+            if(!parseFactor(result, depth, nesting + 1))
+                return false;
+
+            if(c == '-')
+                result = emit(subtract, depth, constant(0), result);
+            return true;
+        }
+
+        if(c == '(')
+        {
+            ++m_position;
+            if(!parseSum(result, depth, nesting + 1))
+                return false;
+            if(peek() != ')')
+                return fail("expected ')'");
+
+            ++m_position;
+            return true;
+        }
+
+        if(isDigit(c))
+        {
+            int value{};
+            std::from_chars_result parsed{ std::from_chars(begin, textEnd, value) };
+            if(parsed.ec != std::errc{})
+                return fail("number too big for an int");
+
+            m_position += static_cast<std::size_t>(parsed.ptr - begin);
+            result = constant(value);
+            return true;
+        }
+
+        if(isNameStart(c))
+        {
+            const char* nameEnd{ begin };
+            while(nameEnd != textEnd && (isNameStart(*nameEnd) || isDigit(*nameEnd)))
+                ++nameEnd;
+
+            const std::string name{ begin, nameEnd };
+            auto found{ std::find(m_variableNames.begin(), m_variableNames.end(), name) };
+            if(found == m_variableNames.end())
+                return fail("unknown variable");
+
+            m_position += name.size();
+            result = { Operand::variable, static_cast<std::size_t>(found - m_variableNames.begin()) };
+            return true;
+        }
+
+        return fail(c == '\0' ? "unexpected end" : "expected a number, a variable or '('");
+    }
+
+    std::size_t slotOf(Operand operand) const
+    {
+        switch(operand.kind)
+        {
+        case Operand::variable:
+            return operand.index;
+        case Operand::constant:
+            return m_variableNames.size() + operand.index;
+        default:
+            return m_variableNames.size() + m_constants.size() + operand.index;
+        }
+    }
+
+    // turns the pending instructions into the program
+    bool link(Operand result)
+    {
+        if(m_variableNames.size() + m_constants.size() + m_temporaryCount > expression_engine::maxSlots)
+        {
+            m_position = 0;
+            return fail("too many variables, constants and temporaries");
+        }
+
+        // a load for every variable and constant that is used
+        m_result = slotOf(result);
+        std::vector<bool> used(m_variableNames.size() + m_constants.size());
+        auto use{ [&](Operand operand){
+            if(operand.kind != Operand::temporary)
+                used[slotOf(operand)] = true;
+        } };
+        use(result);
+        for(const Pending& pending : m_pending)
+        {
+            use(pending.a);
+            use(pending.b);
+        }
+
+        for(std::size_t slot{ 0 }; slot < used.size(); ++slot)
+        {
+            if(!used[slot])
+                continue;
+
+            const bool variable{ slot < m_variableNames.size() };
+            const std::size_t index{ variable ? slot : slot - m_variableNames.size() };
+            m_code.push_back(expression_engine::Instruction{
+                variable ? expression_engine::loadVariable : expression_engine::loadConstant,
+                static_cast<std::uint8_t>(slot), static_cast<std::uint8_t>(index), 0 });
+        }
+        m_loadCount = m_code.size();
+
+        for(const Pending& pending : m_pending)
+        {
+            m_code.push_back(expression_engine::Instruction{
+                pending.opcode,
+                static_cast<std::uint8_t>(slotOf({ Operand::temporary, pending.temporary })),
+                static_cast<std::uint8_t>(slotOf(pending.a)),
+                static_cast<std::uint8_t>(slotOf(pending.b)) });
+        }
+        m_code.push_back(expression_engine::Instruction{ expression_engine::end, 0, 0, 0 });
+
+        return true;
+    }
+
+    bool isConstant(std::size_t slot) const
+    {
+        return slot >= m_variableNames.size() && slot < m_variableNames.size() + m_constants.size();
+    }
+
+    int constantOf(std::size_t slot) const
+    {
+        return m_constants[slot - m_variableNames.size()];
+    }
+
+    std::string slotName(std::size_t slot) const
+    {
+        if(slot < m_variableNames.size())
+            return m_variableNames[slot];
+        if(isConstant(slot))
+            return std::to_string(constantOf(slot));
+
+        return 't' + std::to_string(slot - m_variableNames.size() - m_constants.size());
+    }
+
+    std::vector<std::string> m_variableNames{};
+    std::vector<int> m_constants{};
+    std::vector<expression_engine::Instruction> m_code{};
+    std::size_t m_loadCount{ 0 };
+    std::size_t m_temporaryCount{ 0 };
+    std::size_t m_result{ 0 };
+
+    // only while compiling
+    const std::string* m_text{ nullptr };
+    ExpressionError* m_error{ nullptr };
+    std::size_t m_position{ 0 };
+    std::vector<Pending> m_pending{};
+};
+
+#endif
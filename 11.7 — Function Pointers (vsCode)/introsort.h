@@ -0,0 +1,185 @@
+#ifndef INTROSORT_H
+#define INTROSORT_H
+
+#include <utility> // for std::swap
+
+/*
+Introsort engine templated on the comparison function.
+
+The comparison functions in this lesson (ascending_for_Ptr, descending_for_Ptr, evensFirst) answer the question
+"should x go after y?" (true means swap). introSort() uses the very same convention, so every comparison from
+main.cpp can be passed in unchanged. Because Compare is a template parameter (and not bool (*)(int, int)), a lambda
+or function object gets inlined into the sort loops instead of being called through a pointer on every comparison.
+introSort(array, size, comparisonFcn, swapFcn) also takes the function that exchanges two elements (std::swap
+otherwise), e.g. to count the swaps (see ../11.14 — Lambda captures/sort_instrumentation.h).
+
+The engine is quicksort with median-of-three pivots, falls back to heapsort if the recursion gets too deep
+(so the worst case stays O(n log n)), and finishes small ranges with insertion sort.
+*/
+
+namespace introsort
+{
+    // ranges with this many elements (or fewer) are finished with insertion sort
+    constexpr int insertionSortCutoff{ 16 };
+
+    // the swap introSort() uses when it isn't given one
+    struct StdSwap
+    {
+        template <typename T>
+        void operator()(T& a, T& b) const
+        {
+            using std::swap;
+            swap(a, b);
+        }
+    };
+
+    template <typename T, typename Compare>
+    void insertionSort(T* array, int size, Compare& comparisonFcn)
+    {
+        for(int currentIndex{ 1 }; currentIndex < size; ++currentIndex)
+        {
+            T value{ std::move(array[currentIndex]) };
+            int index{ currentIndex };
+
+            // shift the larger elements one step to the right
+            while(index > 0 && comparisonFcn(array[index-1], value))
+            {
+                array[index] = std::move(array[index-1]);
+                --index;
+            }
+
+            array[index] = std::move(value);
+        }
+    }
+
+    template <typename T, typename Compare, typename Swap>
+    void siftDown(T* array, int root, int size, Compare& comparisonFcn, Swap& swapFcn)
+    {
+        while(true)
+        {
+            int child{ 2*root + 1 };
+            if(child >= size)
+                return;
+
+            // pick the child that should go last
+            if(child + 1 < size && comparisonFcn(array[child+1], array[child]))
+                ++child;
+
+            if(!comparisonFcn(array[child], array[root]))
+                return;
+
+            swapFcn(array[root], array[child]);
+            root = child;
+        }
+    }
+
+    template <typename T, typename Compare, typename Swap>
+    void heapSort(T* array, int size, Compare& comparisonFcn, Swap& swapFcn)
+    {
+        for(int root{ size/2 - 1 }; root >= 0; --root)
+            siftDown(array, root, size, comparisonFcn, swapFcn);
+
+        for(int last{ size - 1 }; last > 0; --last)
+        {
+            swapFcn(array[0], array[last]);
+            siftDown(array, 0, last, comparisonFcn, swapFcn);
+        }
+    }
+
+    // puts the median of array[a], array[b], array[c] into array[a]
+    // (afterwards array[b] does not go after array[a], and array[c] does not go before it)
+    template <typename T, typename Compare, typename Swap>
+    void medianOfThreeToFront(T* array, int a, int b, int c, Compare& comparisonFcn, Swap& swapFcn)
+    {
+        if(comparisonFcn(array[b], array[c]))
+            swapFcn(array[b], array[c]);
+        if(comparisonFcn(array[a], array[c]))
+            swapFcn(array[a], array[c]);
+        if(comparisonFcn(array[b], array[a]))
+            swapFcn(array[a], array[b]);
+    }
+
+    // Hoare partition around the pivot stored in array[0]
+    // returns the final index of the pivot, everything left of it does not go after it,
+    // everything right of it does not go before it
+    template <typename T, typename Compare, typename Swap>
+    int partition(T* array, int size, Compare& comparisonFcn, Swap& swapFcn)
+    {
+        int left{ 0 };
+        int right{ size };
+
+        while(true)
+        {
+            do { ++left; } while(left < size && comparisonFcn(array[0], array[left]));
+            do { --right; } while(comparisonFcn(array[right], array[0]));
+
+            if(left >= right)
+                break;
+
+            swapFcn(array[left], array[right]);
+        }
+
+        swapFcn(array[0], array[right]);
+        return right;
+    }
+
+    template <typename T, typename Compare, typename Swap>
+    void introSortLoop(T* array, int size, int depthLimit, Compare& comparisonFcn, Swap& swapFcn)
+    {
+        while(size > insertionSortCutoff)
+        {
+            if(depthLimit == 0)
+            {
+                // quicksort is going quadratic on this input, switch to heapsort
+                heapSort(array, size, comparisonFcn, swapFcn);
+                return;
+            }
+            --depthLimit;
+
+            medianOfThreeToFront(array, 0, size/2, size-1, comparisonFcn, swapFcn);
+            int pivotIndex{ partition(array, size, comparisonFcn, swapFcn) };
+
+            // recurse into the smaller side and loop on the larger one, so the stack stays O(log n)
+            int leftSize{ pivotIndex };
+            int rightSize{ size - pivotIndex - 1 };
+
+            if(leftSize < rightSize)
+            {
+                introSortLoop(array, leftSize, depthLimit, comparisonFcn, swapFcn);
+                array += pivotIndex + 1;
+                size = rightSize;
+            }
+            else
+            {
+                introSortLoop(array + pivotIndex + 1, rightSize, depthLimit, comparisonFcn, swapFcn);
+                size = leftSize;
+            }
+        }
+    }
+}
+
+// Sorts array so that comparisonFcn(array[i], array[i+1]) is false for every neighbour pair
+// (comparisonFcn returns true when its first argument should go after the second one).
+// Elements are exchanged with swapFcn(a, b); insertion sort moves them instead, without swapFcn
+template <typename T, typename Compare, typename Swap>
+void introSort(T* array, int size, Compare comparisonFcn, Swap swapFcn)
+{
+    if(!array || size < 2)
+        return;
+
+    // 2 * log2(size) levels of quicksort before we give up and use heapsort
+    int depthLimit{ 0 };
+    for(int n{ size }; n > 1; n /= 2)
+        depthLimit += 2;
+
+    introsort::introSortLoop(array, size, depthLimit, comparisonFcn, swapFcn);
+    introsort::insertionSort(array, size, comparisonFcn);
+}
+
+template <typename T, typename Compare>
+void introSort(T* array, int size, Compare comparisonFcn)
+{
+    introSort(array, size, comparisonFcn, introsort::StdSwap{});
+}
+
+#endif
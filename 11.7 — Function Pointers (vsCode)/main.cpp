@@ -1,6 +1,7 @@
 #include <iostream>
 #include <utility> // for std::swap
 #include <functional> //for std::function
+#include "introsort.h" // for introSort()
 
 int foo()// code for foo starts at memory address 0x002717f0
 {
@@ -72,28 +73,12 @@ void SelectionSort_plus_our_comparison(int *array, int size)
     }
 }
 
+// Same signature as the selection sort from the lesson, but the work is done by introSort() from introsort.h
+// (O(n log n) instead of O(n^2)). Callers that want the comparison inlined should call introSort() directly
+// with a lambda, this wrapper still goes through the function pointer on every comparison.
 void SelectionSort_plus_our_function_pointer_parameter(int *array, int size, bool (*comparisonFcn)(int, int))
 {
-    // Step through each element of the array
-    for(int startIndex{ 0 }; startIndex < (size-1); ++startIndex)
-    {
-        // smallestIndex is the index of the smallest element we've encountered so far.
-        int bestIndex{ startIndex };
-        
-        // Look for smallest element remaining in the array (starting at startIndex+1)
-        for(int currentIndex{ startIndex+1 }; currentIndex < size; ++currentIndex)
-        {
-            // If the current element is smaller/larger than our previously found smallest
-            if(comparisonFcn(array[bestIndex], array[currentIndex]))// COMPARISON DONE HERE
-            {
-                // This is the new smallest number for this iteration
-                bestIndex = currentIndex;
-            }
-        }
-
-        // Swap our start element with our smallest element
-        std::swap(array[startIndex], array[bestIndex]);
-    }
+    introSort(array, size, comparisonFcn);
 }
 
 // Here is a comparison function that sorts in ascending order
@@ -365,6 +350,16 @@ int main()
     SelectionSort_plus_our_function_pointer_parameter(array, 9, evensFirst);
     printArray(array, 9);
 
+    /*
+    The same comparison functions work with introSort() (see introsort.h). Wrapping them in a lambda lets the compiler
+    inline the comparison into the sort instead of calling it through a pointer:
+    */
+    introSort(array, 9, [](int x, int y){ return descending_for_Ptr(x, y); });
+    printArray(array, 9);
+
+    introSort(array, 9, [](int x, int y){ return evensFirst(x, y); });
+    printArray(array, 9);
+
     /*
     As you can see, using a function pointer in this context provides a nice way to allow a caller to “hook” their own 
     functionality into something you’ve previously written and tested, which helps facilitate code reuse! Previously, 
@@ -0,0 +1,786 @@
+#ifndef QUIZ_SERVER_H
+#define QUIZ_SERVER_H
+
+#include <charconv> // for std::from_chars, std::to_chars
+#include <chrono> // for std::chrono::steady_clock
+#include <cstddef> // for std::size_t
+#include <cstdint> // for std::uint64_t
+#include <cstdio> // for std::FILE, std::fprintf
+#include <string>
+#include <string_view>
+#include <system_error> // for std::errc
+#include <vector>
+#include "batch_arithmetic.h" // for evaluateBatch
+
+#if defined(__linux__)
+#include <cerrno> // for errno
+#include <csignal> // for sigset_t, SIGINT, SIGTERM
+#include <cstring> // for std::strerror, std::memchr
+#include <netinet/in.h> // for sockaddr_in
+#include <netinet/tcp.h> // for TCP_NODELAY
+#include <sys/epoll.h> // for epoll_create1, epoll_ctl, epoll_wait
+#include <sys/signalfd.h> // for signalfd
+#include <sys/socket.h> // for socket, accept4, sendmsg
+#include <sys/uio.h> // for iovec
+#include <unistd.h> // for read, close
+#define QUIZ_SERVER_HAS_EPOLL 1
+#endif
+
+/*
+The calculator as a server: clients connect over TCP and send "x op y" requests, one per line, e.g. "7 * 3\n". Every
+request gets one line back, in the same order:
+  - the result ("21"), with the arithmetic of evaluateBatch() (overflow wraps around, see batch_arithmetic.h),
+  - "division by zero",
+  - "Oops, that input is invalid.  Please try again." for a line that isn't x op y,
+  - the metrics (see below) for a line that says "stats".
+
+    QuizServer server{};
+    std::string error{};
+    if(!server.start(7070, error))
+        std::cerr << error << '\n';
+    else
+        server.run();           // until SIGINT (Ctrl+C) or SIGTERM, then prints the metrics
+
+Instead of a blocking getInteger() per value, one thread serves every connection with an epoll event loop (level
+triggered, every socket non-blocking). Each time epoll_wait() returns:
+  - every connection that has data is read (up to readLimit bytes, so no client can starve the others), and all the
+    complete lines are parsed into one batch,
+  - the batch is split by operator and each part goes through evaluateBatch() as whole columns (SIMD),
+  - the responses of each connection are formatted into one shared buffer and sent with a single sendmsg(): what the
+    kernel didn't take last time and this cycle's responses, as two pieces (scatter/gather), without copying them
+    together first.
+A client that sends faster than it reads gets no more of its input read once responsesLimit bytes of responses are
+waiting for it; it's read again when it has caught up.
+
+metrics() (and "stats") is:
+  - connections open and accepted, requests answered, invalid requests,
+  - the queue depth: how many requests the last batch had, and the most any batch had,
+  - the bytes of responses waiting for slow clients,
+  - p50 and p99 latency: from the moment a request was read to the moment the kernel took its response, in
+    microseconds (within 1/8 of the true value, they come from a histogram with 8 buckets per power of two).
+
+Only on Linux (epoll and signalfd); elsewhere start() fails with an error that says so.
+*/
+
+struct ServerMetrics
+{
+    std::size_t connections{};              // open right now
+    std::uint64_t connectionsAccepted{};
+    std::uint64_t requests{};
+    std::uint64_t invalidRequests{};
+    std::size_t queueDepth{};               // requests in the last batch
+    std::size_t maxQueueDepth{};
+    std::size_t bytesWaiting{};             // responses the kernel hasn't taken yet
+    double p50Microseconds{};
+    double p99Microseconds{};
+};
+
+namespace quiz_server
+{
+    // counts of values in buckets: 0 to 7 exactly, then 8 buckets per power of two
+    class LatencyHistogram
+    {
+    public:
+        void add(std::uint64_t value, std::uint64_t count = 1)
+        {
+            m_buckets[bucketOf(value)] += count;
+            m_count += count;
+        }
+
+        std::uint64_t count() const { return m_count; }
+
+        // the value that fraction (e.g. 0.99) of all values are at most, rounded up to the end of its bucket
+        std::uint64_t percentile(double fraction) const
+        {
+            if(m_count == 0)
+                return 0;
+
+            const double wanted{ fraction * static_cast<double>(m_count) };
+            std::uint64_t seen{ 0 };
+            for(std::size_t bucket{ 0 }; bucket < bucketCount; ++bucket)
+            {
+                seen += m_buckets[bucket];
+                if(seen > 0 && static_cast<double>(seen) >= wanted)
+                    return largestIn(bucket);
+            }
+
+            return largestIn(bucketCount - 1);
+        }
+
+    private:
+        static constexpr std::size_t subBuckets{ 8 };
+        static constexpr std::size_t bucketCount{ (64 - 2) * subBuckets };
+
+        static int highestBit(std::uint64_t value)
+        {
+            int bit{ 0 };
+            while(value >>= 1)
+                ++bit;
+
+            return bit;
+        }
+
+        static std::size_t bucketOf(std::uint64_t value)
+        {
+            if(value < subBuckets)
+                return static_cast<std::size_t>(value);
+
+            // the highest bit picks the power of two, the 3 bits below it the bucket in there
+            const int bit{ highestBit(value) };
+            return static_cast<std::size_t>(bit - 2) * subBuckets + static_cast<std::size_t>((value >> (bit - 3)) & 7);
+        }
+
+        static std::uint64_t largestIn(std::size_t bucket)
+        {
+            if(bucket < subBuckets)
+                return bucket;
+
+            const int bit{ static_cast<int>(bucket / subBuckets) + 2 };
+            const std::uint64_t first{ (subBuckets + bucket % subBuckets) << (bit - 3) };
+            return first + (std::uint64_t{ 1 } << (bit - 3)) - 1;
+        }
+
+        std::uint64_t m_buckets[bucketCount]{};
+        std::uint64_t m_count{ 0 };
+    };
+
+    constexpr const char* invalidResponse{ "Oops, that input is invalid.  Please try again.\n" };
+
+    inline bool isSpace(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\r';
+    }
+
+    enum RequestKind : char
+    {
+        arithmetic,
+        stats,
+        invalid,
+    };
+
+    // "x op y", with spaces (and a '\r' at the end) allowed anywhere between the parts
+    inline RequestKind parseRequest(const char* begin, const char* end, int& x, char& op, int& y)
+    {
+        auto skipSpace{ [&begin, end]{
+            while(begin != end && isSpace(*begin))
+                ++begin;
+        } };
+
+        auto readInteger{ [&begin, end](int& value){
+            std::from_chars_result result{ std::from_chars(begin, end, value) };
+            if(result.ec != std::errc{})
+                return false;
+
+            begin = result.ptr;
+            return true;
+        } };
+
+        skipSpace();
+        if(end - begin >= 5 && std::string_view{ begin, 5 } == "stats")
+        {
+            begin += 5;
+            skipSpace();
+            return begin == end ? stats : invalid;
+        }
+
+        if(!readInteger(x))
+            return invalid;
+
+        skipSpace();
+        if(begin == end || (*begin != '+' && *begin != '-' && *begin != '*' && *begin != '/'))
+            return invalid;
+        op = *begin++;
+
+        skipSpace();
+        if(!readInteger(y))
+            return invalid;
+
+        skipSpace();
+        return begin == end ? arithmetic : invalid;
+    }
+
+    inline void appendInt(std::string& out, std::uint64_t value)
+    {
+        char digits[24];
+        std::to_chars_result result{ std::to_chars(digits, digits + sizeof(digits), value) };
+        out.append(digits, result.ptr);
+    }
+
+    inline void appendMetrics(std::string& out, const ServerMetrics& metrics)
+    {
+        char line[320];
+        int length{ std::snprintf(line, sizeof(line),
+            "connections=%zu accepted=%llu requests=%llu invalid=%llu queue_depth=%zu max_queue_depth=%zu "
+            "bytes_waiting=%zu p50_us=%.1f p99_us=%.1f\n",
+            metrics.connections, static_cast<unsigned long long>(metrics.connectionsAccepted),
+            static_cast<unsigned long long>(metrics.requests), static_cast<unsigned long long>(metrics.invalidRequests),
+            metrics.queueDepth, metrics.maxQueueDepth, metrics.bytesWaiting, metrics.p50Microseconds,
+            metrics.p99Microseconds) };
+
+        if(length > 0)
+            out.append(line, static_cast<std::size_t>(length) < sizeof(line) ? static_cast<std::size_t>(length)
+                                                                              : sizeof(line) - 1);
+    }
+}
+
+#if defined(QUIZ_SERVER_HAS_EPOLL)
+
+class QuizServer
+{
+public:
+    static constexpr std::size_t readLimit{ 64 * 1024 };            // per connection and cycle
+    static constexpr std::size_t responsesLimit{ 1024 * 1024 };     // waiting for one connection, before it isn't read
+    static constexpr int maxEvents{ 256 };
+
+    QuizServer() = default;
+
+    QuizServer(const QuizServer&) = delete;
+    QuizServer& operator=(const QuizServer&) = delete;
+
+    ~QuizServer()
+    {
+        for(Connection& connection : m_connections)
+        {
+            if(connection.fd >= 0)
+                ::close(connection.fd);
+        }
+
+        for(int fd : { m_listener, m_signals, m_epoll })
+        {
+            if(fd >= 0)
+                ::close(fd);
+        }
+    }
+
+    // listens on port (on every address), false (and error filled in) if it can't
+    bool start(int port, std::string& error)
+    {
+        m_epoll = ::epoll_create1(EPOLL_CLOEXEC);
+        if(m_epoll < 0)
+            return fail("epoll_create1", error);
+
+        m_listener = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if(m_listener < 0)
+            return fail("socket", error);
+
+        int on{ 1 };
+        ::setsockopt(m_listener, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_ANY);
+        address.sin_port = htons(static_cast<std::uint16_t>(port));
+        if(::bind(m_listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0)
+            return fail("bind", error);
+        if(::listen(m_listener, SOMAXCONN) != 0)
+            return fail("listen", error);
+
+        // SIGINT and SIGTERM come in through the event loop too, so that it can stop cleanly
+        sigset_t signals{};
+        sigemptyset(&signals);
+        sigaddset(&signals, SIGINT);
+        sigaddset(&signals, SIGTERM);
+        if(::pthread_sigmask(SIG_BLOCK, &signals, nullptr) != 0)
+            return fail("pthread_sigmask", error);
+
+        m_signals = ::signalfd(-1, &signals, SFD_NONBLOCK | SFD_CLOEXEC);
+        if(m_signals < 0)
+            return fail("signalfd", error);
+
+        if(!watch(m_listener, EPOLLIN, EPOLL_CTL_ADD) || !watch(m_signals, EPOLLIN, EPOLL_CTL_ADD))
+            return fail("epoll_ctl", error);
+
+        return true;
+    }
+
+    // serves until SIGINT or SIGTERM, then prints the metrics to metricsOut (if it isn't nullptr); 0, or 1 if epoll fails
+    int run(std::FILE* metricsOut = stderr)
+    {
+        epoll_event events[maxEvents];
+
+        while(!m_stopping)
+        {
+            int count{ ::epoll_wait(m_epoll, events, maxEvents, -1) };
+            if(count < 0)
+            {
+                if(errno == EINTR)
+                    continue;
+
+                std::fprintf(stderr, "epoll_wait: %s\n", std::strerror(errno));
+                return 1;
+            }
+
+            const Clock::time_point now{ Clock::now() };
+            m_batch.clear();
+            m_ranges.clear();
+
+            for(int index{ 0 }; index < count; ++index)
+            {
+                const int fd{ events[index].data.fd };
+                const std::uint32_t happened{ events[index].events };
+
+                if(fd == m_listener)
+                    acceptAll();
+                else if(fd == m_signals)
+                    m_stopping = true;
+                else
+                {
+                    if(happened & EPOLLOUT)
+                        flush(fd, now);
+                    if(happened & (EPOLLIN | EPOLLHUP | EPOLLERR | EPOLLRDHUP))
+                        readFrom(fd);
+                }
+            }
+
+            answer(now);
+        }
+
+        if(metricsOut)
+        {
+            std::string line{};
+            quiz_server::appendMetrics(line, metrics());
+            std::fputs(line.c_str(), metricsOut);
+        }
+
+        return 0;
+    }
+
+    ServerMetrics metrics() const
+    {
+        ServerMetrics result{ m_metrics };
+        result.p50Microseconds = static_cast<double>(m_latency.percentile(0.50)) / 1000.0;
+        result.p99Microseconds = static_cast<double>(m_latency.percentile(0.99)) / 1000.0;
+
+        return result;
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Connection
+    {
+        int fd{ -1 };
+        std::string input{};                    // the start of a line that isn't complete yet
+        std::string output{};                   // responses the kernel didn't take yet
+        std::uint64_t outputRequests{ 0 };      // how many responses are in output
+        Clock::time_point outputSince{};        // when the oldest of them was read
+        bool reading{ true };                   // false while too many responses wait
+        bool writing{ false };                  // waiting for EPOLLOUT
+        bool closing{ false };                  // the client is done sending, close once output is sent
+        bool broken{ false };                   // sending failed, close right away
+        bool discarding{ false };               // skipping the rest of a line that was too long (and answered)
+    };
+
+    struct Request
+    {
+        int x;
+        int y;
+        char op;
+        quiz_server::RequestKind kind;
+        std::uint32_t index;                    // in the column of its operator
+    };
+
+    // the requests of one connection in m_batch
+    struct Range
+    {
+        int fd;
+        std::size_t first;
+        std::size_t count;
+    };
+
+    static bool fail(const char* what, std::string& error)
+    {
+        error = std::string{ what } + ": " + std::strerror(errno);
+        return false;
+    }
+
+    bool watch(int fd, std::uint32_t events, int operation)
+    {
+        epoll_event event{};
+        event.events = events;
+        event.data.fd = fd;
+
+        return ::epoll_ctl(m_epoll, operation, fd, &event) == 0;
+    }
+
+    void updateWatch(Connection& connection)
+    {
+        // (EPOLLRDHUP only while reading, it's level triggered too and would fire every cycle)
+        std::uint32_t events{ 0 };
+        if(connection.reading && !connection.closing)
+            events |= EPOLLIN | EPOLLRDHUP;
+        if(connection.writing)
+            events |= EPOLLOUT;
+
+        watch(connection.fd, events, EPOLL_CTL_MOD);
+    }
+
+    void acceptAll()
+    {
+        while(true)
+        {
+            int fd{ ::accept4(m_listener, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC) };
+            if(fd < 0)
+            {
+                // out of file descriptors (or memory): the listener would stay readable and wake epoll_wait() over
+                // and over, so it isn't watched until a connection closes
+                if(errno == EMFILE || errno == ENFILE || errno == ENOBUFS || errno == ENOMEM)
+                {
+                    std::fprintf(stderr, "accept: %s, no new connections until one closes\n", std::strerror(errno));
+                    m_acceptPaused = watch(m_listener, 0, EPOLL_CTL_MOD);
+                }
+                return;     // EAGAIN: all accepted (anything else: the client is gone already)
+            }
+
+            int on{ 1 };
+            ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+
+            if(static_cast<std::size_t>(fd) >= m_connections.size())
+                m_connections.resize(static_cast<std::size_t>(fd) + 1);
+
+            Connection& connection{ m_connections[static_cast<std::size_t>(fd)] };
+            connection = Connection{};
+            connection.fd = fd;
+
+            if(!watch(fd, EPOLLIN | EPOLLRDHUP, EPOLL_CTL_ADD))
+            {
+                ::close(fd);
+                connection.fd = -1;
+                continue;
+            }
+
+            ++m_metrics.connections;
+            ++m_metrics.connectionsAccepted;
+        }
+    }
+
+    void closeConnection(Connection& connection)
+    {
+        m_metrics.bytesWaiting -= connection.output.size();
+        ::close(connection.fd);     // also takes it out of the epoll set
+        connection = Connection{};
+        --m_metrics.connections;
+
+        if(m_acceptPaused)
+            m_acceptPaused = !watch(m_listener, EPOLLIN, EPOLL_CTL_MOD);
+    }
+
+    // reads what has come in and adds the complete lines to m_batch
+    void readFrom(int fd)
+    {
+        Connection& connection{ m_connections[static_cast<std::size_t>(fd)] };
+        if(connection.fd < 0 || !connection.reading || connection.closing)
+            return;
+
+        std::string& input{ connection.input };
+        std::size_t before{ input.size() };
+        input.resize(before + readLimit);
+
+        ssize_t got{ ::read(fd, &input[before], readLimit) };
+        if(got <= 0)
+        {
+            input.resize(before);
+            if(got < 0 && (errno == EAGAIN || errno == EINTR))
+                return;
+
+            // the client closed (or the connection broke): answer what's there, close when it's sent
+            connection.closing = true;
+            if(connection.output.empty() || got < 0)
+                closeConnection(connection);
+            else
+                updateWatch(connection);
+            return;
+        }
+        input.resize(before + static_cast<std::size_t>(got));
+
+        // the rest of a line that was too long belongs to the request that was answered already
+        if(connection.discarding)
+        {
+            const void* newline{ std::memchr(input.data() + before, '\n', input.size() - before) };
+            if(!newline)
+            {
+                input.clear();
+                return;
+            }
+
+            input.erase(0, static_cast<std::size_t>(static_cast<const char*>(newline) - input.data()) + 1);
+            connection.discarding = false;
+            before = 0;
+        }
+
+        Range range{ fd, m_batch.size(), 0 };
+        const char* data{ input.data() };
+        std::size_t lineStart{ 0 };
+        for(std::size_t position{ before }; position < input.size(); ++position)
+        {
+            if(data[position] != '\n')
+                continue;
+
+            Request request{};
+            request.kind = quiz_server::parseRequest(data + lineStart, data + position, request.x, request.op, request.y);
+            m_batch.push_back(request);
+            lineStart = position + 1;
+        }
+        input.erase(0, lineStart);
+
+        // a "line" that long is nobody's request: it gets one "invalid" now, and the rest of it, up to its '\n', is
+        // skipped
+        if(input.size() > readLimit)
+        {
+            Request request{};
+            request.kind = quiz_server::invalid;
+            m_batch.push_back(request);
+            input.clear();
+            connection.discarding = true;
+        }
+
+        range.count = m_batch.size() - range.first;
+        if(range.count > 0)
+            m_ranges.push_back(range);
+    }
+
+    // works out the whole batch and sends every connection its responses
+    void answer(Clock::time_point now)
+    {
+        using quiz_server::arithmetic;
+
+        m_metrics.queueDepth = m_batch.size();
+        if(m_batch.size() > m_metrics.maxQueueDepth)
+            m_metrics.maxQueueDepth = m_batch.size();
+        if(m_batch.empty())
+            return;
+
+        // one column per operator
+        constexpr char operators[]{ '+', '-', '*', '/' };
+        for(Column& column : m_columns)
+        {
+            column.x.clear();
+            column.y.clear();
+        }
+
+        for(Request& request : m_batch)
+        {
+            if(request.kind != arithmetic)
+                continue;
+
+            Column& column{ m_columns[columnOf(request.op)] };
+            request.index = static_cast<std::uint32_t>(column.x.size());
+            column.x.push_back(request.x);
+            column.y.push_back(request.y);
+        }
+
+        for(std::size_t op{ 0 }; op < std::size(operators); ++op)
+        {
+            Column& column{ m_columns[op] };
+            column.results.resize(column.x.size());
+            if(!column.x.empty())
+                evaluateBatch(operators[op], column.x.data(), column.y.data(), column.results.data(), column.x.size());
+        }
+
+        for(const Range& range : m_ranges)
+        {
+            Connection& connection{ m_connections[static_cast<std::size_t>(range.fd)] };
+            if(connection.fd < 0)
+                continue;
+
+            m_responses.clear();
+            for(std::size_t index{ range.first }; index < range.first + range.count; ++index)
+            {
+                const Request& request{ m_batch[index] };
+                switch(request.kind)
+                {
+                case arithmetic:
+                    if(request.op == '/' && request.y == 0)
+                        m_responses += "division by zero\n";
+                    else
+                    {
+                        int result{ m_columns[columnOf(request.op)].results[request.index] };
+                        if(result < 0)
+                            m_responses += '-';
+                        // the magnitude as unsigned, -INT_MIN doesn't fit in an int
+                        quiz_server::appendInt(m_responses, result < 0 ? 0ull - static_cast<unsigned long long>(result)
+                                                                       : static_cast<unsigned long long>(result));
+                        m_responses += '\n';
+                    }
+                    break;
+
+                case quiz_server::stats:
+                    quiz_server::appendMetrics(m_responses, metrics());
+                    break;
+
+                default:
+                    m_responses += quiz_server::invalidResponse;
+                    ++m_metrics.invalidRequests;
+                    break;
+                }
+            }
+
+            m_metrics.requests += range.count;
+            send(connection, range.count, now);
+        }
+    }
+
+    static std::size_t columnOf(char op)
+    {
+        switch(op)
+        {
+        case '+':
+            return 0;
+        case '-':
+            return 1;
+        case '*':
+            return 2;
+        default:
+            return 3;
+        }
+    }
+
+    // sends what's waiting and m_responses (the responses to count requests read at now) in one go
+    void send(Connection& connection, std::size_t count, Clock::time_point now)
+    {
+        iovec pieces[2]{};
+        int pieceCount{ 0 };
+        if(!connection.output.empty())
+            pieces[pieceCount++] = iovec{ &connection.output[0], connection.output.size() };
+        if(!m_responses.empty())
+            pieces[pieceCount++] = iovec{ &m_responses[0], m_responses.size() };
+
+        const std::size_t waiting{ connection.output.size() };
+        const std::size_t total{ waiting + m_responses.size() };
+        std::size_t sent{ write(connection, pieces, pieceCount) };
+
+        if(sent == total)
+        {
+            const Clock::time_point done{ Clock::now() };
+            if(connection.outputRequests > 0)
+                m_latency.add(nanosecondsBetween(connection.outputSince, done), connection.outputRequests);
+            if(count > 0)
+                m_latency.add(nanosecondsBetween(now, done), count);
+
+            m_metrics.bytesWaiting -= waiting;
+            connection.output.clear();
+            connection.outputRequests = 0;
+        }
+        else
+        {
+            // keep what's left, in order: the rest of the old output, then the rest of the new responses
+            if(sent < waiting)
+            {
+                connection.output.erase(0, sent);
+                connection.output += m_responses;
+            }
+            else
+                connection.output.assign(m_responses, sent - waiting, std::string::npos);
+
+            m_metrics.bytesWaiting += connection.output.size();
+            m_metrics.bytesWaiting -= waiting;
+
+            if(connection.outputRequests == 0)
+                connection.outputSince = now;
+            connection.outputRequests += count;
+        }
+
+        afterSend(connection);
+    }
+
+    // EPOLLOUT: the kernel can take more of what's waiting
+    void flush(int fd, Clock::time_point now)
+    {
+        Connection& connection{ m_connections[static_cast<std::size_t>(fd)] };
+        if(connection.fd < 0 || connection.output.empty())
+            return;
+
+        m_responses.clear();
+        send(connection, 0, now);
+    }
+
+    // as much of pieces as the kernel takes right now
+    std::size_t write(Connection& connection, iovec* pieces, int pieceCount)
+    {
+        if(pieceCount == 0)
+            return 0;
+
+        msghdr message{};
+        message.msg_iov = pieces;
+        message.msg_iovlen = static_cast<std::size_t>(pieceCount);
+
+        while(true)
+        {
+            // MSG_NOSIGNAL: a client that is gone is an error here, not a SIGPIPE that ends the server
+            ssize_t sent{ ::sendmsg(connection.fd, &message, MSG_NOSIGNAL) };
+            if(sent >= 0)
+                return static_cast<std::size_t>(sent);
+            if(errno == EINTR)
+                continue;
+            if(errno != EAGAIN && errno != EWOULDBLOCK)
+                connection.broken = true;       // nothing more can be sent
+
+            return 0;
+        }
+    }
+
+    void afterSend(Connection& connection)
+    {
+        if(connection.broken || (connection.closing && connection.output.empty()))
+        {
+            closeConnection(connection);
+            return;
+        }
+
+        const bool reading{ connection.output.size() <= responsesLimit };
+        const bool writing{ !connection.output.empty() };
+        if(reading != connection.reading || writing != connection.writing)
+        {
+            connection.reading = reading;
+            connection.writing = writing;
+            updateWatch(connection);
+        }
+    }
+
+    static std::uint64_t nanosecondsBetween(Clock::time_point from, Clock::time_point to)
+    {
+        auto elapsed{ std::chrono::duration_cast<std::chrono::nanoseconds>(to - from).count() };
+        return elapsed > 0 ? static_cast<std::uint64_t>(elapsed) : 0;
+    }
+
+    struct Column
+    {
+        std::vector<int> x{};
+        std::vector<int> y{};
+        std::vector<int> results{};
+    };
+
+    int m_epoll{ -1 };
+    int m_listener{ -1 };
+    int m_signals{ -1 };
+    bool m_stopping{ false };
+    bool m_acceptPaused{ false };               // the listener isn't watched, see acceptAll()
+
+    std::vector<Connection> m_connections{};    // by fd
+    std::vector<Request> m_batch{};
+    std::vector<Range> m_ranges{};
+    Column m_columns[4]{};
+    std::string m_responses{};
+
+    ServerMetrics m_metrics{};
+    quiz_server::LatencyHistogram m_latency{};
+};
+
+#else
+
+class QuizServer
+{
+public:
+    bool start(int, std::string& error)
+    {
+        error = "the server mode needs Linux (epoll)";
+        return false;
+    }
+
+    int run(std::FILE* = stderr) { return 1; }
+    ServerMetrics metrics() const { return {}; }
+};
+
+#endif
+
+#endif
@@ -0,0 +1,211 @@
+#include <chrono> // for std::chrono::steady_clock
+#include <cstdio> // for std::printf
+#include <cstdlib> // for std::atoi
+#include <cstring> // for std::strerror, std::memchr
+#include <string>
+#include <vector>
+#include <cerrno> // for errno
+#include <arpa/inet.h> // for inet_pton
+#include <netinet/in.h> // for sockaddr_in
+#include <netinet/tcp.h> // for TCP_NODELAY
+#include <sys/epoll.h> // for epoll_create1, epoll_ctl, epoll_wait
+#include <sys/socket.h> // for socket, connect
+#include <unistd.h> // for read, write, close
+
+/*
+Load for QuizTime --serve (see quiz_server.h): opens a number of connections to the server and keeps the same number
+of requests in flight on each ("pipelining", a new request for every response that comes back), then prints how many
+requests per second were answered and the server's own metrics. Linux only, build with optimisations, e.g.:
+
+    g++ -std=c++17 -O2 QuizTime.cpp -o QuizTime && ./QuizTime --serve 7070 &
+    g++ -std=c++17 -O2 quiz_server_benchmark.cpp -o quiz_server_benchmark
+    ./quiz_server_benchmark 7070 64 256 5          port, connections, requests in flight per connection, seconds
+
+Every response is checked against the result the request should have.
+*/
+
+struct Client
+{
+    int fd{ -1 };
+    std::string input{};
+    std::vector<int> expected{};    // the results of the requests in flight, oldest first
+    std::size_t oldest{ 0 };
+    unsigned next{ 0 };             // picks the next request
+};
+
+// a request that varies with next, and its result
+void makeRequest(unsigned next, std::string& out, int& expected)
+{
+    const int x{ static_cast<int>(next % 20'000) - 10'000 };
+    const int y{ static_cast<int>((next * 7919u) % 199) - 99 };
+    const char op{ "+-*/"[next % 4] };
+
+    out += std::to_string(x);
+    out += ' ';
+    out += op;
+    out += ' ';
+    out += std::to_string(y);
+    out += '\n';
+
+    switch(op)
+    {
+    case '+': expected = x + y; break;
+    case '-': expected = x - y; break;
+    case '*': expected = x * y; break;
+    default: expected = (y == 0 ? 0 : x / y); break;
+    }
+}
+
+bool writeAll(int fd, const std::string& text)
+{
+    std::size_t done{ 0 };
+    while(done < text.size())
+    {
+        ssize_t written{ ::write(fd, text.data() + done, text.size() - done) };
+        if(written < 0)
+        {
+            if(errno == EINTR)
+                continue;
+            return false;
+        }
+        done += static_cast<std::size_t>(written);
+    }
+
+    return true;
+}
+
+int connectTo(int port)
+{
+    int fd{ ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0) };
+    if(fd < 0)
+        return -1;
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(static_cast<std::uint16_t>(port));
+    ::inet_pton(AF_INET, "127.0.0.1", &address.sin_addr);
+
+    if(::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0)
+    {
+        ::close(fd);
+        return -1;
+    }
+
+    int on{ 1 };
+    ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+    return fd;
+}
+
+int main(int argc, char* argv[])
+{
+    const int port{ argc > 1 ? std::atoi(argv[1]) : 7070 };
+    const int connections{ argc > 2 ? std::atoi(argv[2]) : 64 };
+    const int depth{ argc > 3 ? std::atoi(argv[3]) : 256 };
+    const double seconds{ argc > 4 ? std::atof(argv[4]) : 5.0 };
+
+    int epoll{ ::epoll_create1(EPOLL_CLOEXEC) };
+    std::vector<Client> clients(static_cast<std::size_t>(connections));
+    std::string requests{};
+
+    for(std::size_t index{ 0 }; index < clients.size(); ++index)
+    {
+        Client& client{ clients[index] };
+        client.fd = connectTo(port);
+        if(client.fd < 0)
+        {
+            std::printf("Can't connect to port %d: %s\n", port, std::strerror(errno));
+            return 1;
+        }
+        client.next = static_cast<unsigned>(index) * 1'000'003u;
+
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.u64 = index;
+        ::epoll_ctl(epoll, EPOLL_CTL_ADD, client.fd, &event);
+
+        requests.clear();
+        for(int request{ 0 }; request < depth; ++request)
+        {
+            int expected{};
+            makeRequest(client.next++, requests, expected);
+            client.expected.push_back(expected);
+        }
+        writeAll(client.fd, requests);
+    }
+
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point start{ Clock::now() };
+    const Clock::time_point stop{ start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>{ seconds }) };
+
+    unsigned long long answered{ 0 };
+    unsigned long long wrong{ 0 };
+    std::vector<char> buffer(256 * 1024);
+    epoll_event events[256];
+
+    while(Clock::now() < stop)
+    {
+        int count{ ::epoll_wait(epoll, events, 256, 100) };
+        for(int index{ 0 }; index < count; ++index)
+        {
+            Client& client{ clients[events[index].data.u64] };
+            ssize_t got{ ::read(client.fd, buffer.data(), buffer.size()) };
+            if(got <= 0)
+            {
+                std::printf("The server closed a connection\n");
+                return 1;
+            }
+            client.input.append(buffer.data(), static_cast<std::size_t>(got));
+
+            // check every complete response and send a new request for it
+            requests.clear();
+            std::size_t lineStart{ 0 };
+            for(;;)
+            {
+                const void* newline{ std::memchr(client.input.data() + lineStart, '\n', client.input.size() - lineStart) };
+                if(!newline)
+                    break;
+
+                const std::size_t lineEnd{ static_cast<std::size_t>(static_cast<const char*>(newline) - client.input.data()) };
+                const std::string line{ client.input, lineStart, lineEnd - lineStart };
+                const int expected{ client.expected[client.oldest++] };
+                if(line != (line == "division by zero" ? std::string{ "division by zero" } : std::to_string(expected)))
+                    ++wrong;
+                ++answered;
+                lineStart = lineEnd + 1;
+
+                int result{};
+                makeRequest(client.next++, requests, result);
+                client.expected.push_back(result);
+            }
+            client.input.erase(0, lineStart);
+
+            // the answered ones don't need to be kept
+            if(client.oldest > 4096)
+            {
+                client.expected.erase(client.expected.begin(), client.expected.begin() + static_cast<long>(client.oldest));
+                client.oldest = 0;
+            }
+
+            writeAll(client.fd, requests);
+        }
+    }
+
+    const double elapsed{ std::chrono::duration<double>{ Clock::now() - start }.count() };
+    std::printf("%d connections, %d requests in flight each: %.0f requests/s (%llu answered, %llu wrong)\n",
+                connections, depth, static_cast<double>(answered) / elapsed, answered, wrong);
+
+    // the server's metrics, on a connection of its own
+    int fd{ connectTo(port) };
+    if(fd >= 0 && writeAll(fd, "stats\n"))
+    {
+        ssize_t got{ ::read(fd, buffer.data(), buffer.size()) };
+        if(got > 0)
+            std::printf("server: %.*s", static_cast<int>(got), buffer.data());
+        ::close(fd);
+    }
+
+    for(Client& client : clients)
+        ::close(client.fd);
+
+    return wrong == 0 ? 0 : 1;
+}
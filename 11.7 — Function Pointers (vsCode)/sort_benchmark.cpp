@@ -0,0 +1,125 @@
+#include <iostream>
+#include <vector>
+#include <random> // for std::mt19937
+#include <chrono> // for std::chrono::steady_clock
+#include <algorithm> // for std::sort, std::is_sorted
+#include <utility> // for std::swap
+#include "introsort.h" // for introSort()
+
+/*
+Compares the selection sort from main.cpp, introSort() and std::sort.
+Build with optimisations, e.g.:
+
+    g++ -std=c++17 -O2 sort_benchmark.cpp -o sort_benchmark
+*/
+
+// the original O(n^2) selection sort from the lesson, kept here as the baseline
+void selectionSort_baseline(int *array, int size, bool (*comparisonFcn)(int, int))
+{
+    for(int startIndex{ 0 }; startIndex < (size-1); ++startIndex)
+    {
+        int bestIndex{ startIndex };
+
+        for(int currentIndex{ startIndex+1 }; currentIndex < size; ++currentIndex)
+        {
+            if(comparisonFcn(array[bestIndex], array[currentIndex]))
+                bestIndex = currentIndex;
+        }
+
+        std::swap(array[startIndex], array[bestIndex]);
+    }
+}
+
+bool ascending_for_Ptr(int x, int y)
+{
+    return x > y;
+}
+
+bool evensFirst(int x, int y)
+{
+    if((x%2==0) && !(y%2==0))
+        return false;
+
+    if(!(x%2==0) && (y%2==0))
+        return true;
+
+    return ascending_for_Ptr(x, y);
+}
+
+std::vector<int> makeInput(int size)
+{
+    std::mt19937 mt{ 12345u };
+    std::uniform_int_distribution<int> die{ 0, size };
+
+    std::vector<int> data(static_cast<std::size_t>(size));
+    for(int& value : data)
+        value = die(mt);
+
+    return data;
+}
+
+// runs sortFcn on a fresh copy of input and returns the time in milliseconds
+template <typename SortFcn>
+double timeSort(const std::vector<int>& input, SortFcn sortFcn, bool checkEvensFirst)
+{
+    std::vector<int> data{ input };
+
+    auto start{ std::chrono::steady_clock::now() };
+    sortFcn(data.data(), static_cast<int>(data.size()));
+    auto end{ std::chrono::steady_clock::now() };
+
+    bool sorted{ checkEvensFirst
+        ? std::is_sorted(data.begin(), data.end(), [](int x, int y){ return evensFirst(y, x); })
+        : std::is_sorted(data.begin(), data.end()) };
+    if(!sorted)
+        std::cout << "  (output is NOT sorted!)\n";
+
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+void runComparison(const char* name, int size, bool (*comparisonFcn)(int, int), bool checkEvensFirst)
+{
+    std::vector<int> input{ makeInput(size) };
+
+    std::cout << name << ", " << size << " elements:\n";
+
+    // the selection sort is quadratic, don't wait for it on the big inputs
+    if(size <= 20'000)
+    {
+        std::cout << "  selection sort (fcn ptr):   "
+                  << timeSort(input, [=](int* a, int n){ selectionSort_baseline(a, n, comparisonFcn); }, checkEvensFirst)
+                  << " ms\n";
+    }
+
+    std::cout << "  introSort (fcn ptr):        "
+              << timeSort(input, [=](int* a, int n){ introSort(a, n, comparisonFcn); }, checkEvensFirst) << " ms\n";
+
+    if(checkEvensFirst)
+    {
+        std::cout << "  introSort (lambda):         "
+                  << timeSort(input, [](int* a, int n){ introSort(a, n, [](int x, int y){ return evensFirst(x, y); }); },
+                              checkEvensFirst) << " ms\n";
+        std::cout << "  std::sort (lambda):         "
+                  << timeSort(input, [](int* a, int n){ std::sort(a, a+n, [](int x, int y){ return evensFirst(y, x); }); },
+                              checkEvensFirst) << " ms\n";
+    }
+    else
+    {
+        std::cout << "  introSort (lambda):         "
+                  << timeSort(input, [](int* a, int n){ introSort(a, n, [](int x, int y){ return x > y; }); },
+                              checkEvensFirst) << " ms\n";
+        std::cout << "  std::sort:                  "
+                  << timeSort(input, [](int* a, int n){ std::sort(a, a+n); }, checkEvensFirst) << " ms\n";
+    }
+}
+
+int main()
+{
+    for(int size : { 1'000, 10'000, 20'000, 1'000'000, 10'000'000 })
+    {
+        runComparison("ascending_for_Ptr", size, ascending_for_Ptr, false);
+        runComparison("evensFirst", size, evensFirst, true);
+    }
+
+    return 0;
+}
@@ -0,0 +1,275 @@
+#ifndef ALLOC_TRACKING_H
+#define ALLOC_TRACKING_H
+
+#include <cstddef> // for std::size_t
+
+#if defined(ALLOC_TRACKING)
+#include <cstdio> // for std::fprintf
+#include <cstdint> // for std::uintptr_t, SIZE_MAX
+#include <cstdlib> // for std::malloc, std::free, std::atexit
+#include <new> // for std::bad_alloc, std::align_val_t, std::get_new_handler
+#endif
+
+/*
+Counting what goes to the heap.
+
+Compile with -DALLOC_TRACKING (or #define ALLOC_TRACKING before including this header) and the global operator new and
+operator delete are replaced by ones that count, per thread:
+  - how many allocations and deallocations there were, and how many bytes they were,
+  - how many bytes are in use right now (live), and the most there ever were at once (peak),
+  - how many allocations there were of each size, in powers of two (1, 2-3, 4-7, 8-15, ...).
+When the program ends, a report of the counts of the main thread is printed to stderr.
+The memory itself still comes from std::malloc; every allocation gets 16 bytes in front of it to remember its size.
+Replacing operator new is something a program can only do once, so include the header with ALLOC_TRACKING defined in
+one .cpp file only (each lesson here is a single .cpp file anyway).
+
+AllocationScope measures a block:
+
+    {
+        AllocationScope scope{ "returnStruct" };
+        S s{ returnStruct() };
+    } // prints "returnStruct: 0 allocations (0 bytes), 0 deallocations, peak 0 bytes" to stderr
+
+scope.allocations(), scope.bytes(), scope.deallocations() and scope.peakLiveBytes() give the counts of the block so far
+(on the thread the scope was made on), e.g. to check that something doesn't allocate. Without a name nothing is printed.
+
+Without ALLOC_TRACKING nothing is replaced, AllocationScope is an empty class whose functions return 0 and print
+nothing, and the compiler throws all of it away: it costs nothing.
+*/
+
+#if defined(ALLOC_TRACKING)
+
+namespace alloc_tracking
+{
+    // sizes 0, 1, 2-3, 4-7, ... up to 2^63 and more
+    constexpr int histogramBuckets{ 65 };
+
+    // thread_local and trivially destructible, so it's never constructed or destroyed, and operator new can use it at
+    // any time (even while the thread is starting up or shutting down)
+    struct Counters
+    {
+        std::size_t allocations;
+        std::size_t deallocations;
+        std::size_t bytesAllocated;
+        std::size_t bytesFreed;
+        long long liveBytes;       // can go below 0 on a thread that frees what other threads allocated
+        long long peakLiveBytes;
+        std::size_t histogram[histogramBuckets];
+    };
+
+    inline thread_local Counters t_counters{};
+
+    inline int bucketOf(std::size_t size)
+    {
+        int bucket{ 0 };
+        while(size > 0)
+        {
+            size >>= 1;
+            ++bucket;
+        }
+
+        return bucket;
+    }
+
+    // in front of every allocation: the pointer std::malloc gave and the size that was asked for
+    struct Header
+    {
+        void* raw;
+        std::size_t size;
+    };
+
+    constexpr std::size_t headerSize{ 16 };
+    static_assert(sizeof(Header) <= headerSize, "the header has to fit in front of the allocation");
+
+    inline void* allocate(std::size_t size, std::size_t alignment)
+    {
+        if(alignment < headerSize)
+            alignment = headerSize;
+
+        // room for the header, and for moving the start up to the alignment; a size so big that adding that wraps
+        // around can't be allocated at all (like when malloc fails: the new handler, or std::bad_alloc)
+        const std::size_t extra{ headerSize + (alignment - headerSize) };
+        const bool fits{ size <= SIZE_MAX - extra };
+
+        for(;;)
+        {
+            if(void* raw{ fits ? std::malloc(size + extra) : nullptr })
+            {
+                std::uintptr_t start{ reinterpret_cast<std::uintptr_t>(raw) + headerSize };
+                start = (start + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1);
+
+                void* memory{ reinterpret_cast<void*>(start) };
+                Header* header{ static_cast<Header*>(memory) - 1 };
+                header->raw = raw;
+                header->size = size;
+
+                Counters& counters{ t_counters };
+                ++counters.allocations;
+                counters.bytesAllocated += size;
+                counters.liveBytes += static_cast<long long>(size);
+                if(counters.liveBytes > counters.peakLiveBytes)
+                    counters.peakLiveBytes = counters.liveBytes;
+                ++counters.histogram[bucketOf(size)];
+
+                return memory;
+            }
+
+            // like the standard operator new: let the new handler free some memory, or give up
+            std::new_handler handler{ std::get_new_handler() };
+            if(!handler)
+                throw std::bad_alloc{};
+            handler();
+        }
+    }
+
+    inline void deallocate(void* memory)
+    {
+        if(!memory)
+            return;
+
+        Header* header{ static_cast<Header*>(memory) - 1 };
+
+        Counters& counters{ t_counters };
+        ++counters.deallocations;
+        counters.bytesFreed += header->size;
+        counters.liveBytes -= static_cast<long long>(header->size);
+
+        std::free(header->raw);
+    }
+
+    inline void report()
+    {
+        const Counters& counters{ t_counters };
+
+        std::fprintf(stderr, "allocations: %zu (%zu bytes), deallocations: %zu (%zu bytes), live at exit: %lld bytes, "
+                             "peak: %lld bytes\n",
+                     counters.allocations, counters.bytesAllocated, counters.deallocations, counters.bytesFreed,
+                     counters.liveBytes, counters.peakLiveBytes);
+
+        for(int bucket{ 0 }; bucket < histogramBuckets; ++bucket)
+        {
+            if(counters.histogram[bucket] == 0)
+                continue;
+
+            unsigned long long from{ bucket == 0 ? 0ull : 1ull << (bucket - 1) };
+            unsigned long long to{ bucket == 0 ? 0ull : from * 2 - 1 };
+            std::fprintf(stderr, "    %llu-%llu bytes: %zu\n", from, to, counters.histogram[bucket]);
+        }
+    }
+
+    // the report is printed at exit
+    inline const bool reportRegistered{ std::atexit(report) == 0 };
+}
+
+class AllocationScope
+{
+public:
+    explicit AllocationScope(const char* name = nullptr)
+        : m_name{ name }, m_start{ alloc_tracking::t_counters }
+    {
+        // the peak within the scope starts from what's live now
+        alloc_tracking::t_counters.peakLiveBytes = m_start.liveBytes;
+    }
+
+    ~AllocationScope()
+    {
+        if(m_name)
+        {
+            std::fprintf(stderr, "%s: %zu allocations (%zu bytes), %zu deallocations, peak %lld bytes\n", m_name,
+                         allocations(), bytes(), deallocations(), peakLiveBytes());
+        }
+
+        // the peak outside the scope is the bigger of the one before it and the one in it
+        alloc_tracking::Counters& counters{ alloc_tracking::t_counters };
+        if(m_start.peakLiveBytes > counters.peakLiveBytes)
+            counters.peakLiveBytes = m_start.peakLiveBytes;
+    }
+
+    AllocationScope(const AllocationScope&) = delete;
+    AllocationScope& operator=(const AllocationScope&) = delete;
+
+    std::size_t allocations() const { return alloc_tracking::t_counters.allocations - m_start.allocations; }
+    std::size_t bytes() const { return alloc_tracking::t_counters.bytesAllocated - m_start.bytesAllocated; }
+    std::size_t deallocations() const { return alloc_tracking::t_counters.deallocations - m_start.deallocations; }
+
+    // the most bytes that were in use at once in the scope, on top of what was in use before it
+    long long peakLiveBytes() const { return alloc_tracking::t_counters.peakLiveBytes - m_start.liveBytes; }
+
+private:
+    const char* m_name{ nullptr };
+    alloc_tracking::Counters m_start{};
+};
+
+// the replacements, for every form of new and delete
+void* operator new(std::size_t size) { return alloc_tracking::allocate(size, 0); }
+void* operator new[](std::size_t size) { return alloc_tracking::allocate(size, 0); }
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    return alloc_tracking::allocate(size, static_cast<std::size_t>(alignment));
+}
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+    return alloc_tracking::allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    try
+    {
+        return alloc_tracking::allocate(size, 0);
+    }
+    catch(...)
+    {
+        return nullptr;
+    }
+}
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept { return operator new(size, tag); }
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    try
+    {
+        return alloc_tracking::allocate(size, static_cast<std::size_t>(alignment));
+    }
+    catch(...)
+    {
+        return nullptr;
+    }
+}
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t& tag) noexcept
+{
+    return operator new(size, alignment, tag);
+}
+
+void operator delete(void* memory) noexcept { alloc_tracking::deallocate(memory); }
+void operator delete[](void* memory) noexcept { alloc_tracking::deallocate(memory); }
+void operator delete(void* memory, std::size_t) noexcept { alloc_tracking::deallocate(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { alloc_tracking::deallocate(memory); }
+void operator delete(void* memory, std::align_val_t) noexcept { alloc_tracking::deallocate(memory); }
+void operator delete[](void* memory, std::align_val_t) noexcept { alloc_tracking::deallocate(memory); }
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept { alloc_tracking::deallocate(memory); }
+void operator delete[](void* memory, std::size_t, std::align_val_t) noexcept { alloc_tracking::deallocate(memory); }
+void operator delete(void* memory, const std::nothrow_t&) noexcept { alloc_tracking::deallocate(memory); }
+void operator delete[](void* memory, const std::nothrow_t&) noexcept { alloc_tracking::deallocate(memory); }
+void operator delete(void* memory, std::align_val_t, const std::nothrow_t&) noexcept { alloc_tracking::deallocate(memory); }
+void operator delete[](void* memory, std::align_val_t, const std::nothrow_t&) noexcept { alloc_tracking::deallocate(memory); }
+
+#else
+
+// without ALLOC_TRACKING: nothing is counted, and nothing is left of the scope after compiling
+class AllocationScope
+{
+public:
+    explicit AllocationScope(const char* = nullptr) {}
+
+    AllocationScope(const AllocationScope&) = delete;
+    AllocationScope& operator=(const AllocationScope&) = delete;
+
+    std::size_t allocations() const { return 0; }
+    std::size_t bytes() const { return 0; }
+    std::size_t deallocations() const { return 0; }
+    long long peakLiveBytes() const { return 0; }
+};
+
+#endif
+
+#endif
@@ -1,4 +1,7 @@
 #include <iostream>
+#include <limits> // for std::numeric_limits
+#include <new> // for std::nothrow, std::bad_alloc
+#include "alloc_tracking.h" // for AllocationScope
 
 int foo(int x)
 {
@@ -59,6 +62,42 @@ int main()
     int *ptr2 = new int;
     // ptr1 and ptr2 may not have sequential addresses
 
+    /*
+    How much goes to the heap can be measured: compiled with -DALLOC_TRACKING (see alloc_tracking.h), every new and
+    delete is counted, and an AllocationScope prints the counts of its block to stderr when it ends. Compiled without,
+    the scope does nothing.
+    */
+    {
+        AllocationScope scope{ "new int and new int[10]" };
+        int* one{ new int };
+        int* ten{ new int[10] };
+        delete one;
+        delete[] ten;
+    }
+
+    /*
+    A request for more than there can ever be fails the way the standard operator new does, tracked or not: operator
+    new throws std::bad_alloc, and operator new with std::nothrow returns nullptr.
+    */
+    {
+        volatile std::size_t request{ std::numeric_limits<std::size_t>::max() - 4 };    // so the compiler doesn't warn
+        const std::size_t huge{ request };
+        void* tooBig{ ::operator new(huge, std::nothrow) };
+        std::cout << "operator new(" << huge << ", std::nothrow) is " << (tooBig ? "not null!" : "nullptr") << '\n';
+        ::operator delete(tooBig);
+
+        try
+        {
+            void* memory{ ::operator new(huge) };
+            std::cout << "operator new(" << huge << ") didn't throw!\n";
+            ::operator delete(memory);
+        }
+        catch(const std::bad_alloc&)
+        {
+            std::cout << "operator new(" << huge << ") throws std::bad_alloc\n";
+        }
+    }
+
     /*
     When a dynamically allocated variable is deleted, the memory is “returned” to the heap and can then be reassigned as 
     future allocation requests are received. Remember that deleting a pointer does not delete the variable, it just returns 
@@ -1,19 +1,7 @@
 #include <iostream>
 #include <vector>
-
-void printStack(const std::vector<int>& stack)
-{
-    for(auto element : stack)
-        std::cout << element << ' ';
-    std::cout << "(cap " << stack.capacity() << " length " << stack.size() << ")\n";
-}
-
-void printStack_double(const std::vector<double>& stack)
-{
-    for(auto element : stack)
-        std::cout << element << ' ';
-    std::cout << "(cap " << stack.capacity() << " length " << stack.size() << ")\n";
-}
+#include "print_stack.h" // for printStack
+#include "small_vector.h" // for small_vector
 
 int main()
 {
@@ -169,6 +157,31 @@ int main()
     stack.reserve(77);// Set the capacity to (at least) 77
     printStack(stack);
 
+    /*
+    small_vector (see small_vector.h) is a stack that keeps its first few elements inside itself, so a small stack
+    doesn't allocate at all, and that lets us pick how it grows. It counts how often it had to move its elements and
+    how many bytes that was, and printStack() shows those counters as well:
+    */
+    small_vector<int, 2> small_stack{};
+    printStack(small_stack);
+
+    small_stack.push_back(5); // fits into the 2 inline elements
+    small_stack.push_back(3);
+    printStack(small_stack);
+
+    small_stack.push_back(2); // no room left: moves to the heap, with twice the capacity
+    printStack(small_stack);
+
+    small_stack.pop_back();
+    printStack(small_stack);
+
+    // growing to 1000 elements by 1.5 times instead of 2 times: more moves, less unused capacity
+    small_vector<int, 2, GrowByHalf> growing_stack{};
+    for(int i{ 0 }; i < 1000; ++i)
+        growing_stack.push_back(i);
+    std::cout << "1.5x: " << growing_stack.stats().reallocations << " reallocations, "
+              << growing_stack.stats().bytesMoved << " bytes moved, capacity " << growing_stack.capacity() << '\n';
+
 
     std::cout << std::endl;
     ////////////////////////////////////////////////////////////////////////////////////////////
@@ -186,7 +199,7 @@ int main()
     double_vector.push_back(77.77);// add another element
     std::cout << "size: " << double_vector.size() << " cap: " << double_vector.capacity() << '\n';
 
-    printStack_double(double_vector);
+    printStack(double_vector); // the same printStack() works for a std::vector<double>
 
     /*
     When we used push_back() to add a new element, our vector only needed room for 6 elements, but allocated room for 12. 
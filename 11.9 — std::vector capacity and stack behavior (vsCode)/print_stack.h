@@ -0,0 +1,237 @@
+#ifndef PRINT_STACK_H
+#define PRINT_STACK_H
+
+#include <charconv> // for std::to_chars
+#include <cstddef> // for std::size_t
+#include <cstdio> // for std::FILE, std::fwrite
+#include <cstring> // for std::memcpy
+#include <type_traits> // for std::is_arithmetic, std::is_floating_point, std::is_same, std::void_t
+#include <utility> // for std::declval
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h> // for write
+#define PRINT_STACK_HAS_FD 1
+#endif
+
+/*
+printStack() without iostreams.
+
+std::cout << element goes through the stream's locale and formatting flags (and locks the stream) once per element,
+which adds up for a stack of a million elements. printStack(stack) formats the elements with std::to_chars into a
+StackWriter, a 64 KB buffer that is written out in one go whenever it's full and at the end. The text is exactly what
+the std::cout version printed: the elements with a space after each (floating point numbers like std::cout shows them
+by default, i.e. 6 significant digits), then "(cap X length Y)" and a newline.
+The buffer of printStack(stack), which writes to stdout, is reused from call to call.
+
+A StackWriter can write to:
+  - a FILE*, stdout if nothing else is given. Since std::cout is synchronized with stdout by default, the lines still
+    come out in the right order when the program mixes std::cout and printStack(),
+  - a file descriptor (on systems that have them), with write() and no stdio buffering in between,
+  - a buffer the caller provides. Nothing is written anywhere; what doesn't fit is cut off and overflowed() says so.
+
+printStack() takes anything with begin(), end(), size() and capacity(), e.g. std::vector<int> and std::vector<double>.
+Stacks that count what growing costs them, like small_vector (small_vector.h), have a stats() function, and for those
+the counters are printed too: "(cap X length Y reallocations R moved B bytes peak P)".
+*/
+
+class StackWriter
+{
+public:
+    static constexpr std::size_t bufferSize{ 64 * 1024 };
+
+    explicit StackWriter(std::FILE* file = stdout)
+        : m_file{ file }, m_data{ m_buffer }, m_capacity{ bufferSize }
+    {
+    }
+
+#if defined(PRINT_STACK_HAS_FD)
+    struct FileDescriptor
+    {
+        int fd;
+    };
+
+    // StackWriter out{ StackWriter::FileDescriptor{ 1 } } writes straight to fd 1
+    explicit StackWriter(FileDescriptor fd)
+        : m_fd{ fd.fd }, m_data{ m_buffer }, m_capacity{ bufferSize }
+    {
+    }
+#endif
+
+    // the text goes into buffer (size bytes) and stays there, see written()
+    StackWriter(char* buffer, std::size_t size)
+        : m_data{ buffer }, m_capacity{ size }, m_callerBuffer{ true }
+    {
+    }
+
+    ~StackWriter()
+    {
+        flush();
+    }
+
+    StackWriter(const StackWriter&) = delete;
+    StackWriter& operator=(const StackWriter&) = delete;
+
+    void write(const char* text, std::size_t length)
+    {
+        while(length > 0)
+        {
+            if(m_used == m_capacity && !makeRoom())
+                return;
+
+            std::size_t part{ m_capacity - m_used < length ? m_capacity - m_used : length };
+            std::memcpy(m_data + m_used, text, part);
+            m_used += part;
+            text += part;
+            length -= part;
+        }
+    }
+
+    void write(char c)
+    {
+        if(m_used == m_capacity && !makeRoom())
+            return;
+
+        m_data[m_used++] = c;
+    }
+
+    template <typename T>
+    void writeNumber(T value)
+    {
+        static_assert(std::is_arithmetic<T>::value, "writeNumber only writes numbers");
+
+        // std::cout prints chars (signed char and unsigned char too, so std::int8_t and std::uint8_t) as characters
+        // and bools as 0 and 1
+        if constexpr(std::is_same<T, char>::value || std::is_same<T, signed char>::value ||
+                     std::is_same<T, unsigned char>::value)
+            write(static_cast<char>(value));
+        else if constexpr(std::is_same<T, bool>::value)
+            write(value ? '1' : '0');
+        else
+        {
+            // room for any integer, and for a double in the format below
+            char text[64];
+            std::to_chars_result result{};
+
+            if constexpr(std::is_floating_point<T>::value)
+                result = std::to_chars(text, text + sizeof(text), value, std::chars_format::general, 6);
+            else
+                result = std::to_chars(text, text + sizeof(text), value);
+
+            write(text, static_cast<std::size_t>(result.ptr - text));
+        }
+    }
+
+    // writes out what's in the buffer (nothing to do for a caller's buffer), false if that didn't work
+    bool flush()
+    {
+        if(m_callerBuffer || m_used == 0)
+            return !m_failed;
+
+        bool ok{ true };
+        if(m_file)
+            ok = std::fwrite(m_data, 1, m_used, m_file) == m_used;
+#if defined(PRINT_STACK_HAS_FD)
+        else if(m_fd >= 0)
+        {
+            std::size_t done{ 0 };
+            while(done < m_used)
+            {
+                ssize_t written{ ::write(m_fd, m_data + done, m_used - done) };
+                if(written <= 0)
+                {
+                    ok = false;
+                    break;
+                }
+                done += static_cast<std::size_t>(written);
+            }
+        }
+#endif
+
+        m_used = 0;
+        if(!ok)
+            m_failed = true;
+
+        return !m_failed;
+    }
+
+    // bytes in the buffer: for a caller's buffer, the length of the text
+    std::size_t written() const { return m_used; }
+
+    // a caller's buffer was too small for all of the text
+    bool overflowed() const { return m_overflowed; }
+
+private:
+    bool makeRoom()
+    {
+        if(m_callerBuffer)
+        {
+            m_overflowed = true;
+            return false;
+        }
+
+        flush();
+        return true;
+    }
+
+    std::FILE* m_file{ nullptr };
+    int m_fd{ -1 };
+
+    char m_buffer[bufferSize];
+    char* m_data{ nullptr };
+    std::size_t m_capacity{ 0 };
+    std::size_t m_used{ 0 };
+    bool m_callerBuffer{ false };
+    bool m_overflowed{ false };
+    bool m_failed{ false };
+};
+
+// does Stack have a stats() function with reallocations, bytesMoved and peakCapacity?
+template <typename Stack, typename = void>
+struct HasStackStats : std::false_type
+{
+};
+
+template <typename Stack>
+struct HasStackStats<Stack, std::void_t<decltype(std::declval<const Stack&>().stats().reallocations)>> : std::true_type
+{
+};
+
+template <typename Stack>
+void printStack(const Stack& stack, StackWriter& out)
+{
+    for(const auto& element : stack)
+    {
+        out.writeNumber(element);
+        out.write(' ');
+    }
+
+    out.write("(cap ", 5);
+    out.writeNumber(stack.capacity());
+    out.write(" length ", 8);
+    out.writeNumber(stack.size());
+
+    if constexpr(HasStackStats<Stack>::value)
+    {
+        const auto& stats{ stack.stats() };
+        out.write(" reallocations ", 15);
+        out.writeNumber(stats.reallocations);
+        out.write(" moved ", 7);
+        out.writeNumber(stats.bytesMoved);
+        out.write(" bytes peak ", 12);
+        out.writeNumber(stats.peakCapacity);
+    }
+
+    out.write(")\n", 2);
+}
+
+// to stdout, like the std::cout version. The buffer is kept for the next call, but emptied every time, so that
+// whatever the program prints next comes after the stack
+template <typename Stack>
+void printStack(const Stack& stack)
+{
+    static thread_local StackWriter t_out{};
+    printStack(stack, t_out);
+    t_out.flush();
+}
+
+#endif
@@ -0,0 +1,81 @@
+#include <iostream>
+#include <chrono> // for std::chrono::steady_clock
+#include <cstdio> // for std::fopen
+#include <vector>
+#include "print_stack.h" // for printStack, StackWriter
+
+/*
+Compares the std::cout printStack() from main.cpp with the StackWriter one, for a stack of a million ints and one of a
+million doubles. Run it with the output going somewhere, so that the terminal doesn't decide the timings, e.g.:
+
+    g++ -std=c++17 -O2 print_stack_benchmark.cpp -o print_stack_benchmark
+    ./print_stack_benchmark > /dev/null
+
+The timings are printed to std::cerr.
+*/
+
+// printStack() and printStack_double() from main.cpp, kept here as the baseline
+void printStack_cout(const std::vector<int>& stack)
+{
+    for(auto element : stack)
+        std::cout << element << ' ';
+    std::cout << "(cap " << stack.capacity() << " length " << stack.size() << ")\n";
+}
+
+void printStack_double_cout(const std::vector<double>& stack)
+{
+    for(auto element : stack)
+        std::cout << element << ' ';
+    std::cout << "(cap " << stack.capacity() << " length " << stack.size() << ")\n";
+}
+
+template <typename Fcn>
+double timeIt(Fcn fcn)
+{
+    auto start{ std::chrono::steady_clock::now() };
+    fcn();
+    auto end{ std::chrono::steady_clock::now() };
+
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+int main()
+{
+    constexpr int count{ 1'000'000 };
+
+    std::vector<int> ints{};
+    std::vector<double> doubles{};
+    for(int i{ 0 }; i < count; ++i)
+    {
+        ints.push_back((i % 1000) * 7919 - 3'000'000);
+        doubles.push_back(i * 0.37 - 12'345.678);
+    }
+
+    std::cerr << count << " ints:\n";
+    std::cerr << "  std::cout:               " << timeIt([&]{ printStack_cout(ints); std::cout.flush(); }) << " ms\n";
+    std::cerr << "  printStack (stdout):     " << timeIt([&]{ printStack(ints); }) << " ms\n";
+#if defined(PRINT_STACK_HAS_FD)
+    std::cerr << "  printStack (fd 1):       " << timeIt([&]{
+        std::fflush(stdout);
+        StackWriter out{ StackWriter::FileDescriptor{ 1 } };
+        printStack(ints, out);
+    }) << " ms\n";
+#endif
+
+    static char buffer[32 * 1024 * 1024];
+    std::cerr << "  printStack (buffer):     " << timeIt([&]{
+        StackWriter out{ buffer, sizeof(buffer) };
+        printStack(ints, out);
+    }) << " ms\n";
+
+    std::cerr << count << " doubles:\n";
+    std::cerr << "  std::cout:               " << timeIt([&]{ printStack_double_cout(doubles); std::cout.flush(); })
+              << " ms\n";
+    std::cerr << "  printStack (stdout):     " << timeIt([&]{ printStack(doubles); }) << " ms\n";
+    std::cerr << "  printStack (buffer):     " << timeIt([&]{
+        StackWriter out{ buffer, sizeof(buffer) };
+        printStack(doubles, out);
+    }) << " ms\n";
+
+    return 0;
+}
@@ -0,0 +1,288 @@
+#ifndef SMALL_VECTOR_H
+#define SMALL_VECTOR_H
+
+#include <cstddef> // for std::size_t
+#include <memory> // for std::allocator
+#include <new> // for placement new
+#include <type_traits> // for std::is_nothrow_move_constructible
+#include <utility> // for std::move, std::move_if_noexcept, std::forward
+
+/*
+A std::vector for using as a stack, which keeps its first N elements inside itself and counts what growing costs.
+
+small_vector<int, 16> stack{} can hold 16 ints without allocating anything: they are stored in a buffer inside the
+small_vector (so a small stack that lives on the stack stays on the stack). Only when the 17th element is pushed does
+it move (like std::vector does when it runs out of capacity) into memory from the heap.
+
+How much bigger the new capacity is, is up to the growth policy, the third template argument:
+  - GrowDouble:         2 times the capacity (what most std::vector implementations do),
+  - GrowByHalf:         1.5 times the capacity (less memory wasted, a few more moves),
+  - GrowByChunk<1024>:  1024 elements more each time (for stacks that grow slowly and steadily).
+A policy is a struct with a static function nextCapacity(capacity, needed) that returns the new capacity (at least
+needed), so it's easy to add others.
+
+stats() tells what growing has cost so far:
+  - reallocations: how often the elements were moved to a bigger buffer,
+  - bytesMoved:    how many bytes of elements were moved while doing so,
+  - peakCapacity:  the biggest capacity it ever had.
+printStack() (print_stack.h) prints those after the capacity and length.
+*/
+
+struct GrowDouble
+{
+    static std::size_t nextCapacity(std::size_t capacity, std::size_t needed)
+    {
+        std::size_t next{ capacity * 2 };
+        return next < needed ? needed : next;
+    }
+};
+
+struct GrowByHalf
+{
+    static std::size_t nextCapacity(std::size_t capacity, std::size_t needed)
+    {
+        std::size_t next{ capacity + capacity / 2 };
+        return next < needed ? needed : next;
+    }
+};
+
+template <std::size_t Chunk>
+struct GrowByChunk
+{
+    static_assert(Chunk > 0, "the chunk has to have at least one element");
+
+    static std::size_t nextCapacity(std::size_t capacity, std::size_t needed)
+    {
+        std::size_t next{ capacity + Chunk };
+        return next < needed ? needed : next;
+    }
+};
+
+struct StackStats
+{
+    std::size_t reallocations{ 0 };
+    std::size_t bytesMoved{ 0 };
+    std::size_t peakCapacity{ 0 };
+};
+
+template <typename T, std::size_t N, typename Growth = GrowDouble>
+class small_vector
+{
+public:
+    using value_type = T;
+
+    small_vector() noexcept = default;
+
+    small_vector(const small_vector& other)
+    {
+        reserve(other.m_size);
+        for(const T& element : other)
+            push_back(element);
+    }
+
+    // the elements of other are moved one by one if other keeps them inline, otherwise its heap buffer is just taken
+    small_vector(small_vector&& other) noexcept(std::is_nothrow_move_constructible<T>::value)
+    {
+        takeFrom(other);
+    }
+
+    ~small_vector()
+    {
+        clear();
+        release();
+    }
+
+    small_vector& operator=(const small_vector& other)
+    {
+        if(this != &other)
+        {
+            clear();
+            reserve(other.m_size);
+            for(const T& element : other)
+                push_back(element);
+        }
+
+        return *this;
+    }
+
+    small_vector& operator=(small_vector&& other) noexcept(std::is_nothrow_move_constructible<T>::value)
+    {
+        if(this != &other)
+        {
+            clear();
+            release();
+            m_data = inlineData();
+            m_capacity = inlineCapacity;
+            takeFrom(other);
+        }
+
+        return *this;
+    }
+
+    void push_back(const T& value) { emplace_back(value); }
+    void push_back(T&& value) { emplace_back(std::move(value)); }
+
+    template <typename... Args>
+    T& emplace_back(Args&&... args)
+    {
+        if(m_size == m_capacity)
+        {
+            // value might be one of our own elements, so it's built in the new buffer before the old one goes away
+            std::size_t capacity{ Growth::nextCapacity(m_capacity, m_size + 1) };
+            T* data{ allocate(capacity) };
+            try
+            {
+                ::new(static_cast<void*>(data + m_size)) T(std::forward<Args>(args)...);
+            }
+            catch(...)
+            {
+                deallocate(data, capacity);
+                throw;
+            }
+            moveTo(data, capacity, true);
+        }
+        else
+            ::new(static_cast<void*>(m_data + m_size)) T(std::forward<Args>(args)...);
+
+        return m_data[m_size++];
+    }
+
+    void pop_back()
+    {
+        m_data[--m_size].~T();
+    }
+
+    T& back() { return m_data[m_size - 1]; }
+    const T& back() const { return m_data[m_size - 1]; }
+
+    T& operator[](std::size_t index) { return m_data[index]; }
+    const T& operator[](std::size_t index) const { return m_data[index]; }
+
+    T* data() { return m_data; }
+    const T* data() const { return m_data; }
+
+    T* begin() { return m_data; }
+    T* end() { return m_data + m_size; }
+    const T* begin() const { return m_data; }
+    const T* end() const { return m_data + m_size; }
+
+    std::size_t size() const { return m_size; }
+    std::size_t capacity() const { return m_capacity; }
+    bool empty() const { return m_size == 0; }
+
+    // true while the elements are still in the inline buffer
+    bool isInline() const { return m_data == inlineData(); }
+
+    const StackStats& stats() const { return m_stats; }
+
+    // like std::vector::reserve(), exactly capacity elements (the growth policy is for push_back())
+    void reserve(std::size_t capacity)
+    {
+        if(capacity > m_capacity)
+        {
+            T* data{ allocate(capacity) };
+            moveTo(data, capacity);
+        }
+    }
+
+    void clear()
+    {
+        while(m_size > 0)
+            pop_back();
+    }
+
+private:
+    static constexpr std::size_t inlineCapacity{ N };
+
+    T* inlineData() { return reinterpret_cast<T*>(m_inline); }
+    const T* inlineData() const { return reinterpret_cast<const T*>(m_inline); }
+
+    static T* allocate(std::size_t capacity)
+    {
+        std::allocator<T> allocator{};
+        return allocator.allocate(capacity);
+    }
+
+    static void deallocate(T* data, std::size_t capacity)
+    {
+        std::allocator<T> allocator{};
+        allocator.deallocate(data, capacity);
+    }
+
+    // gives the heap buffer back (the inline one stays)
+    void release()
+    {
+        if(!isInline())
+            deallocate(m_data, m_capacity);
+    }
+
+    // moves the elements into data (capacity elements big) and makes it the buffer; newElement says that
+    // data[m_size] is already built (by emplace_back())
+    // if an element's copy constructor throws (move_if_noexcept copies when moving could throw), what has been built
+    // in data is destroyed, data is deallocated and the old buffer stays as it was
+    void moveTo(T* data, std::size_t capacity, bool newElement = false)
+    {
+        std::size_t built{ 0 };
+        try
+        {
+            for(; built < m_size; ++built)
+                ::new(static_cast<void*>(data + built)) T(std::move_if_noexcept(m_data[built]));
+        }
+        catch(...)
+        {
+            for(std::size_t i{ 0 }; i < built; ++i)
+                data[i].~T();
+            if(newElement)
+                data[m_size].~T();
+            deallocate(data, capacity);
+            throw;
+        }
+
+        for(std::size_t i{ 0 }; i < m_size; ++i)
+            m_data[i].~T();
+
+        ++m_stats.reallocations;
+        m_stats.bytesMoved += m_size * sizeof(T);
+
+        release();
+        m_data = data;
+        m_capacity = capacity;
+
+        if(m_capacity > m_stats.peakCapacity)
+            m_stats.peakCapacity = m_capacity;
+    }
+
+    // takes over the elements (and the stats) of other, which is left empty, with only its inline buffer
+    void takeFrom(small_vector& other)
+    {
+        if(other.isInline())
+        {
+            for(std::size_t i{ 0 }; i < other.m_size; ++i)
+                ::new(static_cast<void*>(m_data + i)) T(std::move(other.m_data[i]));
+            m_size = other.m_size;
+            other.clear();
+        }
+        else
+        {
+            m_data = other.m_data;
+            m_capacity = other.m_capacity;
+            m_size = other.m_size;
+
+            other.m_data = other.inlineData();
+            other.m_capacity = inlineCapacity;
+            other.m_size = 0;
+        }
+
+        m_stats = other.m_stats;
+        other.m_stats = StackStats{ 0, 0, inlineCapacity };
+    }
+
+    // N elements (at least one byte, an array can't be empty)
+    alignas(T) unsigned char m_inline[N > 0 ? N * sizeof(T) : 1];
+    T* m_data{ inlineData() };
+    std::size_t m_size{ 0 };
+    std::size_t m_capacity{ inlineCapacity };
+    StackStats m_stats{ 0, 0, inlineCapacity };
+};
+
+#endif
@@ -0,0 +1,92 @@
+#include <iostream>
+#include <chrono> // for std::chrono::steady_clock
+#include <cstddef> // for std::size_t
+#include <vector>
+#include "small_vector.h" // for small_vector, GrowDouble, GrowByHalf, GrowByChunk
+
+/*
+Compares std::vector with small_vector as a stack:
+  - lots of small stacks (at most 16 elements), where small_vector<int, 16> never allocates,
+  - one stack that grows to 10 million elements, with each growth policy, and what that costs in moves.
+
+    g++ -std=c++17 -O2 small_vector_benchmark.cpp -o small_vector_benchmark
+*/
+
+template <typename Fcn>
+double timeIt(Fcn fcn)
+{
+    auto start{ std::chrono::steady_clock::now() };
+    fcn();
+    auto end{ std::chrono::steady_clock::now() };
+
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+// pushes depth elements (1 ... 16) onto a new stack and pops them again, rounds times, returns a sum so nothing is optimized away
+template <typename Stack>
+long long smallStacks(int rounds)
+{
+    long long sum{ 0 };
+    for(int round{ 0 }; round < rounds; ++round)
+    {
+        Stack stack{};
+        int depth{ round % 16 + 1 };
+        for(int i{ 0 }; i < depth; ++i)
+            stack.push_back(i + round);
+
+        while(!stack.empty())
+        {
+            sum += stack.back();
+            stack.pop_back();
+        }
+    }
+
+    return sum;
+}
+
+template <typename Stack>
+void growTo(const char* name, int count)
+{
+    Stack stack{};
+    double ms{ timeIt([&]{
+        for(int i{ 0 }; i < count; ++i)
+            stack.push_back(i);
+    }) };
+
+    std::cout << name << ": " << ms << " ms, " << stack.stats().reallocations << " reallocations, "
+              << stack.stats().bytesMoved / (1024 * 1024) << " MB moved, capacity " << stack.capacity()
+              << " for " << stack.size() << " elements\n";
+}
+
+int main()
+{
+    constexpr int rounds{ 10'000'000 };
+
+    long long vectorSum{ 0 };
+    long long smallSum{ 0 };
+    double vectorMs{ timeIt([&]{ vectorSum = smallStacks<std::vector<int>>(rounds); }) };
+    double smallMs{ timeIt([&]{ smallSum = smallStacks<small_vector<int, 16>>(rounds); }) };
+
+    std::cout << rounds << " small stacks\n";
+    std::cout << "std::vector<int>:        " << vectorMs << " ms\n";
+    std::cout << "small_vector<int, 16>:   " << smallMs << " ms"
+              << (vectorSum == smallSum ? "" : " (DIFFERENT RESULT)") << '\n';
+
+    std::vector<int> vector{};
+    double vectorGrowMs{ timeIt([&]{
+        for(int i{ 0 }; i < 10'000'000; ++i)
+            vector.push_back(i);
+    }) };
+    std::cout << "\none stack growing to 10 million elements\n";
+    std::cout << "std::vector: " << vectorGrowMs << " ms, capacity " << vector.capacity() << '\n';
+
+    growTo<small_vector<int, 16, GrowDouble>>("GrowDouble", 10'000'000);
+    growTo<small_vector<int, 16, GrowByHalf>>("GrowByHalf", 10'000'000);
+    growTo<small_vector<int, 16, GrowByChunk<1024 * 1024>>>("GrowByChunk<1M>", 10'000'000);
+
+    // a fixed chunk moves everything again every 1024 elements, so the cost grows with the square of the size: only
+    // a million elements here (10 million would move about 200 GB)
+    growTo<small_vector<int, 16, GrowByChunk<1024>>>("GrowByChunk<1024>", 1'000'000);
+
+    return 0;
+}
@@ -0,0 +1,151 @@
+#ifndef BATCH_SEARCH_H
+#define BATCH_SEARCH_H
+
+#include <cstddef> // for std::size_t
+#include <thread> // for std::thread
+#include <vector>
+
+/*
+Batched binary search: looks up many targets in one sorted array.
+
+Calling binarySearch_iterative_version() once per target means every lookup waits for its own chain of dependent loads
+(each midpoint can only be read after the previous one was compared). binarySearchBatch() runs a group of searches in
+lockstep instead: one level of all of them, then the next level of all of them, so the memory loads of different
+targets overlap. Before moving to the next level it prefetches the next midpoint of every search.
+
+Every search takes the same midpoints as binarySearch_iterative_version() and stops counting at the first match, so the
+results are identical to calling it with min = 0 and max = size - 1 (including -1 for "not found").
+*/
+
+namespace batch_search
+{
+    // number of searches run in lockstep
+    constexpr int groupSize{ 16 };
+
+    // below this many targets per thread, binarySearchBatchParallel() doesn't start another thread
+    constexpr std::size_t minTargetsPerThread{ 16'384 };
+
+    inline void prefetch(const int* address)
+    {
+#if defined(__GNUC__)
+        __builtin_prefetch(address);
+#else
+        (void)address;
+#endif
+    }
+
+    // searches for count (at most groupSize) targets at once
+    inline void searchGroup(const int* array, int size, int levels, const int* targets, int* results, int count)
+    {
+        int min[groupSize];
+        int max[groupSize];
+        int found[groupSize];
+
+        for(int lane{ 0 }; lane < count; ++lane)
+        {
+            min[lane] = 0;
+            max[lane] = size - 1;
+            found[lane] = -1;
+        }
+
+        for(int level{ 0 }; level < levels; ++level)
+        {
+            for(int lane{ 0 }; lane < count; ++lane)
+            {
+                int mid{ min[lane] + (max[lane] - min[lane]) / 2 };    // (min + max) / 2 without overflowing
+
+                // an empty range (min > max) means this search is over, read something harmless instead
+                int inRange{ min[lane] <= max[lane] };
+                int key{ array[mid & -inRange] };
+                int target{ targets[lane] };
+
+                int isMatch{ (key == target) & inRange & (found[lane] < 0) };
+                found[lane] += (mid - found[lane]) & -isMatch;
+
+                int goRight{ key < target };
+                min[lane] += (mid + 1 - min[lane]) & -goRight;
+                max[lane] += (mid - 1 - max[lane]) & (goRight - 1);
+            }
+
+            // every lane knows its next midpoint now, start loading all of them before any is needed
+            for(int lane{ 0 }; lane < count; ++lane)
+            {
+                if(min[lane] <= max[lane])
+                    prefetch(array + min[lane] + (max[lane] - min[lane]) / 2);
+            }
+        }
+
+        for(int lane{ 0 }; lane < count; ++lane)
+            results[lane] = found[lane];
+    }
+}
+
+// results[i] is the index of targets[i] in the sorted array, or -1 if it's not there
+// (the same index binarySearch_iterative_version(array, targets[i], 0, size - 1) returns)
+inline void binarySearchBatch(const int* array, int size, const int* targets, int* results, std::size_t count)
+{
+    if(!array || size <= 0)
+    {
+        for(std::size_t i{ 0 }; i < count; ++i)
+            results[i] = -1;
+        return;
+    }
+
+    // number of midpoints a search looks at, at most
+    int levels{ 0 };
+    for(int n{ size }; n > 0; n /= 2)
+        ++levels;
+
+    for(std::size_t first{ 0 }; first < count; first += batch_search::groupSize)
+    {
+        std::size_t remaining{ count - first };
+        int groupCount{ remaining < static_cast<std::size_t>(batch_search::groupSize) ? static_cast<int>(remaining) : batch_search::groupSize };
+
+        batch_search::searchGroup(array, size, levels, targets + first, results + first, groupCount);
+    }
+}
+
+// Same as binarySearchBatch(), but splits very large batches over several threads
+// (threadCount 0 means one thread per hardware thread)
+inline void binarySearchBatchParallel(const int* array, int size, const int* targets, int* results, std::size_t count,
+                                      unsigned threadCount = 0)
+{
+    if(threadCount == 0)
+        threadCount = std::thread::hardware_concurrency();
+    if(threadCount == 0)
+        threadCount = 1;
+
+    std::size_t maxThreads{ count / batch_search::minTargetsPerThread };
+    if(maxThreads < threadCount)
+        threadCount = maxThreads > 0 ? static_cast<unsigned>(maxThreads) : 1;
+
+    if(threadCount == 1)
+    {
+        binarySearchBatch(array, size, targets, results, count);
+        return;
+    }
+
+    // every thread gets its own contiguous slice of targets and results, so they never share a cache line of results
+    // (except at the slice edges)
+    std::vector<std::thread> workers;
+    workers.reserve(threadCount - 1);
+
+    std::size_t sliceSize{ (count + threadCount - 1) / threadCount };
+    for(unsigned thread{ 1 }; thread < threadCount; ++thread)
+    {
+        std::size_t first{ thread * sliceSize };
+        if(first >= count)
+            break;
+        std::size_t sliceCount{ count - first < sliceSize ? count - first : sliceSize };
+
+        workers.emplace_back(binarySearchBatch, array, size, targets + first, results + first, sliceCount);
+    }
+
+    // the calling thread does the first slice itself
+    binarySearchBatch(array, size, targets, results, count < sliceSize ? count : sliceSize);
+
+    for(std::thread& worker : workers)
+        worker.join();
+}
+
+#endif
@@ -0,0 +1,116 @@
+#include <iostream>
+#include <vector>
+#include <random> // for std::mt19937
+#include <chrono> // for std::chrono::steady_clock
+#include <algorithm> // for std::sort
+#include <string> // for std::stoi
+#include "eytzinger_index.h" // for EytzingerIndex
+#include "batch_search.h" // for binarySearchBatch, binarySearchBatchParallel
+
+/*
+Compares binarySearch_iterative_version() with EytzingerIndex::find() and the batched searches from batch_search.h
+for sorted arrays from 1K up to 1G elements. Build with optimisations, e.g.:
+
+    g++ -std=c++17 -O2 -pthread eytzinger_benchmark.cpp -o eytzinger_benchmark
+
+The largest array is 2^22 (4M) elements unless a larger power of two is passed on the command line
+(./eytzinger_benchmark 30 goes up to 1G elements, which needs about 16 GB of memory).
+*/
+
+// the iterative binary search from main.cpp, kept here as the baseline
+int binarySearch_iterative_version(const int* array, int target, int min, int max)
+{
+    while (min <= max)
+    {
+        int center_element{ static_cast<int>((static_cast<long long>(min) + max) / 2) };
+
+        if(array[center_element] > target)
+            max = center_element - 1;
+        else if(array[center_element] < target)
+            min = center_element + 1;
+        else
+            return center_element;
+    }
+
+    return -1;
+}
+
+int main(int argc, char* argv[])
+{
+    int maxPower{ 22 };
+    if(argc > 1)
+        maxPower = std::stoi(argv[1]);
+    if(maxPower > 30)
+        maxPower = 30;// the searches use int indices
+
+    constexpr int numLookups{ 1'000'000 };
+    std::mt19937 mt{ 12345u };
+
+    for(int power{ 10 }; power <= maxPower; power += 2)
+    {
+        int size{ 1 << power };
+
+        // sorted data with duplicates, about half of the lookups will miss
+        std::vector<int> array(static_cast<std::size_t>(size));
+        std::uniform_int_distribution<int> valueDie{ 0, size };
+        for(int& value : array)
+            value = valueDie(mt);
+        std::sort(array.begin(), array.end());
+
+        std::vector<int> targets(numLookups);
+        for(int& target : targets)
+            target = valueDie(mt);
+
+        auto buildStart{ std::chrono::steady_clock::now() };
+        EytzingerIndex index{ array.data(), size };
+        auto buildEnd{ std::chrono::steady_clock::now() };
+
+        // binary search
+        long long checksumBinary{ 0 };
+        auto binaryStart{ std::chrono::steady_clock::now() };
+        for(int target : targets)
+            checksumBinary += binarySearch_iterative_version(array.data(), target, 0, size - 1);
+        auto binaryEnd{ std::chrono::steady_clock::now() };
+
+        // Eytzinger index
+        long long checksumEytzinger{ 0 };
+        auto eytzingerStart{ std::chrono::steady_clock::now() };
+        for(int target : targets)
+            checksumEytzinger += index.find(target);
+        auto eytzingerEnd{ std::chrono::steady_clock::now() };
+
+        // batched, one thread and all threads
+        std::vector<int> batchResults(numLookups);
+        auto batchStart{ std::chrono::steady_clock::now() };
+        binarySearchBatch(array.data(), size, targets.data(), batchResults.data(), targets.size());
+        auto batchEnd{ std::chrono::steady_clock::now() };
+
+        long long checksumBatch{ 0 };
+        for(int result : batchResults)
+            checksumBatch += result;
+
+        auto parallelStart{ std::chrono::steady_clock::now() };
+        binarySearchBatchParallel(array.data(), size, targets.data(), batchResults.data(), targets.size());
+        auto parallelEnd{ std::chrono::steady_clock::now() };
+
+        long long checksumParallel{ 0 };
+        for(int result : batchResults)
+            checksumParallel += result;
+
+        double binaryNs{ std::chrono::duration<double, std::nano>(binaryEnd - binaryStart).count() / numLookups };
+        double eytzingerNs{ std::chrono::duration<double, std::nano>(eytzingerEnd - eytzingerStart).count() / numLookups };
+        double batchNs{ std::chrono::duration<double, std::nano>(batchEnd - batchStart).count() / numLookups };
+        double parallelNs{ std::chrono::duration<double, std::nano>(parallelEnd - parallelStart).count() / numLookups };
+        double buildMs{ std::chrono::duration<double, std::milli>(buildEnd - buildStart).count() };
+
+        std::cout << "2^" << power << " elements: binarySearch " << binaryNs << " ns/lookup, EytzingerIndex "
+                  << eytzingerNs << " ns/lookup (build " << buildMs << " ms, " << index.bytes() / (1024 * 1024) << " MB), "
+                  << "binarySearchBatch " << batchNs << " ns/lookup, binarySearchBatchParallel " << parallelNs << " ns/lookup";
+
+        if(checksumBinary != checksumEytzinger || checksumBinary != checksumBatch || checksumBinary != checksumParallel)
+            std::cout << "  RESULTS DIFFER!";
+        std::cout << '\n';
+    }
+
+    return 0;
+}
@@ -0,0 +1,139 @@
+#ifndef EYTZINGER_INDEX_H
+#define EYTZINGER_INDEX_H
+
+#include <cstddef> // for std::size_t
+#include <cstdint> // for std::uintptr_t
+#include <cstdlib> // for std::aligned_alloc, std::free
+#include <new> // for std::bad_alloc
+
+/*
+Read-only search index built once from a sorted array.
+
+binarySearch_iterative_version() looks at the elements in the order of a binary tree: first the midpoint of the whole
+array, then the midpoint of one half, and so on. EytzingerIndex stores the elements in exactly that order, level by level
+(node k has its children at 2k and 2k+1, node 1 is the root). The top of the tree is then packed into a few cache lines,
+and the 16 descendants four levels below node k sit next to each other at 16k, so they can be prefetched ahead of time.
+
+find() walks a fixed number of levels without an early exit, picking the next child with arithmetic instead of a branch,
+and remembers the first node that matched (the original index of a node is recomputed from the min/max range on the
+way down, so no second array is touched). Because the tree is built with the same midpoints as
+binarySearch_iterative_version(), it returns exactly the same index (even when the array has duplicates), or -1.
+*/
+class EytzingerIndex
+{
+public:
+    EytzingerIndex(const int* array, int size)
+        : m_size{ size }
+    {
+        // number of levels of the midpoint tree
+        for(int n{ size }; n > 0; n /= 2)
+            ++m_levels;
+
+        // one unused slot at 0, then 2^levels - 1 nodes
+        m_slots = std::size_t{ 1 } << m_levels;
+
+        m_keys = allocate(m_slots);
+
+        // slots the midpoint tree doesn't reach are never matched (find() knows their range is empty)
+        for(std::size_t k{ 0 }; k < m_slots; ++k)
+            m_keys[k] = 0;
+
+        if(array && size > 0)
+            build(array, 0, size - 1, 1);
+    }
+
+    ~EytzingerIndex()
+    {
+        std::free(m_keys);
+    }
+
+    EytzingerIndex(const EytzingerIndex&) = delete;
+    EytzingerIndex& operator=(const EytzingerIndex&) = delete;
+
+    // returns the index (in the original sorted array) of target, -1 otherwise
+    int find(int target) const
+    {
+        std::size_t k{ 1 };
+        int found{ -1 };
+
+        // the range binarySearch_iterative_version() would be looking at, so the index of node k is (min+max)/2
+        int min{ 0 };
+        int max{ m_size - 1 };
+
+        for(int level{ 0 }; level < m_levels; ++level)
+        {
+            prefetch(k);
+
+            int key{ m_keys[k] };
+            int mid{ min + (max - min) / 2 };    // (min + max) / 2, without overflowing for big arrays
+
+            // remember the first node on the path that matches (that's where the binary search would have stopped),
+            // min > max marks the slots the midpoint tree doesn't reach
+            int isMatch{ (key == target) & (min <= max) & (found < 0) };
+            found += (mid - found) & -isMatch;
+
+            // go right if the node is smaller than the target, left otherwise
+            // (masks instead of ?: because the compiler likes to turn those back into a branch)
+            int goRight{ key < target };
+            min += (mid + 1 - min) & -goRight;
+            max += (mid - 1 - max) & (goRight - 1);
+            k = 2*k + static_cast<std::size_t>(goRight);
+        }
+
+        return found;
+    }
+
+    int size() const { return m_size; }
+    int levels() const { return m_levels; }
+
+    // memory used by the index
+    std::size_t bytes() const { return m_slots * sizeof(int); }
+
+private:
+    static int* allocate(std::size_t count)
+    {
+        // cache line aligned, so the 16 nodes at 16k..16k+15 are one cache line
+        std::size_t bytes{ count * sizeof(int) };
+        bytes = (bytes + 63) / 64 * 64;
+
+        void* memory{ std::aligned_alloc(64, bytes) };
+        if(!memory)
+            throw std::bad_alloc{};
+
+        return static_cast<int*>(memory);
+    }
+
+    // same midpoints as binarySearch_iterative_version()
+    void build(const int* array, int min, int max, std::size_t k)
+    {
+        if(min > max)
+            return;
+
+        int mid{ static_cast<int>((static_cast<long long>(min) + max) / 2) };
+
+        m_keys[k] = array[mid];
+
+        build(array, min, mid - 1, 2*k);
+        build(array, mid + 1, max, 2*k + 1);
+    }
+
+    void prefetch(std::size_t k) const
+    {
+#if defined(__GNUC__)
+        // the great-great-grandchildren of k, needed four levels from now
+        // (near the leaves this address is past the end of the tree, a prefetch never faults so that's harmless,
+        // and going through an integer keeps the pointer arithmetic well-defined)
+        std::uintptr_t ahead{ reinterpret_cast<std::uintptr_t>(m_keys) + 16 * k * sizeof(int) };
+        __builtin_prefetch(reinterpret_cast<const void*>(ahead));
+#else
+        (void)k;
+#endif
+    }
+
+    int m_size{};
+    int m_levels{ 0 };
+    std::size_t m_slots{};
+    int* m_keys{ nullptr };
+};
+
+#endif
@@ -2,6 +2,8 @@
 #include <algorithm> // for std::swap,
 #include <iterator> 
 #include <cmath> // for std::floor
+#include "eytzinger_index.h" // for EytzingerIndex
+#include "batch_search.h" // for binarySearchBatch
 
 //function prototypes:
 double max(double a, double x);
@@ -275,6 +277,32 @@ int main()
     //b) Write a recursive version of the binarySearch function.
 
 
+    // The same test values against the cache-friendly EytzingerIndex (see eytzinger_index.h),
+    // it is built once from the sorted array and must give the same answers as binarySearch()
+    EytzingerIndex index{ array, static_cast<int>(std::size(array)) };
+
+    for (int count{ 0 }; count < numTestValues; ++count)
+    {
+        int found{ index.find(testValues[count]) };
+
+        if (found == expectedValues[count]
+            && found == binarySearch_iterative_version(array, testValues[count], 0, static_cast<int>(std::size(array)) - 1))
+             std::cout << "EytzingerIndex: test value " << testValues[count] << " passed!\n";
+        else
+             std::cout << "EytzingerIndex: test value " << testValues[count] << " failed.  There's something wrong with your code!\n";
+    }
+
+    // And once more, all test values in a single batched call (see batch_search.h)
+    int batchResults[numTestValues]{};
+    binarySearchBatch(array, static_cast<int>(std::size(array)), testValues, batchResults, numTestValues);
+
+    for (int count{ 0 }; count < numTestValues; ++count)
+    {
+        if (batchResults[count] == expectedValues[count])
+             std::cout << "binarySearchBatch: test value " << testValues[count] << " passed!\n";
+        else
+             std::cout << "binarySearchBatch: test value " << testValues[count] << " failed.  There's something wrong with your code!\n";
+    }
 
 
     return 0;
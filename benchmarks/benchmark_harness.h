@@ -0,0 +1,537 @@
+#ifndef BENCHMARK_HARNESS_H
+#define BENCHMARK_HARNESS_H
+
+#include <algorithm> // for std::min_element, std::max, std::min
+#include <chrono> // for std::chrono::steady_clock
+#include <cstdint> // for std::uint64_t
+#include <cstdio> // for std::printf
+#include <cstdlib> // for std::strtod
+#include <cstring> // for std::strerror
+#include <fstream> // for std::ifstream, std::ofstream
+#include <iterator> // for std::istreambuf_iterator
+#include <map>
+#include <string>
+#include <utility> // for std::pair
+#include <vector>
+
+#if defined(__linux__)
+#include <cerrno> // for errno
+#include <linux/perf_event.h> // for perf_event_attr
+#include <sys/ioctl.h> // for ioctl
+#include <sys/syscall.h> // for SYS_perf_event_open
+#include <unistd.h> // for syscall, read, close
+#define BENCHMARK_HARNESS_HAS_PERF 1
+#endif
+
+/*
+A small benchmark harness: timing, hardware counters, and a JSON baseline to catch regressions.
+
+suite.run(name, size, unit, opsPerIteration, fcn) measures fcn, where one call of fcn is opsPerIteration ops (an op is
+whatever unit says: an element sorted, a lookup, a call). fcn is called once to warm up and to see how long it takes,
+then it's called in rounds (5, or 3 with --quick) of as many calls as fit into about 40 ms (2 ms with --quick). The
+result is the fastest round (the one least disturbed by whatever else the machine was doing), as:
+  - ns/op and ops per second,
+  - cycles, instructions, branch misses and cache misses per op, counted by the CPU for all rounds together. They come
+    from perf_event_open() on Linux, and show as "-" where that's not there or not allowed (in most containers, or
+    with /proc/sys/kernel/perf_event_paranoid above 2).
+
+suite.check(name, ok) records a wrong result; the suite then fails however fast it was.
+
+suite.finish() compares the results with the baseline file (ns/op for the same name and size). A result more than
+threshold percent slower than the baseline is a regression, and finish() returns 1 if there was one. When there's no
+baseline file yet, or with --update-baseline, the results are written to it as the new baseline. A quick run is only
+compared with a quick baseline, and a full run with a full one.
+
+Options (parseOptions()):
+    --quick                 smaller sizes and shorter rounds (a smoke test, e.g. for ctest)
+    --filter TEXT           only the benchmarks with TEXT in their name
+    --baseline FILE         the baseline to compare with (chapter11_baseline.json)
+    --no-baseline           don't compare with or write a baseline
+    --update-baseline       write the results as the new baseline
+    --threshold PERCENT     how much slower counts as a regression (10)
+    --json FILE             also write the results to FILE
+*/
+
+namespace benchmark_harness
+{
+    // keeps the compiler from throwing away a result (or working it out while compiling)
+    template <typename T>
+    inline void doNotOptimize(const T& value)
+    {
+#if defined(__GNUC__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static const volatile void* sink{ nullptr };
+        sink = &value;
+#endif
+    }
+
+    struct Options
+    {
+        bool quick{ false };
+        std::string filter{};
+        std::string baselineFile{ "chapter11_baseline.json" };
+        bool useBaseline{ true };
+        bool updateBaseline{ false };
+        double thresholdPercent{ 10.0 };
+        std::string jsonFile{};
+    };
+
+    // false (and error filled in) for an option it doesn't know
+    inline bool parseOptions(int argc, char* argv[], Options& options, std::string& error)
+    {
+        for(int i{ 1 }; i < argc; ++i)
+        {
+            std::string option{ argv[i] };
+            bool hasValue{ i + 1 < argc };
+
+            if(option == "--quick")
+                options.quick = true;
+            else if(option == "--no-baseline")
+                options.useBaseline = false;
+            else if(option == "--update-baseline")
+                options.updateBaseline = true;
+            else if(option == "--filter" && hasValue)
+                options.filter = argv[++i];
+            else if(option == "--baseline" && hasValue)
+                options.baselineFile = argv[++i];
+            else if(option == "--json" && hasValue)
+                options.jsonFile = argv[++i];
+            else if(option == "--threshold" && hasValue)
+            {
+                char* end{ nullptr };
+                options.thresholdPercent = std::strtod(argv[++i], &end);
+                if(*end != '\0' || options.thresholdPercent < 0)
+                {
+                    error = std::string{ "--threshold needs a percentage, not " } + argv[i];
+                    return false;
+                }
+            }
+            else
+            {
+                error = "unknown option " + option + (hasValue ? "" : " (or a missing value)");
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    // per op, valid is false when the counters couldn't be read
+    struct CounterValues
+    {
+        bool valid{ false };
+        double cycles{ 0 };
+        double instructions{ 0 };
+        double branchMisses{ 0 };
+        double cacheMisses{ 0 };
+    };
+
+    class HardwareCounters
+    {
+    public:
+        HardwareCounters()
+        {
+#if defined(BENCHMARK_HARNESS_HAS_PERF)
+            m_leader = openCounter(PERF_COUNT_HW_CPU_CYCLES, -1);
+            if(m_leader < 0)
+            {
+                m_problem = std::string{ "perf_event_open: " } + std::strerror(errno);
+                return;
+            }
+            m_kinds.push_back(PERF_COUNT_HW_CPU_CYCLES);
+
+            // the others only if the CPU (or the virtual machine) has them
+            for(std::uint64_t kind : { PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_BRANCH_MISSES, PERF_COUNT_HW_CACHE_MISSES })
+            {
+                int fd{ openCounter(kind, m_leader) };
+                if(fd >= 0)
+                {
+                    m_members.push_back(fd);
+                    m_kinds.push_back(kind);
+                }
+            }
+#else
+            m_problem = "no perf_event_open on this system";
+#endif
+        }
+
+        ~HardwareCounters()
+        {
+#if defined(BENCHMARK_HARNESS_HAS_PERF)
+            for(int fd : m_members)
+                ::close(fd);
+            if(m_leader >= 0)
+                ::close(m_leader);
+#endif
+        }
+
+        HardwareCounters(const HardwareCounters&) = delete;
+        HardwareCounters& operator=(const HardwareCounters&) = delete;
+
+        bool available() const { return m_leader >= 0; }
+        const std::string& problem() const { return m_problem; }
+
+        void start()
+        {
+#if defined(BENCHMARK_HARNESS_HAS_PERF)
+            if(!available())
+                return;
+
+            ::ioctl(m_leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+            ::ioctl(m_leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+        }
+
+        // the counts since start(), divided by ops
+        CounterValues stop(double ops)
+        {
+            CounterValues values{};
+#if defined(BENCHMARK_HARNESS_HAS_PERF)
+            if(!available())
+                return values;
+
+            ::ioctl(m_leader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+            // number of counters, time enabled, time running, then the counters in the order they were opened
+            std::uint64_t data[3 + maxCounters]{};
+            if(::read(m_leader, data, sizeof(data)) < static_cast<ssize_t>(3 * sizeof(std::uint64_t)) || data[2] == 0)
+                return values;
+
+            // when the kernel had to share the counters with others, it counted only part of the time
+            double scale{ static_cast<double>(data[1]) / static_cast<double>(data[2]) / ops };
+            for(std::size_t i{ 0 }; i < data[0] && i < m_kinds.size(); ++i)
+            {
+                double value{ static_cast<double>(data[3 + i]) * scale };
+                switch(m_kinds[i])
+                {
+                case PERF_COUNT_HW_CPU_CYCLES: values.cycles = value; break;
+                case PERF_COUNT_HW_INSTRUCTIONS: values.instructions = value; break;
+                case PERF_COUNT_HW_BRANCH_MISSES: values.branchMisses = value; break;
+                case PERF_COUNT_HW_CACHE_MISSES: values.cacheMisses = value; break;
+                default: break;
+                }
+            }
+            values.valid = true;
+#else
+            static_cast<void>(ops);
+#endif
+            return values;
+        }
+
+    private:
+#if defined(BENCHMARK_HARNESS_HAS_PERF)
+        static constexpr std::size_t maxCounters{ 4 };
+
+        static int openCounter(std::uint64_t kind, int leader)
+        {
+            perf_event_attr attributes{};
+            attributes.type = PERF_TYPE_HARDWARE;
+            attributes.size = sizeof(attributes);
+            attributes.config = kind;
+            attributes.disabled = leader < 0 ? 1 : 0; // the group starts and stops with its leader
+            attributes.exclude_kernel = 1;
+            attributes.exclude_hv = 1;
+            attributes.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+            return static_cast<int>(::syscall(SYS_perf_event_open, &attributes, 0, -1, leader, 0));
+        }
+#endif
+
+        int m_leader{ -1 };
+        std::vector<int> m_members{};
+        std::vector<std::uint64_t> m_kinds{};
+        std::string m_problem{};
+    };
+
+    struct Result
+    {
+        std::string name{};
+        std::size_t size{ 0 };
+        std::string unit{};
+        double nsPerOp{ 0 };
+        double opsPerSecond{ 0 };
+        CounterValues counters{};
+    };
+
+    // the parts of a results file that the comparison needs
+    struct Baseline
+    {
+        bool quick{ false };
+        std::map<std::pair<std::string, std::size_t>, double> nsPerOp{};
+    };
+
+    inline std::string escape(const std::string& text)
+    {
+        std::string result{};
+        for(char c : text)
+        {
+            if(c == '"' || c == '\\')
+                result += '\\';
+            result += c;
+        }
+
+        return result;
+    }
+
+    inline bool writeResults(const std::string& fileName, const std::vector<Result>& results, bool quick)
+    {
+        std::ofstream file{ fileName };
+        if(!file)
+            return false;
+
+        file << "{\n  \"quick\": " << (quick ? "true" : "false") << ",\n  \"results\": [\n";
+        file.precision(6);
+        for(std::size_t i{ 0 }; i < results.size(); ++i)
+        {
+            const Result& result{ results[i] };
+            file << "    { \"name\": \"" << escape(result.name) << "\", \"size\": " << result.size << ", \"unit\": \""
+                 << escape(result.unit) << "\", \"ns_per_op\": " << result.nsPerOp << ", \"ops_per_second\": "
+                 << result.opsPerSecond;
+
+            const CounterValues& counters{ result.counters };
+            if(counters.valid)
+                file << ", \"cycles_per_op\": " << counters.cycles << ", \"instructions_per_op\": " << counters.instructions
+                     << ", \"branch_misses_per_op\": " << counters.branchMisses << ", \"cache_misses_per_op\": "
+                     << counters.cacheMisses;
+
+            file << " }" << (i + 1 < results.size() ? "," : "") << '\n';
+        }
+        file << "  ]\n}\n";
+
+        return static_cast<bool>(file);
+    }
+
+    // where the value of "key" starts in text (from position on, up to end), std::string::npos if it's not there
+    inline std::size_t findValue(const std::string& text, const char* key, std::size_t position, std::size_t end)
+    {
+        std::string quoted{ std::string{ "\"" } + key + "\"" };
+        std::size_t found{ text.find(quoted, position) };
+        if(found == std::string::npos || found >= end)
+            return std::string::npos;
+
+        found = text.find(':', found + quoted.size());
+        if(found == std::string::npos || found >= end)
+            return std::string::npos;
+
+        return text.find_first_not_of(" \t\r\n", found + 1);
+    }
+
+    // reads what writeResults() wrote (and whatever someone edited into it, as long as it has the same fields)
+    inline bool readBaseline(const std::string& fileName, Baseline& baseline)
+    {
+        std::ifstream file{ fileName };
+        if(!file)
+            return false;
+
+        const std::string text{ std::istreambuf_iterator<char>{ file }, std::istreambuf_iterator<char>{} };
+
+        std::size_t quick{ findValue(text, "quick", 0, text.size()) };
+        baseline.quick = quick != std::string::npos && text.compare(quick, 4, "true") == 0;
+
+        std::size_t position{ findValue(text, "results", 0, text.size()) };
+        if(position == std::string::npos)
+            return false;
+
+        // one flat object per result
+        while((position = text.find('{', position)) != std::string::npos)
+        {
+            std::size_t end{ text.find('}', position) };
+            if(end == std::string::npos)
+                return false;
+
+            std::size_t name{ findValue(text, "name", position, end) };
+            std::size_t size{ findValue(text, "size", position, end) };
+            std::size_t nsPerOp{ findValue(text, "ns_per_op", position, end) };
+            if(name == std::string::npos || text[name] != '"' || size == std::string::npos || nsPerOp == std::string::npos)
+                return false;
+
+            std::string nameText{};
+            for(std::size_t i{ name + 1 }; i < end && text[i] != '"'; ++i)
+            {
+                if(text[i] == '\\' && i + 1 < end)
+                    ++i;
+                nameText += text[i];
+            }
+
+            const std::size_t sizeValue{ static_cast<std::size_t>(std::strtod(text.c_str() + size, nullptr)) };
+            baseline.nsPerOp[{ nameText, sizeValue }] = std::strtod(text.c_str() + nsPerOp, nullptr);
+
+            position = end + 1;
+        }
+
+        return true;
+    }
+
+    class Suite
+    {
+    public:
+        explicit Suite(const Options& options)
+            : m_options{ options }
+        {
+            std::printf("%-74s %10s %10s %12s %9s %9s %9s %9s\n", "benchmark", "size", "ns/op", "Mops/s", "cycles",
+                        "instr", "br-miss", "$-miss");
+            if(!m_counters.available())
+                std::printf("(no hardware counters: %s)\n", m_counters.problem().c_str());
+        }
+
+        bool quick() const { return m_options.quick; }
+
+        // picks the full or the quick sizes
+        std::vector<std::size_t> sizes(std::vector<std::size_t> full, std::vector<std::size_t> quickSizes) const
+        {
+            return m_options.quick ? quickSizes : full;
+        }
+
+        bool wanted(const std::string& name) const
+        {
+            return m_options.filter.empty() || name.find(m_options.filter) != std::string::npos;
+        }
+
+        // one call of fcn does opsPerIteration ops
+        template <typename Fcn>
+        void run(const std::string& name, std::size_t size, const char* unit, double opsPerIteration, Fcn&& fcn)
+        {
+            if(!wanted(name))
+                return;
+
+            using Clock = std::chrono::steady_clock;
+            const double roundNs{ m_options.quick ? 2e6 : 40e6 };
+            const int rounds{ m_options.quick ? 3 : 5 };
+
+            auto warmupStart{ Clock::now() };
+            fcn();
+            double warmupNs{ std::chrono::duration<double, std::nano>(Clock::now() - warmupStart).count() };
+
+            const double iterations{ std::max(1.0, std::min(1e9, roundNs / std::max(warmupNs, 1.0))) };
+            const long long calls{ static_cast<long long>(iterations) };
+
+            std::vector<double> roundTimes{};
+            m_counters.start();
+            for(int round{ 0 }; round < rounds; ++round)
+            {
+                auto start{ Clock::now() };
+                for(long long call{ 0 }; call < calls; ++call)
+                    fcn();
+                roundTimes.push_back(std::chrono::duration<double, std::nano>(Clock::now() - start).count());
+            }
+            const double totalOps{ static_cast<double>(calls) * opsPerIteration };
+            CounterValues counters{ m_counters.stop(totalOps * rounds) };
+
+            Result result{};
+            result.name = name;
+            result.size = size;
+            result.unit = unit;
+            result.nsPerOp = *std::min_element(roundTimes.begin(), roundTimes.end()) / totalOps;
+            result.opsPerSecond = 1e9 / result.nsPerOp;
+            result.counters = counters;
+
+            print(result);
+            m_results.push_back(result);
+        }
+
+        // a benchmark whose result was wrong
+        void check(const std::string& name, bool ok)
+        {
+            if(ok || !wanted(name))
+                return;
+
+            std::printf("%s: WRONG RESULT\n", name.c_str());
+            m_failures.push_back(name);
+        }
+
+        const std::vector<Result>& results() const { return m_results; }
+
+        // 0 if all went well, 1 for a wrong result or a regression, 2 if a file couldn't be written
+        int finish() const
+        {
+            int status{ m_failures.empty() ? 0 : 1 };
+            if(!m_failures.empty())
+                std::printf("\n%zu benchmark(s) gave wrong results\n", m_failures.size());
+
+            if(!m_options.jsonFile.empty() && !writeResults(m_options.jsonFile, m_results, m_options.quick))
+            {
+                std::printf("can't write %s\n", m_options.jsonFile.c_str());
+                status = 2;
+            }
+
+            if(!m_options.useBaseline)
+                return status;
+
+            Baseline baseline{};
+            bool haveBaseline{ readBaseline(m_options.baselineFile, baseline) };
+            if(haveBaseline && baseline.quick != m_options.quick)
+                std::printf("\n%s is from a %s run, not comparing\n", m_options.baselineFile.c_str(),
+                            baseline.quick ? "quick" : "full");
+            else if(haveBaseline && compare(baseline) > 0)
+                status = std::max(status, 1);
+
+            if(!haveBaseline || m_options.updateBaseline)
+            {
+                if(!writeResults(m_options.baselineFile, m_results, m_options.quick))
+                {
+                    std::printf("can't write %s\n", m_options.baselineFile.c_str());
+                    return 2;
+                }
+                std::printf("\nbaseline written to %s\n", m_options.baselineFile.c_str());
+            }
+
+            return status;
+        }
+
+    private:
+        static void print(const Result& result)
+        {
+            std::printf("%-74s %10zu %10.3f %12.2f", result.name.c_str(), result.size, result.nsPerOp,
+                        result.opsPerSecond / 1e6);
+
+            const CounterValues& counters{ result.counters };
+            if(counters.valid)
+                std::printf(" %9.2f %9.2f %9.4f %9.4f", counters.cycles, counters.instructions, counters.branchMisses,
+                            counters.cacheMisses);
+            else
+                std::printf(" %9s %9s %9s %9s", "-", "-", "-", "-");
+
+            std::printf("  per %s\n", result.unit.c_str());
+            std::fflush(stdout);
+        }
+
+        // prints what changed by more than the threshold, returns the number of regressions
+        int compare(const Baseline& baseline) const
+        {
+            std::printf("\ncompared with %s (threshold %.1f%%):\n", m_options.baselineFile.c_str(),
+                        m_options.thresholdPercent);
+
+            int regressions{ 0 };
+            int compared{ 0 };
+            for(const Result& result : m_results)
+            {
+                auto found{ baseline.nsPerOp.find({ result.name, result.size }) };
+                if(found == baseline.nsPerOp.end() || found->second <= 0)
+                    continue;
+
+                ++compared;
+                double change{ (result.nsPerOp / found->second - 1.0) * 100.0 };
+                if(change > m_options.thresholdPercent)
+                {
+                    ++regressions;
+                    std::printf("  REGRESSION  %-74s %10zu %+8.1f%% (%.3f -> %.3f ns/op)\n", result.name.c_str(),
+                                result.size, change, found->second, result.nsPerOp);
+                }
+                else if(change < -m_options.thresholdPercent)
+                    std::printf("  faster      %-74s %10zu %+8.1f%% (%.3f -> %.3f ns/op)\n", result.name.c_str(),
+                                result.size, change, found->second, result.nsPerOp);
+            }
+
+            std::printf("%d of %d compared benchmarks regressed\n", regressions, compared);
+            return regressions;
+        }
+
+        Options m_options{};
+        HardwareCounters m_counters{};
+        std::vector<Result> m_results{};
+        std::vector<std::string> m_failures{};
+    };
+}
+
+#endif
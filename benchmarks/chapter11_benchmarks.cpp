@@ -0,0 +1,785 @@
+#include <algorithm> // for std::sort, std::max_element
+#include <cmath> // for std::sin, std::cos, std::floor
+#include <cstdarg> // for va_list
+#include <cstddef> // for std::size_t
+#include <cstdio> // for std::printf
+#include <random> // for std::mt19937
+#include <string>
+#include <vector>
+#include "benchmark_harness.h" // for benchmark_harness::Suite
+#include "../11.3 — Passing arguments by reference (vsCode)/sincos_batch.h" // for getSinCos (batch)
+#include "../11.5 — Returning values by value, reference, and address (vsCode)/argmax.h" // for argmax
+#include "../11.7 — Function Pointers (vsCode)/introsort.h" // for introSort
+#include "../11.7 — Function Pointers (vsCode)/expression_engine.h" // for Expression
+#include "print_stack.h" // for printStack, StackWriter (from 11.9, see CMakeLists.txt)
+#include "../11.10 — Recursion (vsCode)/memoize.h" // for memoize
+#include "../11.10 — Recursion (vsCode)/fibonacci.h" // for Fibonacci_fast_doubling, fibonacciTable
+#include "../11.12 — Ellipsis (and why to avoid them) (vsCode)/find_average.h" // for typesafe::findAverage
+#include "../11.13 — Introduction to lambdas (anonymous functions) (vsCode)/function_ref.h" // for function_ref
+#include "../11.13 — Introduction to lambdas (anonymous functions) (vsCode)/record_file.h" // for RecordWriter, RecordFile
+#include "../11.x — Chapter 11 comprehensive quiz (vsCode)/eytzinger_index.h" // for EytzingerIndex
+#include "../11.x — Chapter 11 comprehensive quiz (vsCode)/batch_search.h" // for binarySearchBatch
+
+/*
+The benchmark suite for the functions of chapter 11 that the rest of the code leans on, built with optimization (unlike
+the "g++ build active file" task, which builds with -g only):
+
+    cmake -S . -B build && cmake --build build
+    ./build/chapter11_benchmarks                      compares with chapter11_baseline.json, or writes it the first time
+    ./build/chapter11_benchmarks --update-baseline    after a change that is meant to be slower (or faster)
+
+or cmake --build build --target run_benchmarks (and update_benchmark_baseline), see CMakeLists.txt. The options are
+listed in benchmark_harness.h.
+
+The functions from the lessons' main.cpp files are copied into namespace lesson below (main.cpp has its own main(), so
+it can't be linked in); the headers next to them are included as they are. Every benchmark runs for several sizes and
+checks its result once, so a change that makes something fast by making it wrong fails too.
+*/
+
+namespace lesson
+{
+    // 11.7 — Function Pointers
+    bool ascending_for_Ptr(int x, int y)
+    {
+        return x > y;
+    }
+
+    bool evensFirst(int x, int y)
+    {
+        if((x%2==0) && !(y%2==0))
+            return false;
+
+        if(!(x%2==0) && (y%2==0))
+            return true;
+
+        return ascending_for_Ptr(x, y);
+    }
+
+    void SelectionSort_plus_our_function_pointer_parameter(int *array, int size, bool (*comparisonFcn)(int, int))
+    {
+        introSort(array, size, comparisonFcn);
+    }
+
+    int add(int x, int y)
+    {
+        return x + y;
+    }
+
+    int subtract(int x, int y)
+    {
+        return x - y;
+    }
+
+    int multiply(int x, int y)
+    {
+        return x * y;
+    }
+
+    int division(int x, int y)
+    {
+        return x / y;
+    }
+
+    typedef int (*fcn_ptr)(int,int);
+
+    fcn_ptr getArithmeticFunction(char c)
+    {
+        switch (c)
+        {
+        case '+':
+            return &add;
+        case '-':
+            return &subtract;
+        case '*':
+            return &multiply;
+        case '/':
+            return &division;
+        }
+        return nullptr;
+    }
+
+    // 11.x — Chapter 11 comprehensive quiz
+    int midPoint(int x, int y)
+    {
+        int center_element{static_cast<int>(std::floor( (x+y) / 2 )) };
+
+        return center_element;
+    }
+
+    int binarySearch_iterative_version(const int* array, int target, int min, int max)
+    {
+        while (min <= max)
+        {
+            int center_element{ midPoint(min, max) };
+
+            if(array[center_element] > target)
+                max = center_element - 1;
+            else if(array[center_element] < target)
+                min = center_element + 1;
+            else
+                return center_element;
+        }
+
+        return -1;
+    }
+
+    int binarySearch_recursive_version(const int* array, int target, int min, int max)
+    {
+        int mid{ static_cast<int>(std::floor( (min+max) / 2 )) };
+
+        if(min > max)
+            return -1;
+        else if(array[mid] == target)
+            return mid;
+        else if(array[mid] < target)
+            return binarySearch_recursive_version(array, target, mid+1, max);
+        else
+            return binarySearch_recursive_version(array, target, min, mid-1);
+    }
+
+    // 11.10 — Recursion
+    std::size_t Fibonacci(std::size_t x)
+    {
+        if(x == 0)
+            return 0;
+        else if(x == 1)
+            return 1;
+        else
+            return (Fibonacci(x-1) + Fibonacci(x-2));
+    }
+
+    std::size_t Fibonacci_memoized_version(std::size_t x)
+    {
+        static const auto fibonacci{ memoize<std::size_t, std::size_t>([](const auto& self, std::size_t n) -> std::size_t
+        {
+            if(n < 2)
+                return n;
+            else
+                return self(n - 1) + self(n - 2);
+        }, 4096) };
+
+        return fibonacci(x);
+    }
+
+    // 11.12 — Ellipsis (and why to avoid them)
+    double findAverage(int count, ...)
+    {
+        double sum{ 0 };
+
+        va_list list;
+        va_start(list, count);
+        for(int arg{ 0 }; arg < count; ++arg)
+            sum += va_arg(list, int);
+        va_end(list);
+
+        return sum / count;
+    }
+
+    double findAverage_Method_2(int first, ...)
+    {
+        double sum{ static_cast<double>(first) };
+
+        va_list list;
+        va_start(list, first);
+
+        int count{ 1 };
+        while (true)
+        {
+            int arg{ va_arg(list, int) };
+            if(arg == -1)
+                break;
+
+            sum += arg;
+            ++count;
+        }
+
+        va_end(list);
+
+        return sum / count;
+    }
+
+    double findAverage_Method_3(std::string decoder, ...)
+    {
+        double sum{ 0 };
+
+        va_list list;
+        va_start(list, decoder);
+
+        int count = 0;
+        while (true)
+        {
+            char codeType{ decoder[count] };
+
+            switch (codeType)
+            {
+            default:
+
+            case '\0':
+                va_end(list);
+                return sum / count;
+
+            case 'i':
+                sum += va_arg(list, int);
+                ++count;
+                break;
+            case 'd':
+                sum += va_arg(list, double);
+                ++count;
+                break;
+            }
+        }
+    }
+
+    // 11.3 — Passing arguments by reference
+    void getSinCos(double degrees, double& sinOut, double& cosOut)
+    {
+        constexpr double pi { 3.14159265358979323846 };
+        double radians{ degrees * pi / 180.0 };
+        sinOut = std::sin(radians);
+        cosOut = std::cos(radians);
+    }
+
+    // 11.13 — Introduction to lambdas
+    void repeat(int repetitions, function_ref<void(int)> fn)
+    {
+        for(int i{ 0 }; i < repetitions; ++i)
+        {
+            fn(i);
+        }
+    }
+
+    // 11.5 — Returning values by value, reference, and address
+    int getIndexOfLargestValue(const std::vector<int>& array)
+    {
+        if(array.empty())
+            return -1;
+
+        return static_cast<int>(argmax(array.data(), array.size()));
+    }
+
+    // 11.13 — Introduction to lambdas (the quiz)
+    struct Student
+    {
+        std::string name{};
+        int point{};
+    };
+}
+
+template <>
+struct RecordLayout<lesson::Student>
+{
+    static constexpr const char* name{ "Student" };
+    static constexpr auto fields()
+    {
+        return std::make_tuple(record_file::field("name", &lesson::Student::name),
+                               record_file::field("point", &lesson::Student::point));
+    }
+};
+
+using benchmark_harness::Suite;
+using benchmark_harness::doNotOptimize;
+
+std::vector<int> randomInts(std::size_t count, int low, int high, unsigned seed)
+{
+    std::mt19937 random{ seed };
+    std::uniform_int_distribution<int> distribution{ low, high };
+
+    std::vector<int> values(count);
+    for(int& value : values)
+        value = distribution(random);
+
+    return values;
+}
+
+// every iteration sorts a fresh copy of the same unsorted array (the copy is part of the time, but small next to the sort)
+void benchmarkSort(Suite& suite)
+{
+    for(std::size_t size : suite.sizes({ 1'000, 100'000, 1'000'000 }, { 1'000, 20'000 }))
+    {
+        const std::vector<int> unsorted{ randomInts(size, -1'000'000, 1'000'000, 1) };
+        std::vector<int> work{};
+        const int count{ static_cast<int>(size) };
+        const double ops{ static_cast<double>(size) };
+
+        auto sortWith{ [&](auto sortFcn){
+            return [&, sortFcn]{
+                work = unsorted;
+                sortFcn(work.data(), count);
+                doNotOptimize(work.front());
+            };
+        } };
+
+        std::vector<int> expected{ unsorted };
+        std::sort(expected.begin(), expected.end());
+
+        const std::string ascendingName{ "sort/SelectionSort_plus_our_function_pointer_parameter(ascending_for_Ptr)" };
+        suite.run(ascendingName, size, "element", ops, sortWith([](int* array, int n){
+            lesson::SelectionSort_plus_our_function_pointer_parameter(array, n, lesson::ascending_for_Ptr);
+        }));
+        suite.check(ascendingName, work == expected);
+
+        suite.run("sort/SelectionSort_plus_our_function_pointer_parameter(evensFirst)", size, "element", ops,
+                  sortWith([](int* array, int n){
+            lesson::SelectionSort_plus_our_function_pointer_parameter(array, n, lesson::evensFirst);
+        }));
+        suite.check("sort/SelectionSort_plus_our_function_pointer_parameter(evensFirst)",
+                    std::is_sorted(work.begin(), work.end(), [](int x, int y){ return lesson::evensFirst(y, x); }));
+
+        suite.run("sort/introSort(lambda)", size, "element", ops, sortWith([](int* array, int n){
+            introSort(array, n, [](int x, int y){ return x > y; });
+        }));
+        suite.check("sort/introSort(lambda)", work == expected);
+
+        suite.run("sort/std::sort", size, "element", ops, sortWith([](int* array, int n){
+            std::sort(array, array + n);
+        }));
+    }
+}
+
+// 4096 targets per iteration, about half of them in the array
+void benchmarkBinarySearch(Suite& suite)
+{
+    constexpr std::size_t targetCount{ 4096 };
+
+    for(std::size_t size : suite.sizes({ 1'000, 1'000'000, 16'000'000 }, { 1'000, 100'000 }))
+    {
+        // sorted and without duplicates: every other even number
+        std::vector<int> array(size);
+        for(std::size_t i{ 0 }; i < size; ++i)
+            array[i] = static_cast<int>(2 * i);
+
+        const int count{ static_cast<int>(size) };
+        const std::vector<int> targets{ randomInts(targetCount, 0, 2 * count, 2) };
+        const double ops{ static_cast<double>(targetCount) };
+
+        std::vector<int> expected(targetCount);
+        for(std::size_t i{ 0 }; i < targetCount; ++i)
+            expected[i] = lesson::binarySearch_iterative_version(array.data(), targets[i], 0, count - 1);
+
+        std::vector<int> results(targetCount);
+        auto searchWith{ [&](auto searchFcn){
+            return [&, searchFcn]{
+                for(std::size_t i{ 0 }; i < targetCount; ++i)
+                    results[i] = searchFcn(targets[i]);
+                doNotOptimize(results.back());
+            };
+        } };
+
+        suite.run("binarySearch/binarySearch_iterative_version", size, "lookup", ops, searchWith([&](int target){
+            return lesson::binarySearch_iterative_version(array.data(), target, 0, count - 1);
+        }));
+
+        suite.run("binarySearch/binarySearch_recursive_version", size, "lookup", ops, searchWith([&](int target){
+            return lesson::binarySearch_recursive_version(array.data(), target, 0, count - 1);
+        }));
+        suite.check("binarySearch/binarySearch_recursive_version", results == expected);
+
+        const EytzingerIndex index{ array.data(), count };
+        suite.run("binarySearch/EytzingerIndex::find", size, "lookup", ops, searchWith([&](int target){
+            return index.find(target);
+        }));
+        suite.check("binarySearch/EytzingerIndex::find", results == expected);
+
+        suite.run("binarySearch/binarySearchBatch", size, "lookup", ops, [&]{
+            binarySearchBatch(array.data(), count, targets.data(), results.data(), targetCount);
+            doNotOptimize(results.back());
+        });
+        suite.check("binarySearch/binarySearchBatch", results == expected);
+    }
+}
+
+void benchmarkFibonacci(Suite& suite)
+{
+    std::size_t result{ 0 };
+
+    // exponential, so the sizes are small
+    for(std::size_t n : suite.sizes({ 20, 25, 30 }, { 15, 20 }))
+    {
+        suite.run("fibonacci/Fibonacci", n, "call", 1, [&]{
+            std::size_t x{ n };
+            doNotOptimize(x);
+            result = lesson::Fibonacci(x);
+            doNotOptimize(result);
+        });
+        suite.check("fibonacci/Fibonacci", result == fibonacciTable[n]);
+    }
+
+    // after the first call these come from the cache
+    for(std::size_t n : { 20, 90 })
+    {
+        suite.run("fibonacci/Fibonacci_memoized_version", n, "call", 1, [&]{
+            std::size_t x{ n };
+            doNotOptimize(x);
+            result = lesson::Fibonacci_memoized_version(x);
+            doNotOptimize(result);
+        });
+        suite.check("fibonacci/Fibonacci_memoized_version", result == fibonacciTable[n]);
+
+        suite.run("fibonacci/Fibonacci_fast_doubling", n, "call", 1, [&]{
+            std::size_t x{ n };
+            doNotOptimize(x);
+            result = Fibonacci_fast_doubling(x);
+            doNotOptimize(result);
+        });
+        suite.check("fibonacci/Fibonacci_fast_doubling", result == fibonacciTable[n]);
+    }
+}
+
+// the ellipsis versions for 4 and 16 arguments (an op is one argument averaged), then the array version
+void benchmarkFindAverage(Suite& suite)
+{
+    const std::vector<int> values{ randomInts(16, 0, 1000, 3) };
+    const int* v{ values.data() };
+    double average{ 0 };
+
+    auto sum{ [&](int count){
+        double total{ 0 };
+        for(int i{ 0 }; i < count; ++i)
+            total += v[i];
+        return total / count;
+    } };
+
+    auto call{ [&](auto fcn){
+        return [&, fcn]{
+            doNotOptimize(v);
+            average = fcn();
+            doNotOptimize(average);
+        };
+    } };
+
+    suite.run("findAverage/findAverage", 4, "value", 4, call([&]{
+        return lesson::findAverage(4, v[0], v[1], v[2], v[3]);
+    }));
+    suite.check("findAverage/findAverage", average == sum(4));
+
+    suite.run("findAverage/findAverage_Method_2", 4, "value", 4, call([&]{
+        return lesson::findAverage_Method_2(v[0], v[1], v[2], v[3], -1);
+    }));
+    suite.check("findAverage/findAverage_Method_2", average == sum(4));
+
+    suite.run("findAverage/findAverage_Method_3", 4, "value", 4, call([&]{
+        return lesson::findAverage_Method_3("iiii", v[0], v[1], v[2], v[3]);
+    }));
+    suite.check("findAverage/findAverage_Method_3", average == sum(4));
+
+    suite.run("findAverage/typesafe::findAverage(args...)", 4, "value", 4, call([&]{
+        return typesafe::findAverage(v[0], v[1], v[2], v[3]);
+    }));
+    suite.check("findAverage/typesafe::findAverage(args...)", average == sum(4));
+
+    suite.run("findAverage/findAverage", 16, "value", 16, call([&]{
+        return lesson::findAverage(16, v[0], v[1], v[2], v[3], v[4], v[5], v[6], v[7], v[8], v[9], v[10], v[11],
+                                   v[12], v[13], v[14], v[15]);
+    }));
+    suite.check("findAverage/findAverage", average == sum(16));
+
+    suite.run("findAverage/findAverage_Method_2", 16, "value", 16, call([&]{
+        return lesson::findAverage_Method_2(v[0], v[1], v[2], v[3], v[4], v[5], v[6], v[7], v[8], v[9], v[10], v[11],
+                                            v[12], v[13], v[14], v[15], -1);
+    }));
+    suite.check("findAverage/findAverage_Method_2", average == sum(16));
+
+    suite.run("findAverage/findAverage_Method_3", 16, "value", 16, call([&]{
+        return lesson::findAverage_Method_3("iiiiiiiiiiiiiiii", v[0], v[1], v[2], v[3], v[4], v[5], v[6], v[7], v[8],
+                                            v[9], v[10], v[11], v[12], v[13], v[14], v[15]);
+    }));
+    suite.check("findAverage/findAverage_Method_3", average == sum(16));
+
+    suite.run("findAverage/typesafe::findAverage(args...)", 16, "value", 16, call([&]{
+        return typesafe::findAverage(v[0], v[1], v[2], v[3], v[4], v[5], v[6], v[7], v[8], v[9], v[10], v[11], v[12],
+                                     v[13], v[14], v[15]);
+    }));
+    suite.check("findAverage/typesafe::findAverage(args...)", average == sum(16));
+
+    for(std::size_t size : suite.sizes({ 1'000, 1'000'000 }, { 1'000, 100'000 }))
+    {
+        const std::vector<int> array{ randomInts(size, -1000, 1000, 4) };
+        suite.run("findAverage/typesafe::findAverage(array)", size, "value", static_cast<double>(size), [&]{
+            average = typesafe::findAverage(array.data(), array.size());
+            doNotOptimize(average);
+        });
+    }
+}
+
+void benchmarkSinCos(Suite& suite)
+{
+    for(std::size_t size : suite.sizes({ 1'000, 100'000, 1'000'000 }, { 1'000, 16'384 }))
+    {
+        std::vector<double> degrees(size);
+        std::mt19937 random{ 5 };
+        std::uniform_real_distribution<double> distribution{ -720.0, 720.0 };
+        for(double& angle : degrees)
+            angle = distribution(random);
+
+        std::vector<double> sines(size);
+        std::vector<double> cosines(size);
+        const double ops{ static_cast<double>(size) };
+
+        suite.run("getSinCos/getSinCos", size, "angle", ops, [&]{
+            for(std::size_t i{ 0 }; i < size; ++i)
+                lesson::getSinCos(degrees[i], sines[i], cosines[i]);
+            doNotOptimize(sines.back());
+        });
+        const std::vector<double> expectedSines{ sines };
+
+        // the batch versions, within their stated accuracy of the lesson's results
+        auto close{ [&](double tolerance){
+            for(std::size_t i{ 0 }; i < size; ++i)
+            {
+                if(std::abs(sines[i] - expectedSines[i]) > tolerance)
+                    return false;
+            }
+            return true;
+        } };
+
+        suite.run("getSinCos/getSinCos(batch, accurate)", size, "angle", ops, [&]{
+            getSinCos(degrees.data(), sines.data(), cosines.data(), size, SinCosAccuracy::accurate);
+            doNotOptimize(sines.back());
+        });
+        suite.check("getSinCos/getSinCos(batch, accurate)", close(1e-14));
+
+        suite.run("getSinCos/getSinCos(batch, fast)", size, "angle", ops, [&]{
+            getSinCos(degrees.data(), sines.data(), cosines.data(), size, SinCosAccuracy::fast);
+            doNotOptimize(sines.back());
+        });
+        suite.check("getSinCos/getSinCos(batch, fast)", close(1e-6));
+    }
+}
+
+void benchmarkRepeat(Suite& suite)
+{
+    for(std::size_t size : suite.sizes({ 1'000, 1'000'000 }, { 1'000, 100'000 }))
+    {
+        long long sum{ 0 };
+        const int repetitions{ static_cast<int>(size) };
+
+        suite.run("repeat/repeat(function_ref)", size, "call", static_cast<double>(size), [&]{
+            sum = 0;
+            lesson::repeat(repetitions, [&sum](int i){ sum += i; });
+            doNotOptimize(sum);
+        });
+        suite.check("repeat/repeat(function_ref)", sum == static_cast<long long>(size) * (static_cast<long long>(size) - 1) / 2);
+    }
+}
+
+void benchmarkLargestValue(Suite& suite)
+{
+    for(std::size_t size : suite.sizes({ 1'000, 1'000'000, 16'000'000 }, { 1'000, 100'000 }))
+    {
+        const std::vector<int> array{ randomInts(size, -1'000'000'000, 1'000'000'000, 6) };
+        const int expected{ static_cast<int>(std::max_element(array.begin(), array.end()) - array.begin()) };
+
+        int index{ -1 };
+        suite.run("getIndexOfLargestValue/getIndexOfLargestValue", size, "element", static_cast<double>(size), [&]{
+            index = lesson::getIndexOfLargestValue(array);
+            doNotOptimize(index);
+        });
+        suite.check("getIndexOfLargestValue/getIndexOfLargestValue", index == expected);
+    }
+}
+
+// (x + y) * (x - y) / 2 for every row, the operands are small enough for the lesson's functions not to overflow
+void benchmarkExpression(Suite& suite)
+{
+    const std::string text{ "(x + y) * (x - y) / 2" };
+
+    Expression formula{};
+    ExpressionError error{};
+    const bool compiled{ formula.compile(text, { "x", "y" }, error) };
+    suite.check("expression/compile", compiled);
+    if(!compiled)
+        return;
+
+    // "+*-/", the operators of the formula picked out of the text at run time like a calculator would (so the
+    // compiler can't look them up ahead)
+    std::string operators{};
+    for(char c : text)
+    {
+        if(c == '+' || c == '-' || c == '*' || c == '/')
+            operators += c;
+    }
+
+    for(std::size_t size : suite.sizes({ 1'000, 100'000, 4'000'000 }, { 1'000, 100'000 }))
+    {
+        const std::vector<int> xs{ randomInts(size, -10'000, 10'000, 8) };
+        const std::vector<int> ys{ randomInts(size, -10'000, 10'000, 9) };
+        std::vector<int> expected(size);
+        for(std::size_t i{ 0 }; i < size; ++i)
+            expected[i] = (xs[i] + ys[i]) * (xs[i] - ys[i]) / 2;
+
+        std::vector<int> results(size);
+        const double ops{ static_cast<double>(size) };
+
+        // the operators looked up for every row, the way QuizTime does it for one
+        suite.run("expression/getArithmeticFunction per operator", size, "row", ops, [&]{
+            for(std::size_t i{ 0 }; i < size; ++i)
+            {
+                int sum{ lesson::getArithmeticFunction(operators[0])(xs[i], ys[i]) };
+                int difference{ lesson::getArithmeticFunction(operators[2])(xs[i], ys[i]) };
+                int product{ lesson::getArithmeticFunction(operators[1])(sum, difference) };
+                results[i] = lesson::getArithmeticFunction(operators[3])(product, 2);
+            }
+            doNotOptimize(results.front());
+        });
+        suite.check("expression/getArithmeticFunction per operator", results == expected);
+
+        suite.run("expression/Expression::evaluate", size, "row", ops, [&]{
+            for(std::size_t i{ 0 }; i < size; ++i)
+            {
+                const int values[]{ xs[i], ys[i] };
+                results[i] = formula.evaluate(values);
+            }
+            doNotOptimize(results.front());
+        });
+        suite.check("expression/Expression::evaluate", results == expected);
+
+        const int* const columns[]{ xs.data(), ys.data() };
+        suite.run("expression/Expression::evaluateColumns", size, "row", ops, [&]{
+            formula.evaluateColumns(columns, results.data(), size);
+            doNotOptimize(results.front());
+        });
+        suite.check("expression/Expression::evaluateColumns", results == expected);
+    }
+}
+
+// into a buffer, so that the terminal (or the disk) doesn't decide the timings
+void benchmarkPrintStack(Suite& suite)
+{
+    for(std::size_t size : suite.sizes({ 1'000, 100'000, 1'000'000 }, { 1'000, 20'000 }))
+    {
+        std::vector<int> ints{ randomInts(size, -1'000'000, 1'000'000, 7) };
+        std::vector<double> doubles(size);
+        for(std::size_t i{ 0 }; i < size; ++i)
+            doubles[i] = ints[i] * 0.37;
+
+        // the longest element is "-1.23457e+06 " (13 characters), plus the (cap ...) at the end
+        std::vector<char> buffer(size * 16 + 256);
+        bool overflowed{ false };
+
+        auto printInto{ [&](const auto& stack){
+            return [&]{
+                StackWriter out{ buffer.data(), buffer.size() };
+                printStack(stack, out);
+                overflowed = overflowed || out.overflowed();
+                doNotOptimize(buffer.front());
+            };
+        } };
+
+        suite.run("printStack/printStack(std::vector<int>)", size, "element", static_cast<double>(size), printInto(ints));
+        suite.check("printStack/printStack(std::vector<int>)", !overflowed);
+
+        suite.run("printStack/printStack(std::vector<double>)", size, "element", static_cast<double>(size),
+                  printInto(doubles));
+        suite.check("printStack/printStack(std::vector<double>)", !overflowed);
+    }
+}
+
+// the students of the 11.13 quiz as a std::vector<Student> and as a record file (see record_file.h), written to the
+// working directory and removed at the end
+void benchmarkRecordFile(Suite& suite)
+{
+    const std::string path{ "chapter11_benchmark_students.records" };
+
+    for(std::size_t size : suite.sizes({ 1'000, 100'000, 4'000'000 }, { 1'000, 100'000 }))
+    {
+        const std::vector<int> points{ randomInts(size, 0, 1'000'000, 10) };
+        std::vector<lesson::Student> students{};
+
+        suite.run("recordFile/push_back into std::vector<Student>", size, "student", static_cast<double>(size), [&]{
+            students.clear();
+            students.shrink_to_fit();
+            for(std::size_t i{ 0 }; i < size; ++i)
+                students.push_back({ "Student" + std::to_string(i % 1000), points[i] });
+            doNotOptimize(students.back());
+        });
+        suite.check("recordFile/push_back into std::vector<Student>", students.size() == size);
+
+        std::string error{};
+        bool written{ true };
+        suite.run("recordFile/RecordWriter", size, "student", static_cast<double>(size), [&]{
+            RecordWriter<lesson::Student> writer{};
+            bool ok{ writer.open(path, error) };
+            if(ok)
+            {
+                for(std::size_t i{ 0 }; i < size; ++i)
+                    writer.add({ "Student" + std::to_string(i % 1000), points[i] });
+                ok = writer.finish(error);
+            }
+            written = written && ok;
+        });
+        suite.check("recordFile/RecordWriter", written);
+        if(!written)
+        {
+            std::printf("can't write %s: %s\n", path.c_str(), error.c_str());
+            break;
+        }
+
+        // opening maps the file and checks the header and the column table, it doesn't read the rows
+        RecordFile<lesson::Student> file{};
+        bool opened{ true };
+        suite.run("recordFile/RecordFile::open", size, "open", 1.0, [&]{
+            RecordFile<lesson::Student> reopened{};
+            opened = opened && reopened.open(path, error);
+            doNotOptimize(reopened);
+        });
+        opened = opened && file.open(path, error) && file.size() == size;
+        suite.check("recordFile/RecordFile::open", opened);
+        if(!opened)
+        {
+            std::printf("can't open %s: %s\n", path.c_str(), error.c_str());
+            break;
+        }
+
+        // the best student, with the lambda from the quiz, over the structs and over the points column
+        std::size_t vectorBest{ size };
+        suite.run("recordFile/max_element over std::vector<Student>", size, "student", static_cast<double>(size), [&]{
+            auto best{ std::max_element(students.begin(), students.end(), [](const lesson::Student& a,
+                                                                              const lesson::Student& b) {
+                return (a.point < b.point);
+            }) };
+            vectorBest = static_cast<std::size_t>(best - students.begin());
+            doNotOptimize(vectorBest);
+        });
+
+        const ColumnView<int> column{ file.column(&lesson::Student::point) };
+        std::size_t fileBest{ size };
+        suite.run("recordFile/max_element over ColumnView<int>", size, "student", static_cast<double>(size), [&]{
+            auto best{ std::max_element(column.begin(), column.end(), [](int a, int b) { return (a < b); }) };
+            fileBest = static_cast<std::size_t>(best - column.begin());
+            doNotOptimize(fileBest);
+        });
+
+        const std::size_t expected{
+            static_cast<std::size_t>(std::max_element(points.begin(), points.end()) - points.begin()) };
+        suite.check("recordFile/max_element over std::vector<Student>", vectorBest == expected);
+        suite.check("recordFile/max_element over ColumnView<int>",
+                    fileBest == expected && file.column(&lesson::Student::name)[fileBest] == students[expected].name);
+    }
+
+    std::remove(path.c_str());
+}
+
+int main(int argc, char* argv[])
+{
+    benchmark_harness::Options options{};
+    std::string error{};
+    if(!benchmark_harness::parseOptions(argc, argv, options, error))
+    {
+        std::printf("%s\n", error.c_str());
+        return 2;
+    }
+
+    Suite suite{ options };
+    benchmarkSort(suite);
+    benchmarkBinarySearch(suite);
+    benchmarkFibonacci(suite);
+    benchmarkFindAverage(suite);
+    benchmarkSinCos(suite);
+    benchmarkRepeat(suite);
+    benchmarkLargestValue(suite);
+    benchmarkExpression(suite);
+    benchmarkPrintStack(suite);
+    benchmarkRecordFile(suite);
+
+    return suite.finish();
+}